@@ -9,6 +9,12 @@
 
 //Includes
 #include <unordered_map>
+#include <vector>
+#include <new>
+#include <algorithm>
+#include <typeinfo>
+#include <cassert>
+#include <cstdint>
 
 namespace Elite
 {
@@ -20,6 +26,11 @@ namespace Elite
 	public:
 		IBlackBoardField() = default;
 		virtual ~IBlackBoardField() = default;
+
+		//Arena layout, used when the blackboard is frozen
+		virtual size_t GetSize() const = 0;
+		virtual size_t GetAlignment() const = 0;
+		virtual IBlackBoardField* MoveTo(void* pMemory) = 0;
 	};
 
 	//BlackboardField does not take ownership of pointers whatsoever!
@@ -32,10 +43,28 @@ namespace Elite
 		T GetData() { return m_Data; };
 		void SetData(T data) { m_Data = data; }
 
+		size_t GetSize() const override { return sizeof(BlackboardField<T>); }
+		size_t GetAlignment() const override { return alignof(BlackboardField<T>); }
+		IBlackBoardField* MoveTo(void* pMemory) override { return new (pMemory) BlackboardField<T>(std::move(m_Data)); }
+
 	private:
 		T m_Data;
 	};
 
+	//Compile-time typed key, the slot indexes the dense field array of the blackboard
+	//Declare keys as constexpr objects, each slot must be unique within one blackboard (a second key on a taken slot is rejected)
+	template<typename T>
+	struct BlackboardKey
+	{
+		using Type = T;
+
+		constexpr BlackboardKey(unsigned int slot, const char* pName) : Slot(slot), pName(pName)
+		{}
+
+		unsigned int Slot;
+		const char* pName;
+	};
+
 	//-----------------------------------------------------------------
 	// BLACKBOARD (BASE)
 	//-----------------------------------------------------------------
@@ -46,8 +75,17 @@ namespace Elite
 		~Blackboard()
 		{
 			for (auto el : m_BlackboardData)
-				SAFE_DELETE(el.second);
+			{
+				if (m_pArena)
+					el.second->~IBlackBoardField();
+				else
+					SAFE_DELETE(el.second);
+			}
 			m_BlackboardData.clear();
+			m_Slots.clear();
+			m_SlotTypes.clear();
+			delete[] m_pArena;
+			m_pArena = nullptr;
 		}
 
 		Blackboard(const Blackboard& other) = delete;
@@ -55,9 +93,70 @@ namespace Elite
 		Blackboard(Blackboard&& other) = delete;
 		Blackboard& operator=(Blackboard&& other) = delete;
 
+		//Move all fields into one contiguous arena, afterwards no data can be added
+		//Lookups on a frozen blackboard never insert or allocate
+		void Freeze()
+		{
+			if (m_pArena)
+				return;
+
+			//Fields are laid out in slot order first, so the hot typed keys sit next to each other
+			std::vector<IBlackBoardField*> fields{};
+			fields.reserve(m_BlackboardData.size());
+			for (IBlackBoardField* pField : m_Slots)
+			{
+				if (pField)
+					fields.push_back(pField);
+			}
+			for (auto el : m_BlackboardData)
+			{
+				if (std::find(fields.begin(), fields.end(), el.second) == fields.end())
+					fields.push_back(el.second);
+			}
+
+			std::vector<size_t> offsets{};
+			offsets.reserve(fields.size());
+			size_t arenaSize{};
+			for (IBlackBoardField* pField : fields)
+			{
+				const size_t alignment{ pField->GetAlignment() };
+				arenaSize = (arenaSize + alignment - 1) / alignment * alignment;
+				offsets.push_back(arenaSize);
+				arenaSize += pField->GetSize();
+			}
+
+			//operator new[] returns memory aligned for any fundamental type
+			m_pArena = new char[arenaSize > 0 ? arenaSize : 1];
+
+			for (size_t idx{}; idx < fields.size(); ++idx)
+			{
+				IBlackBoardField* pOld{ fields[idx] };
+				IBlackBoardField* pNew{ pOld->MoveTo(m_pArena + offsets[idx]) };
+
+				for (auto& el : m_BlackboardData)
+				{
+					if (el.second == pOld)
+						el.second = pNew;
+				}
+				std::replace(m_Slots.begin(), m_Slots.end(), pOld, pNew);
+				delete pOld;
+			}
+
+			//Room to remember misses without allocating during a tick
+			m_ReportedMisses.reserve(m_MaxReportedMisses);
+		}
+		bool IsFrozen() const { return m_pArena != nullptr; }
+		size_t GetNrMisses() const { return m_NrMisses; }
+
 		//Add data to the blackboard
 		template<typename T> bool AddData(const std::string& name, T data)
 		{
+			if (IsFrozen())
+			{
+				printf("WARNING: Data '%s' can not be added to a frozen Blackboard \n", name.c_str());
+				return false;
+			}
+
 			auto it = m_BlackboardData.find(name);
 			if (it == m_BlackboardData.end())
 			{
@@ -74,32 +173,150 @@ namespace Elite
 			auto it = m_BlackboardData.find(name);
 			if (it != m_BlackboardData.end())
 			{
-				BlackboardField<T>* p = dynamic_cast<BlackboardField<T>*>(m_BlackboardData[name]);
+				BlackboardField<T>* p = dynamic_cast<BlackboardField<T>*>(it->second);
 				if (p)
 				{
 					p->SetData(data);
 					return true;
 				}
 			}
-			printf("WARNING: Data '%s' of type '%s' not found in Blackboard \n", name.c_str(), typeid(T).name());
+			ReportMiss(name.c_str(), typeid(T).name());
 			return false;
 		}
 
 		//Get the data from the blackboard
 		template<typename T> bool GetData(const std::string& name, T& data)
 		{
-			BlackboardField<T>* p = dynamic_cast<BlackboardField<T>*>(m_BlackboardData[name]);
+			auto it = m_BlackboardData.find(name);
+			BlackboardField<T>* p = it != m_BlackboardData.end() ? dynamic_cast<BlackboardField<T>*>(it->second) : nullptr;
+			if (p != nullptr)
+			{
+				data = p->GetData();
+				return true;
+			}
+			ReportMiss(name.c_str(), typeid(T).name());
+			return false;
+		}
+
+		//Add data to the blackboard under a typed key, the field is reachable by name as well
+		template<typename T> bool AddData(const BlackboardKey<T>& key, typename BlackboardKey<T>::Type data)
+		{
+			if (IsFrozen())
+			{
+				printf("WARNING: Data '%s' can not be added to a frozen Blackboard \n", key.pName);
+				return false;
+			}
+
+			if (key.Slot >= m_Slots.size())
+			{
+				m_Slots.resize(key.Slot + 1, nullptr);
+				m_SlotTypes.resize(key.Slot + 1, nullptr);
+			}
+
+			if (m_Slots[key.Slot] != nullptr)
+			{
+				printf("WARNING: Data '%s' of type '%s' can not use slot %u, it is already taken \n", key.pName, typeid(T).name(), key.Slot);
+				return false;
+			}
+
+			if (m_BlackboardData.find(key.pName) != m_BlackboardData.end())
+			{
+				printf("WARNING: Data '%s' of type '%s' already in Blackboard \n", key.pName, typeid(T).name());
+				return false;
+			}
+
+			BlackboardField<T>* pField = new BlackboardField<T>(data);
+			m_Slots[key.Slot] = pField;
+			m_SlotTypes[key.Slot] = &typeid(T);
+			m_BlackboardData[key.pName] = pField;
+			return true;
+		}
+
+		//Change the data behind a typed key, the value converts implicitly to the type of the key
+		template<typename T> bool ChangeData(const BlackboardKey<T>& key, typename BlackboardKey<T>::Type data)
+		{
+			BlackboardField<T>* p = GetField(key);
+			if (p)
+			{
+				p->SetData(data);
+				return true;
+			}
+			ReportMiss(key.pName, typeid(T).name());
+			return false;
+		}
+
+		//Get the data behind a typed key, data must be of the exact type of the key
+		template<typename T> bool GetData(const BlackboardKey<T>& key, T& data)
+		{
+			BlackboardField<T>* p = GetField(key);
 			if (p != nullptr)
 			{
 				data = p->GetData();
 				return true;
 			}
-			printf("WARNING: Data '%s' of type '%s' not found in Blackboard \n", name.c_str(), typeid(T).name());
+			ReportMiss(key.pName, typeid(T).name());
 			return false;
 		}
 
 	private:
 		std::unordered_map<std::string, IBlackBoardField*> m_BlackboardData;
+
+		//Fields added through typed keys, indexed by slot (not owning, m_BlackboardData owns them)
+		std::vector<IBlackBoardField*> m_Slots;
+		//Type the field of each slot was added with, a key of another type on the same slot misses
+		std::vector<const std::type_info*> m_SlotTypes;
+
+		//Storage of all fields once frozen, nullptr before
+		char* m_pArena{ nullptr };
+
+		//Hashes of the names of missed lookups, each miss is only printed once
+		static const size_t m_MaxReportedMisses{ 32 };
+		std::vector<uint64_t> m_ReportedMisses;
+		size_t m_NrMisses{ 0 };
+		bool m_IsMissTableFull{ false };
+
+		void ReportMiss(const char* pName, const char* pTypeName)
+		{
+			++m_NrMisses;
+
+			//Once the table of a frozen blackboard is full, new misses are only counted (GetNrMisses) instead of allocating or printing every time
+			if (m_IsMissTableFull)
+				return;
+
+			//64-bit FNV-1a, hashing the C string avoids constructing a std::string
+			uint64_t hash{ 14695981039346656037ull };
+			for (const char* pChar{ pName }; *pChar != '\0'; ++pChar)
+				hash = (hash ^ static_cast<unsigned char>(*pChar)) * 1099511628211ull;
+
+			if (std::find(m_ReportedMisses.begin(), m_ReportedMisses.end(), hash) != m_ReportedMisses.end())
+				return;
+
+			if (IsFrozen() && m_ReportedMisses.size() >= m_ReportedMisses.capacity())
+			{
+				m_IsMissTableFull = true;
+				printf("WARNING: Data '%s' of type '%s' not found in Blackboard, further new misses are only counted \n", pName, pTypeName);
+				return;
+			}
+
+			m_ReportedMisses.push_back(hash);
+			printf("WARNING: Data '%s' of type '%s' not found in Blackboard (reported once) \n", pName, pTypeName);
+		}
+
+		//The type tag of the slot stands in for a dynamic_cast, the static_cast is only done when it matches
+		template<typename T> BlackboardField<T>* GetField(const BlackboardKey<T>& key) const
+		{
+			if (key.Slot >= m_Slots.size() || m_Slots[key.Slot] == nullptr)
+				return nullptr;
+
+			const std::type_info* pType{ m_SlotTypes[key.Slot] };
+			if (pType != &typeid(T) && *pType != typeid(T))
+			{
+				assert(false && "<Blackboard::GetField>: key has another type than the field in its slot");
+				return nullptr;
+			}
+
+			return static_cast<BlackboardField<T>*>(m_Slots[key.Slot]);
+		}
 	};
 }
 #endif
\ No newline at end of file
@@ -22,18 +22,42 @@ namespace Elite
 		Running
 	};
 
+	//Collected per node while profiling is enabled
+	struct BehaviorProfile
+	{
+		unsigned int Executions = 0;
+		unsigned int Successes = 0;
+		unsigned int Failures = 0;
+		unsigned int Running = 0;
+		double InclusiveTime = 0.0; //seconds, children included
+	};
+
 	//-----------------------------------------------------------------
 	// BEHAVIOR INTERFACES (BASE)
 	//-----------------------------------------------------------------
 	class IBehavior
 	{
 	public:
-		IBehavior() = default;
+		explicit IBehavior(const std::string& name = {}) : m_Name(name) {}
 		virtual ~IBehavior() = default;
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) = 0;
 
+		//Parents run their children through Tick, which only counts and times when profiling is enabled
+		BehaviorState Tick(Blackboard* pBlackBoard);
+
+		//Profiling
+		void SetProfiling(bool isEnabled);
+		void WriteProfile(std::ostream& stream, int depth) const;
+		virtual const char* GetTypeName() const = 0;
+		virtual size_t GetChildCount() const { return 0; }
+		virtual IBehavior* GetChild(size_t /*index*/) const { return nullptr; }
+
 	protected:
 		BehaviorState m_CurrentState = BehaviorState::Failure;
+
+	private:
+		std::string m_Name = {};
+		std::unique_ptr<BehaviorProfile> m_pProfile = nullptr;
 	};
 
 	//-----------------------------------------------------------------
@@ -44,7 +68,8 @@ namespace Elite
 	class BehaviorComposite : public IBehavior
 	{
 	public:
-		explicit BehaviorComposite(std::vector<IBehavior*> childBehaviors)
+		explicit BehaviorComposite(std::vector<IBehavior*> childBehaviors, const std::string& name = {})
+			: IBehavior(name)
 		{ m_ChildBehaviors = childBehaviors;	}
 		virtual ~BehaviorComposite()
 		{
@@ -55,6 +80,9 @@ namespace Elite
 
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override = 0;
 
+		virtual size_t GetChildCount() const override { return m_ChildBehaviors.size(); }
+		virtual IBehavior* GetChild(size_t index) const override { return m_ChildBehaviors[index]; }
+
 	protected:
 		std::vector<IBehavior*> m_ChildBehaviors = {};
 	};
@@ -63,33 +91,36 @@ namespace Elite
 	class BehaviorSelector : public BehaviorComposite
 	{
 	public:
-		explicit BehaviorSelector(std::vector<IBehavior*> childBehaviors) :
-			BehaviorComposite(childBehaviors) {}
+		explicit BehaviorSelector(std::vector<IBehavior*> childBehaviors, const std::string& name = {}) :
+			BehaviorComposite(childBehaviors, name) {}
 		virtual ~BehaviorSelector() = default;
 
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
+		virtual const char* GetTypeName() const override { return "Selector"; }
 	};
 
 	//--- SEQUENCE ---
 	class BehaviorSequence : public BehaviorComposite
 	{
 	public:
-		explicit BehaviorSequence(std::vector<IBehavior*> childBehaviors) :
-			BehaviorComposite(childBehaviors) {}
+		explicit BehaviorSequence(std::vector<IBehavior*> childBehaviors, const std::string& name = {}) :
+			BehaviorComposite(childBehaviors, name) {}
 		virtual ~BehaviorSequence() = default;
 
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
+		virtual const char* GetTypeName() const override { return "Sequence"; }
 	};
 
 	//--- PARTIAL SEQUENCE ---
 	class BehaviorPartialSequence : public BehaviorSequence
 	{
 	public:
-		explicit BehaviorPartialSequence(std::vector<IBehavior*> childBehaviors)
-			: BehaviorSequence(childBehaviors) {}
+		explicit BehaviorPartialSequence(std::vector<IBehavior*> childBehaviors, const std::string& name = {})
+			: BehaviorSequence(childBehaviors, name) {}
 		virtual ~BehaviorPartialSequence() = default;
 
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
+		virtual const char* GetTypeName() const override { return "PartialSequence"; }
 
 	private:
 		unsigned int m_CurrentBehaviorIndex = 0;
@@ -102,8 +133,10 @@ namespace Elite
 	class BehaviorConditional : public IBehavior
 	{
 	public:
-		explicit BehaviorConditional(std::function<bool(Blackboard*)> fp) : m_fpConditional(fp) {}
+		explicit BehaviorConditional(std::function<bool(Blackboard*)> fp, const std::string& name = {})
+			: IBehavior(name), m_fpConditional(fp) {}
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
+		virtual const char* GetTypeName() const override { return "Conditional"; }
 
 	private:
 		std::function<bool(Blackboard*)> m_fpConditional = nullptr;
@@ -115,8 +148,10 @@ namespace Elite
 	class BehaviorAction : public IBehavior
 	{
 	public:
-		explicit BehaviorAction(std::function<BehaviorState(Blackboard*)> fp) : m_fpAction(fp) {}
+		explicit BehaviorAction(std::function<BehaviorState(Blackboard*)> fp, const std::string& name = {})
+			: IBehavior(name), m_fpAction(fp) {}
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
+		virtual const char* GetTypeName() const override { return "Action"; }
 
 	private:
 		std::function<BehaviorState(Blackboard*)> m_fpAction = nullptr;
@@ -144,13 +179,20 @@ namespace Elite
 				return;
 			}
 				
-			m_CurrentState = m_pRootBehavior->Execute(m_pBlackBoard);
+			++m_NrUpdates;
+			m_CurrentState = m_pRootBehavior->Tick(m_pBlackBoard);
 		}
 		Blackboard* GetBlackboard() const
 		{ return m_pBlackBoard;	}
 
+		//Profiling, opt-in: counts and times every node from now on
+		void SetProfiling(bool isEnabled);
+		//Annotated tree with the counts and inclusive/exclusive time of every node
+		void WriteProfile(std::ostream& stream) const;
+
 	private:
 		BehaviorState m_CurrentState = BehaviorState::Failure;
+		unsigned int m_NrUpdates = 0;
 		Blackboard* m_pBlackBoard = nullptr;
 		IBehavior* m_pRootBehavior = nullptr;
 	};
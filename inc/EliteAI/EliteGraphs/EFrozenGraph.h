@@ -0,0 +1,74 @@
+#pragma once
+
+#include "framework/EliteMath/EMath.h"
+#include "EGraphEnums.h"
+#include <vector>
+
+namespace Elite
+{
+	// Immutable compressed sparse row copy of the connections of a graph
+	// the connections of node idx are [GetFirstConnection(idx), GetFirstConnection(idx + 1)), in connection list order
+	// also a neighbor policy for PolicyAStar, so the search runs on it directly
+	class FrozenGraph
+	{
+	public:
+		template <class T_GraphType>
+		void Freeze(const T_GraphType& graph);
+
+		int GetNrOfNodes() const { return (int)m_Positions.size(); }
+		int GetNrOfConnections() const { return (int)m_ConnectionTargets.size(); }
+
+		int GetFirstConnection(int idx) const { return m_FirstConnection[idx]; }
+		int GetConnectionTarget(int connection) const { return m_ConnectionTargets[connection]; }
+		float GetConnectionCost(int connection) const { return m_ConnectionCosts[connection]; }
+
+		// what GetNodePos of the graph returned, zero for removed nodes
+		Vector2 GetNodePos(int idx) const { return m_Positions[idx]; }
+
+		template <class T_Visitor>
+		void ForEachNeighbor(int idx, T_Visitor visitor) const
+		{
+			const int lastConnection{ m_FirstConnection[idx + 1] };
+			for (int connection = m_FirstConnection[idx]; connection < lastConnection; ++connection)
+			{
+				visitor(m_ConnectionTargets[connection], m_ConnectionCosts[connection]);
+			}
+		}
+
+	private:
+		std::vector<int> m_FirstConnection; // one more than there are nodes
+		std::vector<int> m_ConnectionTargets;
+		std::vector<float> m_ConnectionCosts;
+		std::vector<Vector2> m_Positions;
+	};
+
+	template <class T_GraphType>
+	void FrozenGraph::Freeze(const T_GraphType& graph)
+	{
+		const int nrOfNodes{ graph.GetNrOfNodes() };
+		const int nrOfConnections{ graph.GetNrOfConnections() };
+
+		m_FirstConnection.resize(nrOfNodes + 1);
+		m_ConnectionTargets.clear();
+		m_ConnectionTargets.reserve(nrOfConnections);
+		m_ConnectionCosts.clear();
+		m_ConnectionCosts.reserve(nrOfConnections);
+		m_Positions.assign(nrOfNodes, ZeroVector2);
+
+		for (int idx = 0; idx < nrOfNodes; ++idx)
+		{
+			m_FirstConnection[idx] = (int)m_ConnectionTargets.size();
+
+			if (graph.GetNode(idx)->GetIndex() != invalid_node_index)
+				m_Positions[idx] = graph.GetNodePos(idx);
+
+			for (auto pConnection : graph.GetNodeConnections(idx))
+			{
+				m_ConnectionTargets.push_back(pConnection->GetTo());
+				m_ConnectionCosts.push_back(pConnection->GetCost());
+			}
+		}
+
+		m_FirstConnection[nrOfNodes] = (int)m_ConnectionTargets.size();
+	}
+}
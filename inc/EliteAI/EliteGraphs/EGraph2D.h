@@ -16,20 +16,33 @@ namespace Elite
 	template<class T_NodeType, class T_ConnectionType>
 	class Graph2D : public IGraph<T_NodeType, T_ConnectionType>
 	{
+		// The base depends on the template parameters, standard two-phase lookup only finds its members through these
+		using BaseGraph = IGraph<T_NodeType, T_ConnectionType>;
+
 	public:
+		using BaseGraph::GetNodeRadius;
+
 		Graph2D(bool isDirectional);
 		Graph2D(const Graph2D& other);
 		virtual std::shared_ptr<IGraph<T_NodeType, T_ConnectionType>> Clone() const override;
 
-		using IGraph::GetNodePos;
+		using BaseGraph::GetNodePos;
 		virtual Vector2 GetNodePos(T_NodeType* pNode) const override { return pNode->GetPosition(); }
 
 		virtual int GetNodeIdxAtWorldPos(const Elite::Vector2& pos) const override;
 		T_ConnectionType* GetConnectionAtPosition(const Vector2& pos) const;
 
+		// Moves a node and marks the graph as modified, so the frozen graph picks up the new position
+		void SetNodePosition(int idx, const Vector2& position);
+
 		void SetConnectionCostsToDistance();
 		void SetNodesColor(const std::vector<GraphNode2D*>& nodes, const Color& color);
 
+	protected:
+		using BaseGraph::m_Connections;
+		using BaseGraph::m_Nodes;
+		using BaseGraph::OnGraphModified;
+
 	private:
 		// variables
 		int m_SelectedNodeIdx = -1;
@@ -40,7 +53,7 @@ namespace Elite
 
 	template<class T_NodeType, class T_ConnectionType>
 	Graph2D<T_NodeType, T_ConnectionType>::Graph2D(bool isDirectional)
-		: IGraph(isDirectional)
+		: BaseGraph(isDirectional)
 	{
 	}
 
@@ -70,6 +83,14 @@ namespace Elite
 			return invalid_node_index;
 	}
 
+	template<class T_NodeType, class T_ConnectionType>
+	void Graph2D<T_NodeType, T_ConnectionType>::SetNodePosition(int idx, const Vector2& position)
+	{
+		m_Nodes[idx]->SetPosition(position);
+
+		OnGraphModified(false, false);
+	}
+
 	template<class T_NodeType, class T_ConnectionType>
 	void Graph2D<T_NodeType, T_ConnectionType>::SetConnectionCostsToDistance()
 	{
@@ -82,6 +103,8 @@ namespace Elite
 				connection->SetCost(abs(Distance(posFrom, posTo)));
 			}
 		}
+
+		OnGraphModified(false, false);
 	}
 
 	template<class T_NodeType, class T_ConnectionType>
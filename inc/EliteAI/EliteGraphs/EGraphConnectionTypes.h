@@ -8,6 +8,7 @@
 #pragma once
 
 #include "EGraphEnums.h"
+#include "EliteGraphUtilities/EGraphVisuals.h"
 
 namespace Elite
 {
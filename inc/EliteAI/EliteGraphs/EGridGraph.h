@@ -15,12 +15,20 @@ namespace Elite
 	template<class T_NodeType, class T_ConnectionType>
 	class GridGraph : public IGraph<T_NodeType, T_ConnectionType>
 	{
+		// The base depends on the template parameters, standard two-phase lookup only finds its members through these
+		using BaseGraph = IGraph<T_NodeType, T_ConnectionType>;
+
 	public:
+		using typename BaseGraph::ConnectionList;
+		using BaseGraph::AddNode;
+		using BaseGraph::AddConnection;
+		using BaseGraph::IsUniqueConnection;
+
 		GridGraph(bool isDirectional);
 		GridGraph(int columns, int rows, int cellSize, bool isDirectionalGraph, bool isConnectedDiagonally, float costStraight = 1.f, float costDiagonal = 1.5);
 		void InitializeGrid(int columns, int rows, int cellSize, bool isDirectionalGraph, bool isConnectedDiagonally, float costStraight = 1.f, float costDiagonal = 1.5);
 
-		using IGraph::GetNode;
+		using BaseGraph::GetNode;
 		T_NodeType* GetNode(int col, int row) const { return m_Nodes[GetIndex(col, row)]; }
 		const ConnectionList& GetConnections(const T_NodeType& node) const { return m_Connections[node.GetIndex()]; }
 		const ConnectionList& GetConnections(int idx) const { return m_Connections[idx]; }
@@ -32,11 +40,11 @@ namespace Elite
 		int GetIndex(int col, int row) const { return row * m_NrOfColumns + col; }
 
 		// returns the column and row of the node in a Vector2
-		using IGraph::GetNodePos;
+		using BaseGraph::GetNodePos;
 		virtual Vector2 GetNodePos(T_NodeType* pNode) const override;
 
 		// returns the actual world position of the node
-		using IGraph::GetNodeWorldPos;
+		using BaseGraph::GetNodeWorldPos;
 		Vector2 GetNodeWorldPos(int col, int row) const;
 		Vector2 GetNodeWorldPos(int idx) const override;
 
@@ -44,6 +52,12 @@ namespace Elite
 
 		void AddConnectionsToAdjacentCells(int col, int row);
 		void AddConnectionsToAdjacentCells(int idx);
+	protected:
+		using BaseGraph::m_Connections;
+		using BaseGraph::m_Nodes;
+		using BaseGraph::m_IsDirectionalGraph;
+		using BaseGraph::OnGraphModified;
+
 	private:
 		
 		int m_NrOfColumns;
@@ -67,7 +81,7 @@ namespace Elite
 
 	template<class T_NodeType, class T_ConnectionType>
 	inline GridGraph<T_NodeType, T_ConnectionType>::GridGraph(bool isDirectional)
-		: IGraph(isDirectional)
+		: BaseGraph(isDirectional)
 		, m_NrOfColumns(0)
 		, m_NrOfRows(0)
 		, m_CellSize(5)
@@ -86,7 +100,7 @@ namespace Elite
 		bool isConnectedDiagonally, 
 		float costStraight /* = 1.f*/, 
 		float costDiagonal /* = 1.5f */)
-		: IGraph(isDirectionalGraph)
+		: BaseGraph(isDirectionalGraph)
 		, m_NrOfColumns(columns)
 		, m_NrOfRows(rows)
 		, m_CellSize(cellSize)
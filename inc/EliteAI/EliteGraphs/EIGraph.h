@@ -9,6 +9,7 @@
 
 #include "EGraphNodeTypes.h"
 #include "EGraphConnectionTypes.h"
+#include "EFrozenGraph.h"
 #include <memory>
 
 namespace Elite
@@ -40,7 +41,8 @@ namespace Elite
 
 		int GetNextFreeNodeIndex() const { return m_NextNodeIndex; }
 		int AddNode(T_NodeType* pNode);
-		void RemoveNode(int node);
+		// Virtual, like Clear, for graphs that do not own their nodes one by one
+		virtual void RemoveNode(int node);
 
 		void AddConnection(T_ConnectionType* pConnection);
 		void RemoveConnection(int from, int to);
@@ -58,7 +60,11 @@ namespace Elite
 		bool IsEmpty() const { return m_Nodes.empty(); }
 		bool IsUniqueConnection(int from, int to) const;
 
-		void Clear();
+		// Contiguous copy of the connections for traversals, frozen again on first use after the graph was modified
+		// Costs and positions changed through the connections and nodes themselves are only picked up when the graph is modified afterwards
+		const FrozenGraph& GetFrozenGraph() const;
+
+		virtual void Clear();
 		void RemoveConnections();
 
 		// Visualization
@@ -91,11 +97,15 @@ namespace Elite
 
 
 		// Called whenever the graph is modified, to be overriden by derived classes
-		virtual void OnGraphModified(bool nrOfNodesChanged, bool nrOfConnectionsChanged) {}
+		// Overrides have to call this one, it marks the frozen graph as out of date
+		virtual void OnGraphModified(bool nrOfNodesChanged, bool nrOfConnectionsChanged) { m_IsFrozenGraphValid = false; }
 
 	private:
 		int m_NextNodeIndex;
 
+		mutable FrozenGraph m_FrozenGraph;
+		mutable bool m_IsFrozenGraphValid = false;
+
 		// private functions
 		void CullInvalidEdges();
 	};
@@ -246,7 +256,7 @@ namespace Elite
 				currentConnection != m_Connections[idx].end();
 				++currentConnection)
 			{
-				for (auto& currentEdgeOnToNode = m_Connections[(*currentConnection)->GetTo()].begin();
+				for (auto currentEdgeOnToNode = m_Connections[(*currentConnection)->GetTo()].begin();
 					currentEdgeOnToNode != m_Connections[(*currentConnection)->GetTo()].end();
 					++currentEdgeOnToNode)
 				{
@@ -323,7 +333,7 @@ namespace Elite
 
 		if (!m_IsDirectionalGraph)
 		{
-			for (auto& curEdge = m_Connections[to].begin();
+			for (auto curEdge = m_Connections[to].begin();
 				curEdge != m_Connections[to].end();
 				++curEdge)
 			{
@@ -335,7 +345,7 @@ namespace Elite
 			}
 		}
 
-		for (auto& curEdge = m_Connections[from].begin();
+		for (auto curEdge = m_Connections[from].begin();
 			curEdge != m_Connections[from].end();
 			++curEdge)
 		{
@@ -370,7 +380,7 @@ namespace Elite
 		auto isConnectionToThisNode = [idx](T_ConnectionType* pCon) { return pCon->GetTo() == idx; };
 		for (auto& c : m_Connections)
 		{
-			std::list<T_ConnectionType*>::iterator foundIt;
+			typename ConnectionList::iterator foundIt;
 			while ((foundIt = std::find_if(c.begin(), c.end(), isConnectionToThisNode))	!= c.end())
 			{
 				delete *foundIt;
@@ -389,16 +399,18 @@ namespace Elite
 			"<Graph::SetEdgeCost>: invalid index");
 
 		//visit each neighbour and erase any connections leading to this pNode
-		for (auto& curEdge = m_Connections[from].begin();
+		for (auto curEdge = m_Connections[from].begin();
 			curEdge != m_Connections[from].end();
 			++curEdge)
 		{
-			if (curEdge->GetTo() == to)
+			if ((*curEdge)->GetTo() == to)
 			{
-				curEdge->SetCost(cost);
+				(*curEdge)->SetCost(cost);
 				break;
 			}
 		}
+
+		OnGraphModified(false, false);
 	}
 
 	template<class T_NodeType, class T_ConnectionType>
@@ -428,6 +440,18 @@ namespace Elite
 		return tot;
 	}
 
+	template<class T_NodeType, class T_ConnectionType>
+	inline const FrozenGraph& IGraph<T_NodeType, T_ConnectionType>::GetFrozenGraph() const
+	{
+		if (!m_IsFrozenGraphValid)
+		{
+			m_FrozenGraph.Freeze(*this);
+			m_IsFrozenGraphValid = true;
+		}
+
+		return m_FrozenGraph;
+	}
+
 	template<class T_NodeType, class T_ConnectionType>
 	inline void IGraph<T_NodeType, T_ConnectionType>::Clear()
 	{
@@ -443,6 +467,7 @@ namespace Elite
 		m_Connections.clear();
 
 		m_NextNodeIndex = 0;
+		m_IsFrozenGraphValid = false;
 	}
 
 	template<class T_NodeType, class T_ConnectionType>
@@ -450,6 +475,8 @@ namespace Elite
 	{
 		for (auto& connectionList : m_Connections)
 			connectionList.clear();
+
+		m_IsFrozenGraphValid = false;
 	}
 
 	template<class T_NodeType, class T_ConnectionType>
@@ -477,7 +504,7 @@ namespace Elite
 	{
 		for (auto curEdgeList = m_Connections.begin(); curEdgeList != m_Connections.end(); ++curEdgeList)
 		{
-			for (auto& curEdge = (*curEdgeList).begin(); curEdge != (*curEdgeList).end(); ++curEdge)
+			for (auto curEdge = (*curEdgeList).begin(); curEdge != (*curEdgeList).end(); ++curEdge)
 			{
 				if (m_Nodes[curEdge->GetTo()].GetIndex() == invalid_node_index ||
 					m_Nodes[curEdge->GetFrom()].GetIndex() == invalid_node_index)
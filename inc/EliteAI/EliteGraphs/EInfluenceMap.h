@@ -2,35 +2,54 @@
 #include "EIGraph.h"
 #include "EGraphNodeTypes.h"
 #include "EGraphConnectionTypes.h"
+#include <type_traits>
 
 namespace Elite
 {
+	template<class T_NodeType, class T_ConnectionType>
+	class GridGraph;
+
+	// Grid graphs propagate through a fixed 8 neighbour stencil, every other graph through flat adjacency arrays
+	template<class T_GraphType>
+	struct IsGridGraph : std::false_type {};
+
+	template<class T_NodeType, class T_ConnectionType>
+	struct IsGridGraph<GridGraph<T_NodeType, T_ConnectionType>> : std::true_type {};
+
 	template<class T_GraphType>
 	class InfluenceMap final : public T_GraphType
 	{
 	public:
 		InfluenceMap(bool isDirectional): T_GraphType(isDirectional) {}
-		void InitializeBuffer() { m_InfluenceDoubleBuffer = std::vector<float>(m_Nodes.size()); }
+		void InitializeBuffer() { RebuildBuffers(); }
 		void PropagateInfluence(float deltaTime);
 
+		// Influence has to be set and read through the map: while the buffers are valid the nodes are out of date
 		void SetInfluenceAtPosition(Elite::Vector2 pos, float influence);
+		void SetInfluence(int idx, float influence);
+		float GetInfluence(int idx) const;
 
 		void Render() const {}
+		// Also writes the influence back to the nodes, which the graph renderer reads afterwards
 		void SetNodeColorsBasedOnInfluence();
 
 		float GetMomentum() const { return m_Momentum; }
 		void SetMomentum(float momentum) { m_Momentum = momentum; }
 
 		float GetDecay() const { return m_Decay; }
-		void SetDecay(float decay) { m_Decay = decay; }
+		void SetDecay(float decay) { m_Decay = decay; InvalidateBuffers(); }
 
 		float GetPropagationInterval() const { return m_PropagationInterval; }
 		void SetPropagationInterval(float propagationInterval) { m_PropagationInterval = propagationInterval; }
 
+		virtual void Clear() override;
+
 	protected:
 		virtual void OnGraphModified(bool nrOfNodesChanged, bool nrOfConnectionsChanged) override;
 
 	private:
+		static constexpr int m_NrStencilDirections = 8;
+
 		Elite::Color m_NegativeColor{ 1.f, 0.2f, 0.f};
 		Elite::Color m_NeutralColor{ 0.f, 0.f, 0.f };
 		Elite::Color m_PositiveColor{ 0.f, 0.2f, 1.f};
@@ -43,7 +62,39 @@ namespace Elite
 		float m_PropagationInterval = .05f; //in Seconds
 		float m_TimeSinceLastPropagation = 0.0f;
 
-		std::vector<float> m_InfluenceDoubleBuffer;
+		// While the buffers are valid they own the influence: every propagation reads the front buffer, writes the back one and swaps them
+		// The nodes only get the result back when they are read: when coloring them and when the buffers are invalidated
+		std::vector<float> m_InfluenceBuffers[2];
+		int m_FrontBuffer = 0;
+		int m_BufferSize = 0;
+		int m_NrBufferedNodes = 0;
+		bool m_AreBuffersValid = false;
+
+		// Stencil layout: row major with a border of one empty cell, so every node has all 8 neighbours
+		// One plane of decay factors per direction, 0 where the connection does not exist
+		bool m_IsStencil = false;
+		int m_NrStencilColumns = 0;
+		int m_NrStencilRows = 0;
+		int m_Stride = 0;
+		int m_StencilOffsets[m_NrStencilDirections]{};
+		std::vector<float> m_StencilFactors;
+		std::vector<float> m_RowHighest;
+		std::vector<float> m_RowStrongest;
+
+		// Adjacency layout: the frozen graph, with one decay factor per frozen connection
+		std::vector<float> m_ConnectionFactors;
+
+		int GetBufferIndex(int idx) const { return m_IsStencil ? idx + m_Stride + 1 + 2 * (idx / m_NrStencilColumns) : idx; }
+
+		void InvalidateBuffers();
+		void RebuildBuffers();
+		bool BuildStencil(std::true_type isGridGraph);
+		bool BuildStencil(std::false_type isGridGraph) { return false; }
+		void BuildAdjacency();
+
+		void PropagateStencil();
+		void PropagateAdjacency();
+		void WriteBackInfluence();
 	};
 
 	template <class T_GraphType>
@@ -52,36 +103,131 @@ namespace Elite
 		m_TimeSinceLastPropagation += deltaTime;
 
 		if (m_TimeSinceLastPropagation < m_PropagationInterval) return;
-		
+
 		m_TimeSinceLastPropagation = 0.f;
 
-		for (const auto& node : m_Nodes)
+		if (!m_AreBuffersValid)
+			RebuildBuffers();
+
+		if (m_IsStencil)
+			PropagateStencil();
+		else
+			PropagateAdjacency();
+
+		m_FrontBuffer ^= 1;
+	}
+
+	template <class T_GraphType>
+	void InfluenceMap<T_GraphType>::PropagateStencil()
+	{
+		const float* pSource{ m_InfluenceBuffers[m_FrontBuffer].data() };
+		float* pDestination{ m_InfluenceBuffers[m_FrontBuffer ^ 1].data() };
+		const float* pFactors{ m_StencilFactors.data() };
+
+		int offsets[m_NrStencilDirections]{};
+		std::copy(std::begin(m_StencilOffsets), std::end(m_StencilOffsets), std::begin(offsets));
+
+		const int planeSize{ m_BufferSize };
+		const float momentum{ m_Momentum };
+
+		float* pHighest{ m_RowHighest.data() };
+		float* pStrongest{ m_RowStrongest.data() };
+
+		for (int row{ 1 }; row <= m_NrStencilRows; ++row)
 		{
-			float highestInfluence{};
-			for (const auto& connection : GetNodeConnections(node))
+			const int first{ row * m_Stride + 1 };
+			const int nrColumns{ m_NrStencilColumns };
+
+			std::fill(pHighest, pHighest + nrColumns, 0.f);
+			std::fill(pStrongest, pStrongest + nrColumns, 0.f);
+
+			// One direction at a time along the row, with selects instead of branches so the compiler can vectorize it
+			for (int direction{}; direction < m_NrStencilDirections; ++direction)
 			{
-				const float calculatedInfluence{ m_Nodes[connection->GetTo()]->GetInfluence() * expf(-connection->GetCost() * m_Decay) };
+				const float* pNeighbours{ pSource + first + offsets[direction] };
+				const float* pDirectionFactors{ pFactors + direction * planeSize + first };
 
-				if (highestInfluence < abs(calculatedInfluence) )
+				for (int column{}; column < nrColumns; ++column)
 				{
-					highestInfluence = abs(calculatedInfluence);
-					m_InfluenceDoubleBuffer[node->GetIndex()] = Lerp(calculatedInfluence, node->GetInfluence(), m_Momentum);
+					const float calculatedInfluence{ pNeighbours[column] * pDirectionFactors[column] };
+					const float absInfluence{ fabsf(calculatedInfluence) };
+
+					const bool isStronger{ pHighest[column] < absInfluence };
+					pHighest[column] = isStronger ? absInfluence : pHighest[column];
+					pStrongest[column] = isStronger ? calculatedInfluence : pStrongest[column];
 				}
 			}
+
+			// Without any incoming influence a node keeps its own
+			const float* pCurrent{ pSource + first };
+			float* pRow{ pDestination + first };
+			for (int column{}; column < nrColumns; ++column)
+			{
+				const float propagatedInfluence{ Lerp(pStrongest[column], pCurrent[column], momentum) };
+				pRow[column] = pHighest[column] > 0.f ? propagatedInfluence : pCurrent[column];
+			}
 		}
+	}
 
-		for (const auto& node : m_Nodes)
+	template <class T_GraphType>
+	void InfluenceMap<T_GraphType>::PropagateAdjacency()
+	{
+		const float* pSource{ m_InfluenceBuffers[m_FrontBuffer].data() };
+		float* pDestination{ m_InfluenceBuffers[m_FrontBuffer ^ 1].data() };
+
+		const float momentum{ m_Momentum };
+
+		// Frozen together with the buffers, modifying the graph invalidates both
+		const FrozenGraph& frozenGraph{ this->GetFrozenGraph() };
+
+		for (int idx{}; idx < m_NrBufferedNodes; ++idx)
 		{
-			node->SetInfluence(m_InfluenceDoubleBuffer[node->GetIndex()]);
+			float highestInfluence{};
+			float strongestInfluence{};
+
+			const int lastConnection{ frozenGraph.GetFirstConnection(idx + 1) };
+			for (int connection{ frozenGraph.GetFirstConnection(idx) }; connection < lastConnection; ++connection)
+			{
+				const float calculatedInfluence{ pSource[frozenGraph.GetConnectionTarget(connection)] * m_ConnectionFactors[connection] };
+				const float absInfluence{ fabsf(calculatedInfluence) };
+
+				const bool isStronger{ highestInfluence < absInfluence };
+				highestInfluence = isStronger ? absInfluence : highestInfluence;
+				strongestInfluence = isStronger ? calculatedInfluence : strongestInfluence;
+			}
+
+			const float currentInfluence{ pSource[idx] };
+			const float propagatedInfluence{ Lerp(strongestInfluence, currentInfluence, momentum) };
+			pDestination[idx] = highestInfluence > 0.f ? propagatedInfluence : currentInfluence;
 		}
 	}
-	
+
 	template <class T_GraphType>
 	inline void InfluenceMap<T_GraphType>::SetInfluenceAtPosition(Elite::Vector2 pos, float influence)
 	{
-		auto idx = GetNodeIdxAtWorldPos(pos);
-		if (IsNodeValid(idx))
-			GetNode(idx)->SetInfluence(influence);
+		auto idx = this->GetNodeIdxAtWorldPos(pos);
+		if (!this->IsNodeValid(idx))
+			return;
+
+		SetInfluence(idx, influence);
+	}
+
+	template <class T_GraphType>
+	inline void InfluenceMap<T_GraphType>::SetInfluence(int idx, float influence)
+	{
+		if (m_AreBuffersValid)
+			m_InfluenceBuffers[m_FrontBuffer][GetBufferIndex(idx)] = influence;
+		else
+			this->GetNode(idx)->SetInfluence(influence);
+	}
+
+	template <class T_GraphType>
+	inline float InfluenceMap<T_GraphType>::GetInfluence(int idx) const
+	{
+		if (m_AreBuffersValid)
+			return m_InfluenceBuffers[m_FrontBuffer][GetBufferIndex(idx)];
+
+		return this->m_Nodes[idx]->GetInfluence();
 	}
 
 	template<class T_GraphType>
@@ -89,8 +235,13 @@ namespace Elite
 	{
 		const float half = .5f;
 
-		for (auto& pNode : m_Nodes)
+		if (m_AreBuffersValid)
+			WriteBackInfluence();
+
+		for (int idx{}; idx < (int)this->m_Nodes.size(); ++idx)
 		{
+			auto pNode = this->m_Nodes[idx];
+
 			Color nodeColor{};
 			float influence = pNode->GetInfluence();
 			float relativeInfluence = abs(influence) / m_MaxAbsInfluence;
@@ -119,6 +270,114 @@ namespace Elite
 	template<class T_GraphType>
 	inline void InfluenceMap<T_GraphType>::OnGraphModified(bool nrOfNodesChanged, bool nrOfConnectionsChanged)
 	{
-		InitializeBuffer();
+		T_GraphType::OnGraphModified(nrOfNodesChanged, nrOfConnectionsChanged);
+
+		// Rebuilt on the next propagation, building a grid calls this once per node and connection
+		InvalidateBuffers();
+	}
+
+	template<class T_GraphType>
+	inline void InfluenceMap<T_GraphType>::Clear()
+	{
+		// The buffered nodes are deleted, nothing is written back to them
+		m_AreBuffersValid = false;
+
+		T_GraphType::Clear();
+	}
+
+	template<class T_GraphType>
+	inline void InfluenceMap<T_GraphType>::InvalidateBuffers()
+	{
+		// The rebuilt buffers start from the nodes, so they get the current influence first
+		if (m_AreBuffersValid)
+			WriteBackInfluence();
+
+		m_AreBuffersValid = false;
+	}
+
+	template<class T_GraphType>
+	inline void InfluenceMap<T_GraphType>::WriteBackInfluence()
+	{
+		const float* pInfluence{ m_InfluenceBuffers[m_FrontBuffer].data() };
+
+		for (int idx{}; idx < m_NrBufferedNodes; ++idx)
+			this->m_Nodes[idx]->SetInfluence(pInfluence[GetBufferIndex(idx)]);
+	}
+
+	template<class T_GraphType>
+	inline void InfluenceMap<T_GraphType>::RebuildBuffers()
+	{
+		m_NrBufferedNodes = (int)this->m_Nodes.size();
+
+		m_IsStencil = BuildStencil(IsGridGraph<T_GraphType>{});
+		if (!m_IsStencil)
+			BuildAdjacency();
+
+		m_InfluenceBuffers[0].assign(m_BufferSize, 0.f);
+		m_InfluenceBuffers[1].assign(m_BufferSize, 0.f);
+		m_FrontBuffer = 0;
+
+		for (int idx{}; idx < m_NrBufferedNodes; ++idx)
+			m_InfluenceBuffers[m_FrontBuffer][GetBufferIndex(idx)] = this->m_Nodes[idx]->GetInfluence();
+
+		m_AreBuffersValid = true;
+	}
+
+	template<class T_GraphType>
+	inline bool InfluenceMap<T_GraphType>::BuildStencil(std::true_type isGridGraph)
+	{
+		const int columns{ this->GetColumns() };
+		const int rows{ this->GetRows() };
+		if (columns <= 0 || columns * rows != m_NrBufferedNodes)
+			return false;
+
+		m_NrStencilColumns = columns;
+		m_NrStencilRows = rows;
+		m_Stride = columns + 2;
+		m_BufferSize = m_Stride * (rows + 2);
+
+		const int directions[m_NrStencilDirections][2]{ { 1, 0 }, { 0, 1 }, { -1, 0 }, { 0, -1 }, { 1, 1 }, { -1, 1 }, { -1, -1 }, { 1, -1 } };
+		for (int direction{}; direction < m_NrStencilDirections; ++direction)
+			m_StencilOffsets[direction] = directions[direction][0] + directions[direction][1] * m_Stride;
+
+		m_StencilFactors.assign(m_NrStencilDirections * m_BufferSize, 0.f);
+		m_RowHighest.assign(columns, 0.f);
+		m_RowStrongest.assign(columns, 0.f);
+
+		// Each factor is computed once here instead of an expf per connection per propagation
+		// Ties between equally strong neighbours now go to the first direction instead of the first connection in the list
+		for (int idx{}; idx < m_NrBufferedNodes; ++idx)
+		{
+			for (auto pConnection : this->m_Connections[idx])
+			{
+				const int to{ pConnection->GetTo() };
+				const int deltaColumn{ to % columns - idx % columns };
+				const int deltaRow{ to / columns - idx / columns };
+
+				int direction{};
+				while (direction < m_NrStencilDirections && (directions[direction][0] != deltaColumn || directions[direction][1] != deltaRow))
+					++direction;
+
+				// A connection to a cell that is not adjacent does not fit the stencil
+				if (direction == m_NrStencilDirections)
+					return false;
+
+				m_StencilFactors[direction * m_BufferSize + idx + m_Stride + 1 + 2 * (idx / columns)] = expf(-pConnection->GetCost() * m_Decay);
+			}
+		}
+
+		return true;
+	}
+
+	template<class T_GraphType>
+	inline void InfluenceMap<T_GraphType>::BuildAdjacency()
+	{
+		m_BufferSize = m_NrBufferedNodes;
+
+		const FrozenGraph& frozenGraph{ this->GetFrozenGraph() };
+
+		m_ConnectionFactors.resize(frozenGraph.GetNrOfConnections());
+		for (int connection{}; connection < frozenGraph.GetNrOfConnections(); ++connection)
+			m_ConnectionFactors[connection] = expf(-frozenGraph.GetConnectionCost(connection) * m_Decay);
 	}
-}
\ No newline at end of file
+}
@@ -32,17 +32,19 @@ Elite::NavGraph::~NavGraph()
 {
 	delete m_pNavMeshPolygon; 
 	m_pNavMeshPolygon = nullptr;
+
+	//The nodes belong to the arena, IGraph only deletes the connections
+	m_Nodes.clear();
 }
 
 int Elite::NavGraph::GetNodeIdxFromLineIdx(int lineIdx) const
 {
-	auto nodeIt = std::find_if(m_Nodes.begin(), m_Nodes.end(), [lineIdx](const NavGraphNode* n) { return n->GetLineIndex() == lineIdx; });
-	if (nodeIt != m_Nodes.end())
+	if (lineIdx < 0 || lineIdx >= (int)m_LineToNodeIdx.size())
 	{
-		return (*nodeIt)->GetIndex();
+		return invalid_node_index;
 	}
 
-	return invalid_node_index;
+	return m_LineToNodeIdx[lineIdx];
 }
 
 Elite::Polygon* Elite::NavGraph::GetNavMeshPolygon() const
@@ -50,40 +52,79 @@ Elite::Polygon* Elite::NavGraph::GetNavMeshPolygon() const
 	return m_pNavMeshPolygon;
 }
 
+void Elite::NavGraph::RemoveNode(int idx)
+{
+	assert(idx >= 0 && idx < (int)m_Nodes.size() && "<NavGraph::RemoveNode>: invalid node index");
+
+	//The node stays in the arena with an invalid index, its line no longer leads to it
+	const int lineIdx{ m_Nodes[idx]->GetLineIndex() };
+	if (lineIdx >= 0 && lineIdx < (int)m_LineToNodeIdx.size() && m_LineToNodeIdx[lineIdx] == idx)
+	{
+		m_LineToNodeIdx[lineIdx] = invalid_node_index;
+	}
+
+	Graph2D::RemoveNode(idx);
+}
+
+void Elite::NavGraph::Clear()
+{
+	//IGraph deletes the connections, the arena releases the nodes
+	m_Nodes.clear();
+	Graph2D::Clear();
+
+	m_NodeArena.clear();
+	m_LineToNodeIdx.clear();
+}
+
 void Elite::NavGraph::CreateNavigationGraph()
 {
-	//1. Go over all the edges of the navigationmesh and create nodes
+	//1. Go over all the edges of the navigationmesh and create nodes, the arena is filled first so the node pointers stay valid
 
-	int index{};
+	const auto& lines = m_pNavMeshPolygon->GetLines();
+	m_LineToNodeIdx.assign(lines.size(), invalid_node_index);
+	m_NodeArena.clear();
+	m_NodeArena.reserve(lines.size());
 
-	for (auto& line : m_pNavMeshPolygon->GetLines())
+	for (auto& line : lines)
 	{
 		if (m_pNavMeshPolygon->GetTrianglesFromLineIndex(line->index).size() > 1)
 		{
-			AddNode(new NavGraphNode{ index,line->index,(line->p1 + line->p2) / 2.f });
-			++index;
+			assert(line->index < (int)m_LineToNodeIdx.size() && "<NavGraph::CreateNavigationGraph>: line index out of range");
+
+			m_LineToNodeIdx[line->index] = (int)m_NodeArena.size();
+			m_NodeArena.push_back(NavGraphNode{ (int)m_NodeArena.size(),line->index,(line->p1 + line->p2) / 2.f });
 		}
 	}
 
+	m_Nodes.reserve(m_NodeArena.size());
+	m_Connections.reserve(m_NodeArena.size());
+
+	for (auto& node : m_NodeArena)
+	{
+		AddNode(&node);
+	}
+
 	//2. Create connections now that every node is created
 
 	for (auto& triangle : m_pNavMeshPolygon->GetTriangles())
 	{
-		std::vector<int> validIndices{};
+		int validIndices[3]{};
+		int nrValidIndices{};
 
 		for (int index : triangle->metaData.IndexLines)
 		{
-			if (GetNodeIdxFromLineIdx(index) != invalid_node_index)
+			const int nodeIdx{ GetNodeIdxFromLineIdx(index) };
+			if (nodeIdx != invalid_node_index)
 			{
-				validIndices.push_back(GetNodeIdxFromLineIdx(index));
+				validIndices[nrValidIndices++] = nodeIdx;
 			}
 		}
 
-		if (validIndices.size() == 2)
+		if (nrValidIndices == 2)
 		{
 			AddConnection(new GraphConnection2D{ validIndices[0], validIndices[1] });
 		}
-		else if (validIndices.size() == 3)
+		else if (nrValidIndices == 3)
 		{
 			AddConnection(new GraphConnection2D{ validIndices[0], validIndices[1] });
 			AddConnection(new GraphConnection2D{ validIndices[1], validIndices[2] });
@@ -95,5 +136,8 @@ void Elite::NavGraph::CreateNavigationGraph()
 
 	SetConnectionCostsToDistance();
 
+	//4. Freeze the finished graph, so the searches only ever read it
+
+	GetFrozenGraph();
 }
 
@@ -15,9 +15,15 @@ namespace Elite
 		int GetNodeIdxFromLineIdx(int lineIdx) const;
 		Polygon* GetNavMeshPolygon() const;
 
+		//The nodes belong to the arena, so these keep IGraph from deleting them and keep the line table in sync
+		virtual void RemoveNode(int idx) override;
+		virtual void Clear() override;
+
 	private:
 		//--- Datamembers ---
 		Polygon* m_pNavMeshPolygon = nullptr; //Polygon that represents navigation mesh
+		std::vector<NavGraphNode> m_NodeArena; //Owns the nodes, m_Nodes points into it
+		std::vector<int> m_LineToNodeIdx; //Node index per line index, invalid_node_index for lines without a node
 
 		void CreateNavigationGraph();
 
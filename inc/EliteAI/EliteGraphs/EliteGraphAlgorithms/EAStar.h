@@ -1,192 +1,330 @@
 #pragma once
 #include "framework/EliteAI/EliteNavigation/ENavigation.h"
+#include "EAStarPolicies.h"
 
 namespace Elite
 {
-	template <class T_NodeType, class T_ConnectionType>
-	class AStar
+	// A* on node indices with the heuristic and the way neighbors are found as compile-time policies (see EAStarPolicies.h)
+	// when the goal is unreachable the path leads to the visited node with the lowest heuristic cost instead
+	template <class T_HeuristicPolicy, class T_NeighborPolicy>
+	class PolicyAStar
 	{
 	public:
-		AStar(IGraph<T_NodeType, T_ConnectionType>* pGraph, Heuristic hFunction);
+		explicit PolicyAStar(T_NeighborPolicy neighbors, T_HeuristicPolicy heuristic = T_HeuristicPolicy());
 
-		// stores the optimal connection to a node and its total costs related to the start and end node of the path
-		struct NodeRecord
-		{
-			T_NodeType* pNode = nullptr;
-			T_ConnectionType* pConnection = nullptr;
-			float costSoFar = 0.f; // accumulated g-costs of all the connections leading up to this one
-			float estimatedTotalCost = 0.f; // f-cost (= costSoFar + h-cost)
+		std::vector<int> FindPath(int startIdx, int goalIdx, std::vector<int>& visitedNodes);
 
-			bool operator==(const NodeRecord& other) const
-			{
-				return pNode == other.pNode
-					&& pConnection == other.pConnection
-					&& costSoFar == other.costSoFar
-					&& estimatedTotalCost == other.estimatedTotalCost;
-			};
+		const T_NeighborPolicy& GetNeighbors() const { return m_Neighbors; }
+		T_NeighborPolicy& GetNeighbors() { return m_Neighbors; }
 
-			bool operator<(const NodeRecord& other) const
-			{
-				return estimatedTotalCost < other.estimatedTotalCost;
-			};
+	private:
+		static const int closed_heap_index = -1;
+
+		// a node leaving the open list, a node that is reopened gets closed more than once
+		struct ClosedRecord
+		{
+			int idx;
+			int parentIdx;
+			float costSoFar;
+			float estimatedTotalCost;
 		};
 
+		// prepares the per node arrays for a new search, they are only cleared when the generation wraps around
+		void BeginSearch();
+		bool HasRecord(int idx) const { return m_Generations[idx] == m_Generation; }
+		void SetRecord(int idx, int parentIdx, float costSoFar, float estimatedTotalCost);
+
+		// open list: binary min-heap of node indices on (f-cost, order in which the record was made)
+		// the order breaks ties like a search of the open list from front to back would
+		bool IsHeapHigher(int first, int second) const;
+		void PushHeap(int idx);
+		int PopHeap();
+		void SiftUp(int heapIdx);
+		void SiftDown(int heapIdx);
+		void PlaceInHeap(int heapIdx, int idx);
+
+		T_NeighborPolicy m_Neighbors;
+		T_HeuristicPolicy m_Heuristic;
+
+		// per node data, indexed by the index of the node and only valid when the generation matches
+		std::vector<unsigned int> m_Generations;
+		std::vector<int> m_ParentIndices;
+		std::vector<float> m_CostsSoFar;
+		std::vector<float> m_EstimatedTotalCosts;
+		std::vector<unsigned int> m_Orders;
+		std::vector<int> m_HeapIndices; // closed_heap_index when the node is not in the open list
+		unsigned int m_Generation = 0;
+		unsigned int m_NextOrder = 0;
+
+		std::vector<int> m_Heap;
+		std::vector<ClosedRecord> m_ClosedRecords;
+	};
+
+	// A* on the frozen graph of any graph with a heuristic picked at runtime
+	template <class T_NodeType, class T_ConnectionType>
+	class AStar
+	{
+	public:
+		AStar(IGraph<T_NodeType, T_ConnectionType>* pGraph, Heuristic hFunction);
+
 		std::vector<T_NodeType*> FindPath(T_NodeType* pStartNode, T_NodeType* pDestinationNode, std::vector<T_NodeType*>& visitedNodes);
 
 	private:
-		float GetHeuristicCost(T_NodeType* pStartNode, T_NodeType* pEndNode) const;
-
 		IGraph<T_NodeType, T_ConnectionType>* m_pGraph;
-		Heuristic m_HeuristicFunction;
+		PolicyAStar<FunctionHeuristic, FrozenNeighbors> m_Search;
+		std::vector<int> m_VisitedIndices;
 	};
 
-	template <class T_NodeType, class T_ConnectionType>
-	AStar<T_NodeType, T_ConnectionType>::AStar(IGraph<T_NodeType, T_ConnectionType>* pGraph, Heuristic hFunction)
-		: m_pGraph(pGraph)
-		, m_HeuristicFunction(hFunction)
+	template <class T_HeuristicPolicy, class T_NeighborPolicy>
+	PolicyAStar<T_HeuristicPolicy, T_NeighborPolicy>::PolicyAStar(T_NeighborPolicy neighbors, T_HeuristicPolicy heuristic)
+		: m_Neighbors(std::move(neighbors))
+		, m_Heuristic(heuristic)
 	{
 	}
 
-	template <class T_NodeType, class T_ConnectionType>
-	std::vector<T_NodeType*> AStar<T_NodeType, T_ConnectionType>::FindPath(T_NodeType* pStartNode, T_NodeType* pGoalNode, std::vector<T_NodeType*>& visitedNodes)
+	template <class T_HeuristicPolicy, class T_NeighborPolicy>
+	std::vector<int> PolicyAStar<T_HeuristicPolicy, T_NeighborPolicy>::FindPath(int startIdx, int goalIdx, std::vector<int>& visitedNodes)
 	{
 		visitedNodes.clear();
 
-		std::vector<T_NodeType*> path;
+		std::vector<int> path;
 
-		std::vector<NodeRecord> openList;
-		std::vector<NodeRecord> closedList;
+		BeginSearch();
 
-		std::vector<NodeRecord> visitedList;
+		const Vector2 goalPos{ m_Neighbors.GetNodePos(goalIdx) };
+		auto getHeuristicCost = [this, &goalPos](int idx)
+		{
+			const Vector2 toDestination{ goalPos - m_Neighbors.GetNodePos(idx) };
+			return m_Heuristic(abs(toDestination.x), abs(toDestination.y));
+		};
 
-		NodeRecord currentRecord{ pStartNode };
-		currentRecord.pConnection = nullptr;
-		currentRecord.costSoFar = 0.f;
-		currentRecord.estimatedTotalCost = GetHeuristicCost(pStartNode, pGoalNode);
+		SetRecord(startIdx, invalid_node_index, 0.f, getHeuristicCost(startIdx));
+		PushHeap(startIdx);
 
-		openList.push_back(currentRecord);
+		int currentIdx{ startIdx };
+		bool hasFoundGoal{ false };
 
-		while (openList.empty() == false)
+		while (m_Heap.empty() == false)
 		{
-			currentRecord = *std::min_element(openList.begin(), openList.end());
+			currentIdx = m_Heap.front();
 
-			if (currentRecord.pNode == pGoalNode)
+			if (currentIdx == goalIdx)
 			{
+				hasFoundGoal = true;
 				break;
 			}
 
-			for (auto& connection : m_pGraph->GetNodeConnections(currentRecord.pNode))
-			{
-				const float costSoFar{ currentRecord.costSoFar + connection->GetCost() };
+			PopHeap();
 
-				bool isInClosedList{ false };
-				bool isInOpenList{ false };
+			const float currentCostSoFar{ m_CostsSoFar[currentIdx] };
+			m_ClosedRecords.push_back(ClosedRecord{ currentIdx, m_ParentIndices[currentIdx], currentCostSoFar, m_EstimatedTotalCosts[currentIdx] });
 
-				NodeRecord existingRecord{};
+			m_Neighbors.ForEachNeighbor(currentIdx, [&](int toIdx, float cost)
+			{
+				const float costSoFar{ currentCostSoFar + cost };
 
-				for(auto& element:closedList)
+				// open or closed, a node is only revisited through a cheaper connection
+				if (HasRecord(toIdx) && costSoFar >= m_CostsSoFar[toIdx])
 				{
-					if(element.pNode == m_pGraph->GetNode(connection->GetTo()))
-					{
-						isInClosedList = true;
-						existingRecord = element;
-						break;
-					}
+					return;
 				}
 
-				if (!isInClosedList)
-				{
-					for (auto& element : openList)
-					{
-						if (element.pNode == m_pGraph->GetNode(connection->GetTo()))
-						{
-							isInOpenList = true;
-							existingRecord = element;
-							break;
-						}
-					}
-				}
+				SetRecord(toIdx, currentIdx, costSoFar, costSoFar + getHeuristicCost(toIdx));
 
-				if (isInClosedList)
+				if (m_HeapIndices[toIdx] == closed_heap_index)
 				{
-					if (costSoFar < existingRecord.costSoFar)
-					{
-						closedList.erase(std::remove(closedList.begin(), closedList.end(), existingRecord));
-					}
-					else
-					{
-						continue;
-					}
+					PushHeap(toIdx);
 				}
-				else if (isInOpenList)
+				else
 				{
-					if (costSoFar < existingRecord.costSoFar)
-					{
-						openList.erase(std::remove(openList.begin(), openList.end(), existingRecord));
-					}
-					else
-					{
-						continue;
-					}
+					// the record got cheaper but also newer, so it can move either way
+					SiftUp(m_HeapIndices[toIdx]);
+					SiftDown(m_HeapIndices[toIdx]);
 				}
-
-				NodeRecord newRecord{ m_pGraph->GetNode(connection->GetTo()) };
-				newRecord.pConnection = connection;
-				newRecord.costSoFar = costSoFar;
-				newRecord.estimatedTotalCost = newRecord.costSoFar + GetHeuristicCost(newRecord.pNode, pGoalNode);
-
-				openList.push_back(newRecord);
-			}
-
-			closedList.push_back(currentRecord);
-
-			visitedList.push_back(currentRecord);
-			openList.erase(std::remove(openList.begin(), openList.end(), currentRecord));
+			});
 		}
 
-		for (auto& record : visitedList)
+		for (auto& record : m_ClosedRecords)
 		{
 			//Debug visualization
-			visitedNodes.push_back(record.pNode);
+			visitedNodes.push_back(record.idx);
 		}
 
-		if(currentRecord.pNode != pGoalNode)
+		int parentIdx{ m_ParentIndices[currentIdx] };
+
+		if (hasFoundGoal == false)
 		{
 			//Fallback path to closest node if end node is unreachable
-			for (auto& record : visitedList)
+			auto closestRecord = std::min_element(m_ClosedRecords.begin(), m_ClosedRecords.end(), [](const ClosedRecord& first, const ClosedRecord& second)
 			{
-				record.estimatedTotalCost -= record.costSoFar;
-			}
+				return first.estimatedTotalCost - first.costSoFar < second.estimatedTotalCost - second.costSoFar;
+			});
 
-			currentRecord = *std::min_element(visitedList.begin(), visitedList.end());
+			currentIdx = closestRecord->idx;
+			parentIdx = closestRecord->parentIdx;
 		}
 
-		while(currentRecord.pNode != pStartNode)
+		while (currentIdx != startIdx)
 		{
-			path.push_back(currentRecord.pNode);
-			
-			for (auto& element : closedList)
-			{
-				if (element.pNode == m_pGraph->GetNode(currentRecord.pConnection->GetFrom()))
-				{
-					currentRecord = element;
-					break;
-				}
-			}
+			path.push_back(currentIdx);
 
+			currentIdx = parentIdx;
+			parentIdx = m_ParentIndices[currentIdx];
 		}
 
-		path.push_back(pStartNode);
+		path.push_back(startIdx);
 
 		std::reverse(path.begin(), path.end());
 
 		return path;
 	}
 
+	template <class T_HeuristicPolicy, class T_NeighborPolicy>
+	void PolicyAStar<T_HeuristicPolicy, T_NeighborPolicy>::BeginSearch()
+	{
+		const size_t nrOfNodes{ static_cast<size_t>(m_Neighbors.GetNrOfNodes()) };
+		if (m_Generations.size() != nrOfNodes)
+		{
+			m_Generations.assign(nrOfNodes, 0);
+			m_ParentIndices.resize(nrOfNodes);
+			m_CostsSoFar.resize(nrOfNodes);
+			m_EstimatedTotalCosts.resize(nrOfNodes);
+			m_Orders.resize(nrOfNodes);
+			m_HeapIndices.resize(nrOfNodes);
+			m_Generation = 0;
+		}
+
+		++m_Generation;
+		if (m_Generation == 0)
+		{
+			std::fill(m_Generations.begin(), m_Generations.end(), 0);
+			m_Generation = 1;
+		}
+
+		m_NextOrder = 0;
+		m_Heap.clear();
+		m_ClosedRecords.clear();
+	}
+
+	template <class T_HeuristicPolicy, class T_NeighborPolicy>
+	void PolicyAStar<T_HeuristicPolicy, T_NeighborPolicy>::SetRecord(int idx, int parentIdx, float costSoFar, float estimatedTotalCost)
+	{
+		if (HasRecord(idx) == false)
+		{
+			m_Generations[idx] = m_Generation;
+			m_HeapIndices[idx] = closed_heap_index;
+		}
+
+		m_ParentIndices[idx] = parentIdx;
+		m_CostsSoFar[idx] = costSoFar;
+		m_EstimatedTotalCosts[idx] = estimatedTotalCost;
+		m_Orders[idx] = m_NextOrder++;
+	}
+
+	template <class T_HeuristicPolicy, class T_NeighborPolicy>
+	bool PolicyAStar<T_HeuristicPolicy, T_NeighborPolicy>::IsHeapHigher(int first, int second) const
+	{
+		if (m_EstimatedTotalCosts[first] < m_EstimatedTotalCosts[second]) return true;
+		if (m_EstimatedTotalCosts[second] < m_EstimatedTotalCosts[first]) return false;
+		return m_Orders[first] < m_Orders[second];
+	}
+
+	template <class T_HeuristicPolicy, class T_NeighborPolicy>
+	void PolicyAStar<T_HeuristicPolicy, T_NeighborPolicy>::PushHeap(int idx)
+	{
+		m_Heap.push_back(idx);
+		m_HeapIndices[idx] = static_cast<int>(m_Heap.size()) - 1;
+		SiftUp(m_HeapIndices[idx]);
+	}
+
+	template <class T_HeuristicPolicy, class T_NeighborPolicy>
+	int PolicyAStar<T_HeuristicPolicy, T_NeighborPolicy>::PopHeap()
+	{
+		const int topIdx{ m_Heap.front() };
+		m_HeapIndices[topIdx] = closed_heap_index;
+
+		const int lastIdx{ m_Heap.back() };
+		m_Heap.pop_back();
+
+		if (m_Heap.empty() == false)
+		{
+			PlaceInHeap(0, lastIdx);
+			SiftDown(0);
+		}
+
+		return topIdx;
+	}
+
+	template <class T_HeuristicPolicy, class T_NeighborPolicy>
+	void PolicyAStar<T_HeuristicPolicy, T_NeighborPolicy>::SiftUp(int heapIdx)
+	{
+		const int idx{ m_Heap[heapIdx] };
+		while (heapIdx > 0)
+		{
+			const int parentHeapIdx{ (heapIdx - 1) / 2 };
+			if (IsHeapHigher(idx, m_Heap[parentHeapIdx]) == false) break;
+
+			PlaceInHeap(heapIdx, m_Heap[parentHeapIdx]);
+			heapIdx = parentHeapIdx;
+		}
+
+		PlaceInHeap(heapIdx, idx);
+	}
+
+	template <class T_HeuristicPolicy, class T_NeighborPolicy>
+	void PolicyAStar<T_HeuristicPolicy, T_NeighborPolicy>::SiftDown(int heapIdx)
+	{
+		const int idx{ m_Heap[heapIdx] };
+		const int heapSize{ static_cast<int>(m_Heap.size()) };
+		while (true)
+		{
+			int childHeapIdx{ 2 * heapIdx + 1 };
+			if (childHeapIdx >= heapSize) break;
+
+			if (childHeapIdx + 1 < heapSize && IsHeapHigher(m_Heap[childHeapIdx + 1], m_Heap[childHeapIdx])) ++childHeapIdx;
+			if (IsHeapHigher(m_Heap[childHeapIdx], idx) == false) break;
+
+			PlaceInHeap(heapIdx, m_Heap[childHeapIdx]);
+			heapIdx = childHeapIdx;
+		}
+
+		PlaceInHeap(heapIdx, idx);
+	}
+
+	template <class T_HeuristicPolicy, class T_NeighborPolicy>
+	void PolicyAStar<T_HeuristicPolicy, T_NeighborPolicy>::PlaceInHeap(int heapIdx, int idx)
+	{
+		m_Heap[heapIdx] = idx;
+		m_HeapIndices[idx] = heapIdx;
+	}
+
+	template <class T_NodeType, class T_ConnectionType>
+	AStar<T_NodeType, T_ConnectionType>::AStar(IGraph<T_NodeType, T_ConnectionType>* pGraph, Heuristic hFunction)
+		: m_pGraph(pGraph)
+		, m_Search(FrozenNeighbors(&pGraph->GetFrozenGraph()), FunctionHeuristic(hFunction))
+	{
+	}
+
 	template <class T_NodeType, class T_ConnectionType>
-	float Elite::AStar<T_NodeType, T_ConnectionType>::GetHeuristicCost(T_NodeType* pStartNode, T_NodeType* pEndNode) const
+	std::vector<T_NodeType*> AStar<T_NodeType, T_ConnectionType>::FindPath(T_NodeType* pStartNode, T_NodeType* pGoalNode, std::vector<T_NodeType*>& visitedNodes)
 	{
-		Vector2 toDestination = m_pGraph->GetNodePos(pEndNode) - m_pGraph->GetNodePos(pStartNode);
-		return m_HeuristicFunction(abs(toDestination.x), abs(toDestination.y));
+		visitedNodes.clear();
+
+		std::vector<T_NodeType*> path;
+
+		// the search holds on to the frozen graph, this freezes it again when the graph was modified since the last search
+		m_pGraph->GetFrozenGraph();
+
+		for (int idx : m_Search.FindPath(pStartNode->GetIndex(), pGoalNode->GetIndex(), m_VisitedIndices))
+		{
+			path.push_back(m_pGraph->GetNode(idx));
+		}
+
+		for (int idx : m_VisitedIndices)
+		{
+			visitedNodes.push_back(m_pGraph->GetNode(idx));
+		}
+
+		return path;
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,242 @@
+#pragma once
+#include "framework/EliteAI/EliteNavigation/ENavigation.h"
+#include "framework/EliteAI/EliteGraphs/EGridGraph.h"
+
+namespace Elite
+{
+	// Heuristic policies for PolicyAStar, called with the absolute x and y distance to the goal
+	// the fixed ones are inlined into the search, FunctionHeuristic keeps the indirect call of a Heuristic pointer
+	struct ManhattanHeuristic
+	{
+		float operator()(float x, float y) const { return HeuristicFunctions::Manhattan(x, y); }
+	};
+
+	struct OctileHeuristic
+	{
+		float operator()(float x, float y) const { return HeuristicFunctions::Octile(x, y); }
+	};
+
+	struct EuclideanHeuristic
+	{
+		float operator()(float x, float y) const { return HeuristicFunctions::Euclidean(x, y); }
+	};
+
+	struct FunctionHeuristic
+	{
+		explicit FunctionHeuristic(Heuristic hFunction = nullptr) : function(hFunction) {}
+		float operator()(float x, float y) const { return function(x, y); }
+
+		Heuristic function;
+	};
+
+	// Neighbor policies for PolicyAStar
+	// a policy knows the number of nodes, the position the heuristic is measured in and calls visitor(toIdx, cost) for every connection of a node
+
+	// walks the connection lists of any graph, a graph that is searched more often than it changes is better searched through its FrozenGraph
+	template <class T_NodeType, class T_ConnectionType>
+	class GraphNeighbors
+	{
+	public:
+		explicit GraphNeighbors(IGraph<T_NodeType, T_ConnectionType>* pGraph) : m_pGraph(pGraph) {}
+
+		int GetNrOfNodes() const { return m_pGraph->GetNrOfNodes(); }
+		Vector2 GetNodePos(int idx) const { return m_pGraph->GetNodePos(idx); }
+
+		template <class T_Visitor>
+		void ForEachNeighbor(int idx, T_Visitor visitor) const
+		{
+			for (auto pConnection : m_pGraph->GetNodeConnections(idx))
+			{
+				visitor(pConnection->GetTo(), pConnection->GetCost());
+			}
+		}
+
+	private:
+		IGraph<T_NodeType, T_ConnectionType>* m_pGraph;
+	};
+
+	// searches the frozen graph of a graph without copying it, IGraph::GetFrozenGraph has to be called again after the graph was modified
+	class FrozenNeighbors
+	{
+	public:
+		explicit FrozenNeighbors(const FrozenGraph* pFrozenGraph) : m_pFrozenGraph(pFrozenGraph) {}
+
+		int GetNrOfNodes() const { return m_pFrozenGraph->GetNrOfNodes(); }
+		Vector2 GetNodePos(int idx) const { return m_pFrozenGraph->GetNodePos(idx); }
+
+		template <class T_Visitor>
+		void ForEachNeighbor(int idx, T_Visitor visitor) const { m_pFrozenGraph->ForEachNeighbor(idx, visitor); }
+
+	private:
+		const FrozenGraph* m_pFrozenGraph;
+	};
+
+	// a frozen graph with a few extra nodes and connections on top, for the temporary nodes of a single query
+	// extra nodes get the indices after the frozen ones, extra connections come after the frozen ones of the same node
+	class OverlayNeighbors
+	{
+	public:
+		explicit OverlayNeighbors(const FrozenGraph* pFrozenGraph = nullptr) : m_pFrozenGraph(pFrozenGraph) {}
+
+		// drops the extra nodes and connections, keeps their memory for the next query
+		void Reset(const FrozenGraph* pFrozenGraph);
+		// returns the index of the new node
+		int AddNode(const Vector2& pos);
+		void AddConnection(int from, int to, float cost) { m_ExtraConnections.push_back(ExtraConnection{ from, to, cost }); }
+
+		int GetNrOfNodes() const { return m_pFrozenGraph->GetNrOfNodes() + (int)m_ExtraPositions.size(); }
+		Vector2 GetNodePos(int idx) const;
+
+		template <class T_Visitor>
+		void ForEachNeighbor(int idx, T_Visitor visitor) const
+		{
+			if (idx < m_pFrozenGraph->GetNrOfNodes())
+			{
+				m_pFrozenGraph->ForEachNeighbor(idx, visitor);
+			}
+
+			// only a handful, a scan is cheaper than indexing them
+			for (const ExtraConnection& connection : m_ExtraConnections)
+			{
+				if (connection.from == idx)
+				{
+					visitor(connection.to, connection.cost);
+				}
+			}
+		}
+
+	private:
+		struct ExtraConnection
+		{
+			int from;
+			int to;
+			float cost;
+		};
+
+		const FrozenGraph* m_pFrozenGraph;
+		std::vector<Vector2> m_ExtraPositions;
+		std::vector<ExtraConnection> m_ExtraConnections;
+	};
+
+	inline void OverlayNeighbors::Reset(const FrozenGraph* pFrozenGraph)
+	{
+		m_pFrozenGraph = pFrozenGraph;
+		m_ExtraPositions.clear();
+		m_ExtraConnections.clear();
+	}
+
+	inline int OverlayNeighbors::AddNode(const Vector2& pos)
+	{
+		m_ExtraPositions.push_back(pos);
+		return GetNrOfNodes() - 1;
+	}
+
+	inline Vector2 OverlayNeighbors::GetNodePos(int idx) const
+	{
+		const int nrOfFrozenNodes{ m_pFrozenGraph->GetNrOfNodes() };
+		return idx < nrOfFrozenNodes ? m_pFrozenGraph->GetNodePos(idx) : m_ExtraPositions[idx - nrOfFrozenNodes];
+	}
+
+	// snapshot of a grid graph: a mask of the connected directions and their costs per node, the neighbors themselves follow from the index
+	// has to be rebuilt after the connections of the grid changed
+	class GridNeighbors
+	{
+	public:
+		static const int nr_directions = 8;
+
+		GridNeighbors() = default;
+
+		// returns false and leaves no nodes when a connection joins cells that are not adjacent, search those grids through FrozenNeighbors
+		template <class T_NodeType, class T_ConnectionType>
+		bool Rebuild(const GridGraph<T_NodeType, T_ConnectionType>& graph);
+
+		int GetNrOfNodes() const { return m_NrOfColumns * m_NrOfRows; }
+		// column and row, like GridGraph::GetNodePos
+		Vector2 GetNodePos(int idx) const { return Vector2{ float(idx % m_NrOfColumns), float(idx / m_NrOfColumns) }; }
+
+		template <class T_Visitor>
+		void ForEachNeighbor(int idx, T_Visitor visitor) const
+		{
+			const unsigned int directionMask{ m_DirectionMasks[idx] };
+			const float* pCosts{ &m_Costs[idx * nr_directions] };
+
+			for (int direction = 0; direction < nr_directions; ++direction)
+			{
+				if (directionMask & (1u << direction))
+				{
+					visitor(idx + m_Offsets[direction], pCosts[direction]);
+				}
+			}
+		}
+
+	private:
+		int m_NrOfColumns = 0;
+		int m_NrOfRows = 0;
+		int m_Offsets[nr_directions] = {};
+
+		std::vector<unsigned char> m_DirectionMasks;
+		std::vector<float> m_Costs; // nr_directions per node
+
+		// same order as the straight and diagonal directions of GridGraph, -1 when the cells are not adjacent
+		static int GetDirection(int columnOffset, int rowOffset);
+	};
+
+	template <class T_NodeType, class T_ConnectionType>
+	bool GridNeighbors::Rebuild(const GridGraph<T_NodeType, T_ConnectionType>& graph)
+	{
+		m_NrOfColumns = graph.GetColumns();
+		m_NrOfRows = graph.GetRows();
+
+		for (int columnOffset = -1; columnOffset <= 1; ++columnOffset)
+		{
+			for (int rowOffset = -1; rowOffset <= 1; ++rowOffset)
+			{
+				const int direction{ GetDirection(columnOffset, rowOffset) };
+				if (direction != -1)
+				{
+					m_Offsets[direction] = rowOffset * m_NrOfColumns + columnOffset;
+				}
+			}
+		}
+
+		const int nrOfNodes{ GetNrOfNodes() };
+		m_DirectionMasks.assign(nrOfNodes, 0);
+		m_Costs.assign(nrOfNodes * nr_directions, 0.f);
+
+		for (int idx = 0; idx < nrOfNodes; ++idx)
+		{
+			for (auto pConnection : graph.GetConnections(idx))
+			{
+				const int toIdx{ pConnection->GetTo() };
+				const int direction{ GetDirection(toIdx % m_NrOfColumns - idx % m_NrOfColumns, toIdx / m_NrOfColumns - idx / m_NrOfColumns) };
+				if (direction == -1)
+				{
+					m_NrOfColumns = 0;
+					m_NrOfRows = 0;
+					m_DirectionMasks.clear();
+					m_Costs.clear();
+					return false;
+				}
+
+				m_DirectionMasks[idx] |= 1u << direction;
+				m_Costs[idx * nr_directions + direction] = pConnection->GetCost();
+			}
+		}
+
+		return true;
+	}
+
+	inline int GridNeighbors::GetDirection(int columnOffset, int rowOffset)
+	{
+		static const int directions[3][3] =
+		{
+			// row offset -1, 0, 1
+			{ 6, 2, 5 }, // column offset -1
+			{ 3, -1, 1 }, // column offset 0
+			{ 7, 0, 4 } // column offset 1
+		};
+
+		if (columnOffset < -1 || columnOffset > 1 || rowOffset < -1 || rowOffset > 1) return -1;
+		return directions[columnOffset + 1][rowOffset + 1];
+	}
+}
@@ -30,6 +30,8 @@ namespace Elite
 
 		openList.push(pStartNode);
 
+		const FrozenGraph& frozenGraph{ m_pGraph->GetFrozenGraph() };
+
 		while (openList.empty() == false)
 		{
 			T_NodeType* pCurrentNode{ openList.front() };
@@ -41,9 +43,10 @@ namespace Elite
 				break;
 			}
 
-			for (auto& connection : m_pGraph->GetNodeConnections(pCurrentNode))
+			const int currentIdx{ pCurrentNode->GetIndex() };
+			for (int connection{ frozenGraph.GetFirstConnection(currentIdx) }; connection < frozenGraph.GetFirstConnection(currentIdx + 1); ++connection)
 			{
-				T_NodeType* pNextNode{ m_pGraph->GetNode(connection->GetTo()) };
+				T_NodeType* pNextNode{ m_pGraph->GetNode(frozenGraph.GetConnectionTarget(connection)) };
 
 				if (closedList.find(pNextNode) == closedList.end())
 				{
@@ -101,7 +101,7 @@ namespace Elite
 			if (m_IsLeftMouseBtnPressed)
 			{
 				DEBUGRENDERER2D->DrawCircle(nodePos, pGraph->GetNodeRadius(pGraph->GetNode(m_SelectedNodeIdx)), { 1,1,1 }, -1);
-				pGraph->GetNode(m_SelectedNodeIdx)->SetPosition(m_MousePos);
+				pGraph->SetNodePosition(m_SelectedNodeIdx, m_MousePos);
 				hasGraphChanged = true;
 			}
 
@@ -34,14 +34,15 @@ namespace Elite
 
 			//We have valid start/end triangles and they are not the same
 			//=> Start looking for a path
-			//Copy the graph
-			auto clone{ pNavGraph->Clone() };
-			IGraph<NavGraphNode, GraphConnection2D>* copyGraph = clone.get();
+			//The nav graph is shared and never copied or modified here, the start and end node only exist in an overlay on its frozen graph
+			//The search and its overlay are kept per thread, so their memory is reused by the next query
+			static thread_local PolicyAStar<EuclideanHeuristic, OverlayNeighbors> pathfinderAStar{ OverlayNeighbors{} };
 
-			//Create extra node for the Start Node (Agent's position
-			NavGraphNode* pStartNode{ new NavGraphNode{ copyGraph->GetNextFreeNodeIndex(),-1,startPos } };
+			OverlayNeighbors& overlay{ pathfinderAStar.GetNeighbors() };
+			overlay.Reset(&pNavGraph->GetFrozenGraph());
 
-			copyGraph->AddNode(pStartNode);
+			//Create extra node for the Start Node (Agent's position
+			const int startIdx{ overlay.AddNode(startPos) };
 
 			for (int index : startTriangle->metaData.IndexLines)
 			{
@@ -49,16 +50,13 @@ namespace Elite
 
 				if (nodeIndex != -1)
 				{
-					GraphConnection2D* pCurrentConnection{ new GraphConnection2D{ pStartNode->GetIndex(),nodeIndex } };
-					copyGraph->AddConnection(pCurrentConnection);
-					pCurrentConnection->SetCost(Distance(pStartNode->GetPosition(), copyGraph->GetNodePos(nodeIndex)));
+					overlay.AddConnection(startIdx, nodeIndex, Distance(startPos, pNavGraph->GetNodePos(nodeIndex)));
 				}
 			}
 
 			//Create extra node for the endNode
-			NavGraphNode* pEndNode{ new NavGraphNode{ copyGraph->GetNextFreeNodeIndex(),-1,endPos } };
-
-			copyGraph->AddNode(pEndNode);
+			//Only the connections towards it matter, the search never leaves the end node or returns to the start node
+			const int endIdx{ overlay.AddNode(endPos) };
 
 			for (int index : endTriangle->metaData.IndexLines)
 			{
@@ -66,21 +64,26 @@ namespace Elite
 
 				if (nodeIndex != -1)
 				{
-					GraphConnection2D* pCurrentConnection{ new GraphConnection2D{ pEndNode->GetIndex(),nodeIndex } };
-					copyGraph->AddConnection(pCurrentConnection);
-					pCurrentConnection->SetCost(Distance(pEndNode->GetPosition(), copyGraph->GetNodePos(nodeIndex)));
+					overlay.AddConnection(nodeIndex, endIdx, Distance(endPos, pNavGraph->GetNodePos(nodeIndex)));
 				}
 			}
-			//Run A star on new graph
-			auto pathfinderAStar = AStar<NavGraphNode,GraphConnection2D>(copyGraph, Elite::HeuristicFunctions::Euclidean);
-			
+
+			//Run A star on the overlay
+			std::vector<int> visitedIndices{}; //Debug visualisation
+			const std::vector<int> pathIndices{ pathfinderAStar.FindPath(startIdx, endIdx, visitedIndices) };
+
+			//The path smoothing wants nodes, the start and end node live on the stack for the rest of the query
+			NavGraphNode startNode{ startIdx, -1, startPos };
+			NavGraphNode endNode{ endIdx, -1, endPos };
+			auto getNode = [&](int idx) { return idx == startIdx ? &startNode : idx == endIdx ? &endNode : pNavGraph->GetNode(idx); };
+
 			std::vector<NavGraphNode*> finalNodes{};
-			std::vector<NavGraphNode*> visitedNodes{}; //Debug visualisation
 
-			finalNodes = pathfinderAStar.FindPath(pStartNode, pEndNode, visitedNodes);
-		
-			for (NavGraphNode* node : finalNodes)
+			for (int idx : pathIndices)
 			{
+				NavGraphNode* node{ getNode(idx) };
+				finalNodes.push_back(node);
+
 				finalPath.push_back(node->GetPosition());
 
 				//OPTIONAL BUT ADVICED: Debug Visualisation
@@ -88,9 +91,9 @@ namespace Elite
 			}
 
 			//Alle nodes die gecheckt werden om A* te berekenen
-			for (NavGraphNode* node : visitedNodes)
+			for (int idx : visitedIndices)
 			{
-				visitedNodePositions.push_back(node->GetPosition());
+				visitedNodePositions.push_back(overlay.GetNodePos(idx));
 			}
 
 			//Run optimiser on new graph, MAKE SURE the A star path is working properly before starting this section and uncommenting this!!!
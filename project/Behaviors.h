@@ -12,6 +12,8 @@
 #include "EliteAI/EliteDecisionMaking/EliteBehaviorTree/EBehaviorTree.h"
 #include "SteeringBehaviors.h"
 #include "EliteAI/EliteData/EBlackboard.h"
+#include "BlackboardKeys.h"
+#include "Tracing.h"
 
 //-----------------------------------------------------------------
 // Behaviors
@@ -23,76 +25,94 @@ namespace BT_Actions
 
 	Elite::BehaviorState SetBestCellAsTarget(Elite::Blackboard* pBlackboard)
 	{
-		GridElement** pCell;
+		TRACE_ZONE("BT_Actions::SetBestCellAsTarget");
 
-		if (pBlackboard->GetData("CurrentCell", pCell) == false || pCell == nullptr)
+		int* pCellIndex;
+
+		if (pBlackboard->GetData(BB::CurrentCell, pCellIndex) == false || pCellIndex == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		AgentInfo* pAgentInfo;
 
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		IExamInterface* pInterface;
-		if (pBlackboard->GetData("Interface", pInterface) == false || pInterface == nullptr)
+		if (pBlackboard->GetData(BB::Interface, pInterface) == false || pInterface == nullptr)
+		{
+			return Elite::BehaviorState::Failure;
+		}
+
+		ExplorationGrid* pGrid{};
+
+		if (pBlackboard->GetData(BB::Grid, pGrid) == false || pGrid == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Elite::Vector2 target{};
 
-		if ((*pCell)->IsVisited)
+		if (pGrid->IsVisited(*pCellIndex))
 		{
 			float bestInfluence{};
 
-			for (GridElement* pGridElement : (*pCell)->pNeighbors)
+			ExplorationGrid::NeighborArray neighbors{};
+			const int nrNeighbors{ pGrid->GetNeighbors(*pCellIndex, neighbors) };
+
+			for (int idx{}; idx < nrNeighbors; ++idx)
 			{
-				if (pGridElement->IsVisited) continue;
+				const int cellIndex{ neighbors[idx] };
+				if (pGrid->IsVisited(cellIndex)) continue;
 
-				if (bestInfluence <= pGridElement->Influence)
+				if (bestInfluence <= pGrid->GetScore(cellIndex))
 				{
-					bestInfluence = pGridElement->Influence;
-					target = pGridElement->Position;
+					bestInfluence = pGrid->GetScore(cellIndex);
+					target = pGrid->GetPosition(cellIndex);
 				}
 			}
 
 			if (bestInfluence < 0.2f)
 			{
-				std::vector<GridElement*>* pGrid{};
+				//Go for long distances only when it is worth it: the best cell of the grid has to reach 0.6
+				//Without a neighbor to go to, the unvisited cell next to the closest frontier cell is taken when none does
+				const int bestCellIndex{ pGrid->GetBestUnvisitedCell() };
+				const float bestScore{ bestCellIndex < 0 ? 0.f : pGrid->GetScore(bestCellIndex) };
+				const int frontierCellIndex{ bestInfluence <= 0.f ? pGrid->GetNearestFrontierCell(pAgentInfo->Position) : -1 };
 
-				if (pBlackboard->GetData("GridVector", pGrid) == false || pCell == nullptr)
+				if (bestCellIndex >= 0 && bestScore >= 0.6f)
 				{
-					return Elite::BehaviorState::Failure;
+					target = pGrid->GetPosition(bestCellIndex);
 				}
-
-				for (GridElement* pGridElement : *pGrid)
+				else if (frontierCellIndex >= 0)
 				{
-					if (pGridElement->IsVisited) continue;
+					int frontierTargetIndex{ -1 };
 
-					if (bestInfluence > 0.f)
+					const int nrFrontierNeighbors{ pGrid->GetNeighbors(frontierCellIndex, neighbors) };
+					for (int idx{}; idx < nrFrontierNeighbors; ++idx)
 					{
-						//Go for long distances only when it is worth it
-						if (pGridElement->Influence < 0.6f) continue;
-					}
-					
-					if (bestInfluence <= pGridElement->Influence)
-					{
-						bestInfluence = pGridElement->Influence;
-						target = pGridElement->Position;
+						const int cellIndex{ neighbors[idx] };
+						if (pGrid->IsVisited(cellIndex)) continue;
+
+						if (frontierTargetIndex < 0 || pGrid->GetScore(frontierTargetIndex) <= pGrid->GetScore(cellIndex))
+						{
+							frontierTargetIndex = cellIndex;
+						}
 					}
+
+					target = pGrid->GetPosition(frontierTargetIndex);
 				}
 			}
 		}
 		else
 		{
-			target = (*pCell)->Position;
+			target = pGrid->GetPosition(*pCellIndex);
 		}
 		
-		pBlackboard->ChangeData("Target", pInterface->NavMesh_GetClosestPathPoint(target));
+		pBlackboard->ChangeData(BB::Target, pInterface->NavMesh_GetClosestPathPoint(target));
 
 		return Elite::BehaviorState::Success;
 	}
@@ -100,9 +120,11 @@ namespace BT_Actions
 	//Movement
 	Elite::BehaviorState SetRunning(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::SetRunning");
+
 		bool* pShouldRun{};
 
-		if (pBlackboard->GetData("ShouldRun", pShouldRun) == false)
+		if (pBlackboard->GetData(BB::ShouldRun, pShouldRun) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -115,22 +137,24 @@ namespace BT_Actions
 
 	Elite::BehaviorState UpdateRotation(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::UpdateRotation");
+
 
 		bool* pIsCompleted{};
 
-		if (pBlackboard->GetData("IsRotationCompleted", pIsCompleted) == false)
+		if (pBlackboard->GetData(BB::IsRotationCompleted, pIsCompleted) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		float* pStartOrientation{};
-		if (pBlackboard->GetData("StartOrientation", pStartOrientation) == false || pStartOrientation == nullptr)
+		if (pBlackboard->GetData(BB::StartOrientation, pStartOrientation) == false || pStartOrientation == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		AgentInfo* pAgentInfo;
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -145,9 +169,11 @@ namespace BT_Actions
 
 	Elite::BehaviorState ResetRotation(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::ResetRotation");
+
 		bool* pIsRotating{};
 
-		if (pBlackboard->GetData("IsRotating", pIsRotating) == false)
+		if (pBlackboard->GetData(BB::IsRotating, pIsRotating) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -156,7 +182,7 @@ namespace BT_Actions
 
 		bool* pIsCompleted{};
 
-		if (pBlackboard->GetData("IsRotationCompleted", pIsCompleted) == false)
+		if (pBlackboard->GetData(BB::IsRotationCompleted, pIsCompleted) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -168,9 +194,11 @@ namespace BT_Actions
 
 	Elite::BehaviorState InitializeRotating(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::InitializeRotating");
+
 		bool* pIsRotating{};
 
-		if (pBlackboard->GetData("IsRotating", pIsRotating) == false)
+		if (pBlackboard->GetData(BB::IsRotating, pIsRotating) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -178,19 +206,19 @@ namespace BT_Actions
 		*pIsRotating = true;
 
 		float* pStartOrientation{};
-		if (pBlackboard->GetData("StartOrientation", pStartOrientation) == false || pStartOrientation == nullptr)
+		if (pBlackboard->GetData(BB::StartOrientation, pStartOrientation) == false || pStartOrientation == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		AgentInfo* pAgentInfo;
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Elite::Vector2 target{};
-		if (pBlackboard->GetData("Target", target) == false)
+		if (pBlackboard->GetData(BB::Target, target) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -202,132 +230,143 @@ namespace BT_Actions
 	//Enemy
 	Elite::BehaviorState HandleAttackFromBehind(Elite::Blackboard* pBlackboard)
 	{
-		float* pDeltaTime{};
-		if (pBlackboard->GetData("DeltaTime", pDeltaTime) == false || pDeltaTime == nullptr)
+		TRACE_ZONE("BT_Actions::HandleAttackFromBehind");
+
+		TimerWheel* pTimers{};
+		if (pBlackboard->GetData(BB::Timers, pTimers) == false || pTimers == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
-		float* pAlertedTime{};
-		if (pBlackboard->GetData("AlertedTime", pAlertedTime) == false || pAlertedTime == nullptr)
+		TimerWheel::Handle* pAlertedTimer{};
+		if (pBlackboard->GetData(BB::AlertedTimer, pAlertedTimer) == false || pAlertedTimer == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		AgentInfo* pAgentInfo{};
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false || pAgentInfo == nullptr)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false || pAgentInfo == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
+		//Stays alert for a while after the first bite, a bite after that starts a new alert
 		if (pAgentInfo->Bitten)
 		{
-			*pAlertedTime += *pDeltaTime;
+			if (!pTimers->IsPending(*pAlertedTimer)) *pAlertedTimer = pTimers->Schedule(4.f, nullptr);
 			std::cout << "Attack from behind\n";
 
 			AgentInfo* pAgentInfo;
 
-			if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false)
+			if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false)
 			{
 				return Elite::BehaviorState::Failure;
 			}
 
-			pBlackboard->ChangeData("Target", pAgentInfo->Position - Elite::OrientationToVector(pAgentInfo->Orientation) * 100.f);
+			pBlackboard->ChangeData(BB::Target, pAgentInfo->Position - Elite::OrientationToVector(pAgentInfo->Orientation) * 100.f);
 
 			return Elite::BehaviorState::Success;
 		}
-		else if (*pAlertedTime > 0.f && *pAlertedTime < 4.f)
+		else if (pTimers->IsPending(*pAlertedTimer))
 		{
-			*pAlertedTime += *pDeltaTime;
 			return Elite::BehaviorState::Success;
 		}
 		else
 		{
-			*pAlertedTime = 0.f;
 			return Elite::BehaviorState::Failure;
 		}
 	}
 
 	Elite::BehaviorState SetClosestEnemyAsTarget(Elite::Blackboard* pBlackboard)
 	{
-		float* pAlertedTime{};
-		if (pBlackboard->GetData("AlertedTime", pAlertedTime) == false || pAlertedTime == nullptr)
+		TRACE_ZONE("BT_Actions::SetClosestEnemyAsTarget");
+
+		TimerWheel* pTimers{};
+		if (pBlackboard->GetData(BB::Timers, pTimers) == false || pTimers == nullptr)
+		{
+			return Elite::BehaviorState::Failure;
+		}
+
+		TimerWheel::Handle* pAlertedTimer{};
+		if (pBlackboard->GetData(BB::AlertedTimer, pAlertedTimer) == false || pAlertedTimer == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
-		*pAlertedTime = 0.f;
+		pTimers->Cancel(*pAlertedTimer);
 
-		std::vector<EnemyInfo>* pEnemyVector;
+		EnemyFovBuffer* pEnemyFov;
 
-		if (pBlackboard->GetData("EnemyVector", pEnemyVector) == false || pEnemyVector == nullptr)
+		if (pBlackboard->GetData(BB::EnemyFov, pEnemyFov) == false || pEnemyFov == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		AgentInfo* pAgentInfo;
 
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		IExamInterface* pInterface;
 
-		if (pBlackboard->GetData("Interface", pInterface) == false || pInterface == nullptr)
+		if (pBlackboard->GetData(BB::Interface, pInterface) == false || pInterface == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
-		EnemyInfo closestEnemy;
+		Elite::Vector2 closestEnemyLocation{};
 		float closestDistSq{ INFINITY };
 
-		for (auto& enemy : *pEnemyVector)
+		for (const Elite::Vector2& enemyLocation : pEnemyFov->Locations)
 		{
-			float distSq = enemy.Location.DistanceSquared(pAgentInfo->Position);
+			float distSq = enemyLocation.DistanceSquared(pAgentInfo->Position);
 
 			if (distSq < closestDistSq)
 			{
 				closestDistSq = distSq;
 
-				closestEnemy = enemy;
+				closestEnemyLocation = enemyLocation;
 			}
 		}
 
-		pBlackboard->ChangeData("Target", closestEnemy.Location);
+		pBlackboard->ChangeData(BB::Target, closestEnemyLocation);
 
 		return Elite::BehaviorState::Success;
 	}
 
 	Elite::BehaviorState HandleShooting(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::HandleShooting");
+
 		IExamInterface* pInterface;
 
-		if (pBlackboard->GetData("Interface", pInterface) == false || pInterface == nullptr)
+		if (pBlackboard->GetData(BB::Interface, pInterface) == false || pInterface == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		std::vector<std::pair<int,InventoryItemType>>* pInventory;
 
-		if (pBlackboard->GetData("Inventory", pInventory) == false || pInventory == nullptr)
+		if (pBlackboard->GetData(BB::Inventory, pInventory) == false || pInventory == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Elite::Vector2 target;
-		if (pBlackboard->GetData("Target", target) == false )
+		if (pBlackboard->GetData(BB::Target, target) == false )
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		AgentInfo* pAgent{};
-		if (pBlackboard->GetData("AgentInfo", pAgent) == false)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgent) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
-		UINT slotIndex{ pInventory->size() };
+		UINT slotIndex{ static_cast<UINT>(pInventory->size()) };
 		int leastAmmo{ 1000 };
 		int currentAmmo{};
 
@@ -391,23 +430,25 @@ namespace BT_Actions
 
 	Elite::BehaviorState SetClosestItemAsTarget(Elite::Blackboard* pBlackboard)
 	{
-		std::vector<Item*>* pItemVector;
+		TRACE_ZONE("BT_Actions::SetClosestItemAsTarget");
+
+		EntityRegistry<Item>* pItemVector;
 
-		if (pBlackboard->GetData("ItemVector", pItemVector) == false || pItemVector == nullptr)
+		if (pBlackboard->GetData(BB::ItemVector, pItemVector) == false || pItemVector == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		AgentInfo* pAgentInfo;
 
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		IExamInterface* pInterface;
 
-		if (pBlackboard->GetData("Interface", pInterface) == false || pInterface == nullptr)
+		if (pBlackboard->GetData(BB::Interface, pInterface) == false || pInterface == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -431,8 +472,8 @@ namespace BT_Actions
 		
 		if (pClosestItem)
 		{
-			pBlackboard->ChangeData("Target", pInterface->NavMesh_GetClosestPathPoint(pClosestItem->itemInfo.Location));
-			pBlackboard->ChangeData("TargetItem", pClosestItem);
+			pBlackboard->ChangeData(BB::Target, pInterface->NavMesh_GetClosestPathPoint(pClosestItem->itemInfo.Location));
+			pBlackboard->ChangeData(BB::TargetItem, pClosestItem);
 
 			return Elite::BehaviorState::Success;
 		}
@@ -444,36 +485,40 @@ namespace BT_Actions
 
 	Elite::BehaviorState DestroyItem(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::DestroyItem");
+
 
 		IExamInterface* pInterface;
 
-		if (pBlackboard->GetData("Interface", pInterface) == false || pInterface == nullptr)
+		if (pBlackboard->GetData(BB::Interface, pInterface) == false || pInterface == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Item* pItem;
 
-		if (pBlackboard->GetData("TargetItem", pItem) == false)
+		if (pBlackboard->GetData(BB::TargetItem, pItem) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		if (pInterface->Item_Destroy(pItem->entityInfo))
 		{
-			std::vector<Item*>* pItemVector;
+			EntityRegistry<Item>* pItemVector;
 
-			if (pBlackboard->GetData("ItemVector", pItemVector) == false || pItemVector == nullptr)
+			if (pBlackboard->GetData(BB::ItemVector, pItemVector) == false || pItemVector == nullptr)
 			{
 				return Elite::BehaviorState::Failure;
 			}
 
-			auto remover = [&](Item* pItemInVector)->bool
-			{
-				return pItem == pItemInVector;
-			};
+			pItemVector->Remove(pItem);
 
-			pItemVector->erase(std::remove_if(pItemVector->begin(), pItemVector->end(), remover), pItemVector->end());
+			//The house's revisit timer walks its items, so it can not keep the destroyed one
+			if (pItem->pHouse != nullptr)
+			{
+				std::vector<Item*>& pHouseItems{ pItem->pHouse->pItems };
+				pHouseItems.erase(std::remove(pHouseItems.begin(), pHouseItems.end(), pItem), pHouseItems.end());
+			}
 
 			return Elite::BehaviorState::Success;
 		}
@@ -483,23 +528,25 @@ namespace BT_Actions
 
 	Elite::BehaviorState HandleItemGrabbing(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::HandleItemGrabbing");
+
 		IExamInterface* pInterface;
 
-		if (pBlackboard->GetData("Interface", pInterface) == false || pInterface == nullptr)
+		if (pBlackboard->GetData(BB::Interface, pInterface) == false || pInterface == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		std::vector<std::pair<int, InventoryItemType>>* pInventory{};
 
-		if (pBlackboard->GetData("Inventory", pInventory) == false || pInventory == nullptr)
+		if (pBlackboard->GetData(BB::Inventory, pInventory) == false || pInventory == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Item* pItem;
 
-		if (pBlackboard->GetData("TargetItem", pItem) == false)
+		if (pBlackboard->GetData(BB::TargetItem, pItem) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -566,7 +613,7 @@ namespace BT_Actions
 		}
 
 		//Check for the worst slot
-		UINT slotIndex{ pInventory->size() };
+		UINT slotIndex{ static_cast<UINT>(pInventory->size()) };
 		int largerstDifference{};
 		int currentDifference{};
 
@@ -655,19 +702,20 @@ namespace BT_Actions
 			pInterface->Inventory_AddItem(slotIndex, pItem->itemInfo);
 
 			//Remove from item list
-			std::vector<Item*>* pItemVector;
+			EntityRegistry<Item>* pItemVector;
 
-			if (pBlackboard->GetData("ItemVector", pItemVector) == false || pItemVector == nullptr)
+			if (pBlackboard->GetData(BB::ItemVector, pItemVector) == false || pItemVector == nullptr)
 			{
 				return Elite::BehaviorState::Failure;
 			}
 
-			auto remover = [&](Item* pItemInVector)->bool
-			{
-				return pItem == pItemInVector;
-			};
+			pItemVector->Remove(pItem);
 
-			pItemVector->erase(std::remove_if(pItemVector->begin(), pItemVector->end(), remover), pItemVector->end());
+			if (pItem->pHouse != nullptr)
+			{
+				std::vector<Item*>& pHouseItems{ pItem->pHouse->pItems };
+				pHouseItems.erase(std::remove(pHouseItems.begin(), pHouseItems.end(), pItem), pHouseItems.end());
+			}
 		}
 		//Leave on ground
 		else
@@ -681,22 +729,24 @@ namespace BT_Actions
 
 	Elite::BehaviorState HandleFoodAndMedkitUsage(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::HandleFoodAndMedkitUsage");
+
 		IExamInterface* pInterface;
 
-		if (pBlackboard->GetData("Interface", pInterface) == false || pInterface == nullptr)
+		if (pBlackboard->GetData(BB::Interface, pInterface) == false || pInterface == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		std::vector<std::pair<int, InventoryItemType>>* pInventory{};
 
-		if (pBlackboard->GetData("Inventory", pInventory) == false || pInventory == nullptr)
+		if (pBlackboard->GetData(BB::Inventory, pInventory) == false || pInventory == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		AgentInfo* pAgentInfo{};
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false || pAgentInfo == nullptr)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false || pAgentInfo == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -768,17 +818,19 @@ namespace BT_Actions
 
 	Elite::BehaviorState ChangeToRotateClockWise(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::ChangeToRotateClockWise");
+
 		ISteeringBehavior* pCurrentSteering;
 
 		RotateClockWise* pRotateClockWise;
-		if (pBlackboard->GetData("RotateClockWise", pRotateClockWise) == false || pRotateClockWise == nullptr)
+		if (pBlackboard->GetData(BB::RotateClockWise, pRotateClockWise) == false || pRotateClockWise == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		pCurrentSteering = pRotateClockWise;
 
-		if (pBlackboard->ChangeData("CurrentSteering", pCurrentSteering))
+		if (pBlackboard->ChangeData(BB::CurrentSteering, pCurrentSteering))
 		{
 			return Elite::BehaviorState::Success;
 		}
@@ -788,17 +840,19 @@ namespace BT_Actions
 
 	Elite::BehaviorState ChangeToWander(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::ChangeToWander");
+
 		ISteeringBehavior* pCurrentSteering;
 
 		Wander* pWander;
-		if (pBlackboard->GetData("Wander", pWander) == false || pWander == nullptr)
+		if (pBlackboard->GetData(BB::Wander, pWander) == false || pWander == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		pCurrentSteering = pWander;
 
-		if (pBlackboard->ChangeData("CurrentSteering", pCurrentSteering))
+		if (pBlackboard->ChangeData(BB::CurrentSteering, pCurrentSteering))
 		{
 			return Elite::BehaviorState::Success;
 		}
@@ -808,16 +862,18 @@ namespace BT_Actions
 
 	Elite::BehaviorState ChangeToFleeTarget(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::ChangeToFleeTarget");
+
 		ISteeringBehavior* pCurrentSteering;
 
 		Flee* pFlee;
-		if (pBlackboard->GetData("Flee", pFlee) == false || pFlee == nullptr)
+		if (pBlackboard->GetData(BB::Flee, pFlee) == false || pFlee == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Elite::Vector2 target;
-		if (pBlackboard->GetData("Target", target) == false)
+		if (pBlackboard->GetData(BB::Target, target) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -826,7 +882,7 @@ namespace BT_Actions
 
 		pCurrentSteering = pFlee;
 
-		if (pBlackboard->ChangeData("CurrentSteering", pCurrentSteering))
+		if (pBlackboard->ChangeData(BB::CurrentSteering, pCurrentSteering))
 		{
 			return Elite::BehaviorState::Success;
 		}
@@ -836,16 +892,18 @@ namespace BT_Actions
 
 	Elite::BehaviorState ChangeToFaceTarget(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::ChangeToFaceTarget");
+
 		ISteeringBehavior* pCurrentSteering;
 
 		Face* pFace;
-		if (pBlackboard->GetData("Face", pFace) == false || pFace == nullptr)
+		if (pBlackboard->GetData(BB::Face, pFace) == false || pFace == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Elite::Vector2 target;
-		if (pBlackboard->GetData("Target", target) == false)
+		if (pBlackboard->GetData(BB::Target, target) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -854,7 +912,7 @@ namespace BT_Actions
 
 		pCurrentSteering = pFace;
 
-		if (pBlackboard->ChangeData("CurrentSteering", pCurrentSteering))
+		if (pBlackboard->ChangeData(BB::CurrentSteering, pCurrentSteering))
 		{
 			return Elite::BehaviorState::Success;
 		}
@@ -866,28 +924,30 @@ namespace BT_Actions
 
 	Elite::BehaviorState ChangeToFaceAndSeekTarget(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::ChangeToFaceAndSeekTarget");
+
 		ISteeringBehavior* pCurrentSteering;
 
 		Seek* pSeek;
-		if (pBlackboard->GetData("Seek", pSeek) == false || pSeek == nullptr)
+		if (pBlackboard->GetData(BB::Seek, pSeek) == false || pSeek == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Face* pFace;
-		if (pBlackboard->GetData("Face", pFace) == false || pFace == nullptr)
+		if (pBlackboard->GetData(BB::Face, pFace) == false || pFace == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		PrioritySteering* pFaceAndSeek;
-		if (pBlackboard->GetData("FaceAndSeek", pFaceAndSeek) == false || pFaceAndSeek == nullptr)
+		if (pBlackboard->GetData(BB::FaceAndSeek, pFaceAndSeek) == false || pFaceAndSeek == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Elite::Vector2 target;
-		if (pBlackboard->GetData("Target", target) == false)
+		if (pBlackboard->GetData(BB::Target, target) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -897,7 +957,7 @@ namespace BT_Actions
 
 		pCurrentSteering = pFaceAndSeek;
 
-		if (pBlackboard->ChangeData("CurrentSteering", pCurrentSteering))
+		if (pBlackboard->ChangeData(BB::CurrentSteering, pCurrentSteering))
 		{
 			return Elite::BehaviorState::Success;
 		}
@@ -909,28 +969,30 @@ namespace BT_Actions
 
 	Elite::BehaviorState ChangeToFleeAndFaceTarget(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::ChangeToFleeAndFaceTarget");
+
 		ISteeringBehavior* pCurrentSteering;
 
 		Flee* pFlee;
-		if (pBlackboard->GetData("Flee", pFlee) == false || pFlee == nullptr)
+		if (pBlackboard->GetData(BB::Flee, pFlee) == false || pFlee == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Face* pFace;
-		if (pBlackboard->GetData("Face", pFace) == false || pFace == nullptr)
+		if (pBlackboard->GetData(BB::Face, pFace) == false || pFace == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		AddedSteering* pFleeAndFace;
-		if (pBlackboard->GetData("FleeAndFace", pFleeAndFace) == false || pFleeAndFace == nullptr)
+		if (pBlackboard->GetData(BB::FleeAndFace, pFleeAndFace) == false || pFleeAndFace == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Elite::Vector2 target;
-		if (pBlackboard->GetData("Target", target) == false)
+		if (pBlackboard->GetData(BB::Target, target) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -940,7 +1002,7 @@ namespace BT_Actions
 
 		pCurrentSteering = pFleeAndFace;
 
-		if (pBlackboard->ChangeData("CurrentSteering", pCurrentSteering))
+		if (pBlackboard->ChangeData(BB::CurrentSteering, pCurrentSteering))
 		{
 			return Elite::BehaviorState::Success;
 		}
@@ -952,28 +1014,30 @@ namespace BT_Actions
 
 	Elite::BehaviorState ChangeToWanderAndSeekTarget(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::ChangeToWanderAndSeekTarget");
+
 		ISteeringBehavior* pCurrentSteering;
 
 		Seek* pSeek;
-		if (pBlackboard->GetData("Seek", pSeek) == false || pSeek == nullptr)
+		if (pBlackboard->GetData(BB::Seek, pSeek) == false || pSeek == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Wander* pWander;
-		if (pBlackboard->GetData("Wander", pWander) == false || pWander == nullptr)
+		if (pBlackboard->GetData(BB::Wander, pWander) == false || pWander == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		AddedSteering* pWanderAndSeek;
-		if (pBlackboard->GetData("WanderAndSeek", pWanderAndSeek) == false || pWanderAndSeek == nullptr)
+		if (pBlackboard->GetData(BB::WanderAndSeek, pWanderAndSeek) == false || pWanderAndSeek == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Elite::Vector2 target;
-		if (pBlackboard->GetData("Target", target) == false)
+		if (pBlackboard->GetData(BB::Target, target) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -983,7 +1047,7 @@ namespace BT_Actions
 
 		pCurrentSteering = pWanderAndSeek;
 
-		if (pBlackboard->ChangeData("CurrentSteering", pCurrentSteering))
+		if (pBlackboard->ChangeData(BB::CurrentSteering, pCurrentSteering))
 		{
 			return Elite::BehaviorState::Success;
 		}
@@ -995,34 +1059,36 @@ namespace BT_Actions
 
 	Elite::BehaviorState ChangeToSeekAndFaceTarget(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::ChangeToSeekAndFaceTarget");
+
 		ISteeringBehavior* pCurrentSteering;
 
 		Seek* pSeek;
-		if (pBlackboard->GetData("Seek", pSeek) == false || pSeek == nullptr)
+		if (pBlackboard->GetData(BB::Seek, pSeek) == false || pSeek == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Face* pFace;
-		if (pBlackboard->GetData("Face", pFace) == false || pFace == nullptr)
+		if (pBlackboard->GetData(BB::Face, pFace) == false || pFace == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		AddedSteering* pSeekAndFace;
-		if (pBlackboard->GetData("SeekAndFace", pSeekAndFace) == false || pSeekAndFace == nullptr)
+		if (pBlackboard->GetData(BB::SeekAndFace, pSeekAndFace) == false || pSeekAndFace == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Elite::Vector2 target;
-		if (pBlackboard->GetData("Target", target) == false)
+		if (pBlackboard->GetData(BB::Target, target) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		AgentInfo* pAgentInfo{};
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false || pAgentInfo == nullptr)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false || pAgentInfo == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -1032,7 +1098,7 @@ namespace BT_Actions
 
 		pCurrentSteering = pSeekAndFace;
 
-		if (pBlackboard->ChangeData("CurrentSteering", pCurrentSteering))
+		if (pBlackboard->ChangeData(BB::CurrentSteering, pCurrentSteering))
 		{
 			return Elite::BehaviorState::Success;
 		}
@@ -1044,34 +1110,36 @@ namespace BT_Actions
 
 	Elite::BehaviorState ChangeToSeekTargetAndFaceBack(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::ChangeToSeekTargetAndFaceBack");
+
 		ISteeringBehavior* pCurrentSteering;
 
 		Seek* pSeek;
-		if (pBlackboard->GetData("Seek", pSeek) == false || pSeek == nullptr)
+		if (pBlackboard->GetData(BB::Seek, pSeek) == false || pSeek == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Face* pFace;
-		if (pBlackboard->GetData("Face", pFace) == false || pFace == nullptr)
+		if (pBlackboard->GetData(BB::Face, pFace) == false || pFace == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		AddedSteering* pSeekAndFace;
-		if (pBlackboard->GetData("SeekAndFace", pSeekAndFace) == false || pSeekAndFace == nullptr)
+		if (pBlackboard->GetData(BB::SeekAndFace, pSeekAndFace) == false || pSeekAndFace == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Elite::Vector2 target;
-		if (pBlackboard->GetData("Target", target) == false)
+		if (pBlackboard->GetData(BB::Target, target) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		AgentInfo* pAgentInfo{};
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false || pAgentInfo == nullptr)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false || pAgentInfo == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -1083,7 +1151,7 @@ namespace BT_Actions
 
 		pCurrentSteering = pSeekAndFace;
 
-		if (pBlackboard->ChangeData("CurrentSteering", pCurrentSteering))
+		if (pBlackboard->ChangeData(BB::CurrentSteering, pCurrentSteering))
 		{
 			return Elite::BehaviorState::Success;
 		}
@@ -1095,16 +1163,18 @@ namespace BT_Actions
 
 	Elite::BehaviorState ChangeToSeekTarget(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::ChangeToSeekTarget");
+
 		ISteeringBehavior* pCurrentSteering;
 
 		Seek* pSeek;
-		if (pBlackboard->GetData("Seek", pSeek) == false || pSeek == nullptr)
+		if (pBlackboard->GetData(BB::Seek, pSeek) == false || pSeek == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Elite::Vector2 target;
-		if (pBlackboard->GetData("Target", target) == false)
+		if (pBlackboard->GetData(BB::Target, target) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -1112,7 +1182,7 @@ namespace BT_Actions
 		pSeek->SetTarget(target);
 		pCurrentSteering = pSeek;
 
-		if (pBlackboard->ChangeData("CurrentSteering", pCurrentSteering))
+		if (pBlackboard->ChangeData(BB::CurrentSteering, pCurrentSteering))
 		{
 			return Elite::BehaviorState::Success;
 		}
@@ -1124,16 +1194,18 @@ namespace BT_Actions
 
 	Elite::BehaviorState ChangeToArriveAtTarget(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::ChangeToArriveAtTarget");
+
 		ISteeringBehavior* pCurrentSteering;
 
 		Arrive* pArrive;
-		if (pBlackboard->GetData("Arrive", pArrive) == false || pArrive == nullptr)
+		if (pBlackboard->GetData(BB::Arrive, pArrive) == false || pArrive == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Elite::Vector2 target;
-		if (pBlackboard->GetData("Target", target) == false)
+		if (pBlackboard->GetData(BB::Target, target) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -1141,7 +1213,7 @@ namespace BT_Actions
 		pArrive->SetTarget(target);
 		pCurrentSteering = pArrive;
 
-		if (pBlackboard->ChangeData("CurrentSteering", pCurrentSteering))
+		if (pBlackboard->ChangeData(BB::CurrentSteering, pCurrentSteering))
 		{
 			return Elite::BehaviorState::Success;
 		}
@@ -1154,15 +1226,17 @@ namespace BT_Actions
 	//Purge Zones
 	Elite::BehaviorState SetClosestPointOutsidePurgeZoneAsTarget(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::SetClosestPointOutsidePurgeZoneAsTarget");
+
 		AgentInfo* pAgentInfo;
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
-		std::vector<PurgeZone*>* pPurgeZones;
+		EntityRegistry<PurgeZone>* pPurgeZones;
 
-		if (pBlackboard->GetData("PurgeVector", pPurgeZones) == false || pPurgeZones == nullptr)
+		if (pBlackboard->GetData(BB::PurgeVector, pPurgeZones) == false || pPurgeZones == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -1185,26 +1259,28 @@ namespace BT_Actions
 		direction.Normalize();
 
 		IExamInterface* pInterface;
-		if (pBlackboard->GetData("Interface", pInterface) == false || pInterface == nullptr)
+		if (pBlackboard->GetData(BB::Interface, pInterface) == false || pInterface == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
-		pBlackboard->ChangeData("Target", pInterface->NavMesh_GetClosestPathPoint(pClosestPurgeZone->Center + direction * pClosestPurgeZone->Radius));
+		pBlackboard->ChangeData(BB::Target, pInterface->NavMesh_GetClosestPathPoint(pClosestPurgeZone->Center + direction * pClosestPurgeZone->Radius));
 
 		return Elite::BehaviorState::Success;
 	}
 	//House
 	Elite::BehaviorState SetClosestNotVisitedSearchPointAsTarget(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::SetClosestNotVisitedSearchPointAsTarget");
+
 		AgentInfo* pAgentInfo;
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		House* pHouse{};
-		if (pBlackboard->GetData("TargetHouse", pHouse) == false || pHouse == nullptr)
+		if (pBlackboard->GetData(BB::TargetHouse, pHouse) == false || pHouse == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -1227,27 +1303,29 @@ namespace BT_Actions
 
 		IExamInterface* pInterface;
 
-		if (pBlackboard->GetData("Interface", pInterface) == false || pInterface == nullptr)
+		if (pBlackboard->GetData(BB::Interface, pInterface) == false || pInterface == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
-		pBlackboard->ChangeData("Target", pInterface->NavMesh_GetClosestPathPoint(pClosestSearchPoint->Position));
+		pBlackboard->ChangeData(BB::Target, pInterface->NavMesh_GetClosestPathPoint(pClosestSearchPoint->Position));
 
 		return Elite::BehaviorState::Success;
 	}
 
 	Elite::BehaviorState SetClosestNotVisitedHouseAsTarget(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::SetClosestNotVisitedHouseAsTarget");
+
 		AgentInfo* pAgentInfo;
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
-		std::vector<House*>* pHouses;
+		EntityRegistry<House>* pHouses;
 
-		if (pBlackboard->GetData("HouseVector", pHouses) == false || pHouses == nullptr)
+		if (pBlackboard->GetData(BB::HouseVector, pHouses) == false || pHouses == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -1269,39 +1347,69 @@ namespace BT_Actions
 		}
 
 		IExamInterface* pInterface;
-		if (pBlackboard->GetData("Interface", pInterface) == false || pInterface == nullptr)
+		if (pBlackboard->GetData(BB::Interface, pInterface) == false || pInterface == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
-		pBlackboard->ChangeData("Target", pInterface->NavMesh_GetClosestPathPoint(pClosestSearchPoint->Center));
-		pBlackboard->ChangeData("TargetHouse", pClosestSearchPoint);
+		pBlackboard->ChangeData(BB::Target, pInterface->NavMesh_GetClosestPathPoint(pClosestSearchPoint->Center));
+		pBlackboard->ChangeData(BB::TargetHouse, pClosestSearchPoint);
 
 		return Elite::BehaviorState::Success;
 	}
 
 	Elite::BehaviorState MarkHouseAsVisited(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::MarkHouseAsVisited");
+
 		House* pHouse{};
-		if (pBlackboard->GetData("TargetHouse", pHouse) == false || pHouse == nullptr)
+		if (pBlackboard->GetData(BB::TargetHouse, pHouse) == false || pHouse == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 		
+		TimerWheel* pTimers{};
+		if (pBlackboard->GetData(BB::Timers, pTimers) == false || pTimers == nullptr)
+		{
+			return Elite::BehaviorState::Failure;
+		}
+
 		pHouse->IsVisited = true;
+
+		//Searched again after some time, the items that are still there included
+		if (!pTimers->IsPending(pHouse->RevisitTimer))
+		{
+			pHouse->RevisitTimer = pTimers->Schedule(House::RevisitTime, [pHouse]()
+			{
+				pHouse->IsVisited = false;
+
+				for (Item* pItem : pHouse->pItems)
+				{
+					pItem->IsVisited = false;
+				}
+
+				for (SearchPoint* pSearchPoint : pHouse->pSearchPoints)
+				{
+					pSearchPoint->IsVisited = false;
+				}
+			});
+		}
+
 		return Elite::BehaviorState::Success;
 	}
 
 	Elite::BehaviorState MarkSearchPointAsVisited(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Actions::MarkSearchPointAsVisited");
+
 		House* pHouse{};
-		if (pBlackboard->GetData("TargetHouse", pHouse) == false || pHouse == nullptr)
+		if (pBlackboard->GetData(BB::TargetHouse, pHouse) == false || pHouse == nullptr)
 		{
 			return Elite::BehaviorState::Failure;
 		}
 
 		Elite::Vector2 target{};
-		if (pBlackboard->GetData("Target", target) == false)
+		if (pBlackboard->GetData(BB::Target, target) == false)
 		{
 			return Elite::BehaviorState::Failure;
 		}
@@ -1334,9 +1442,11 @@ namespace BT_Conditions
 	
 	bool IsItemNotGarbage(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Conditions::IsItemNotGarbage");
+
 		Item* pItem{};
 
-		if (pBlackboard->GetData("TargetItem", pItem) == false)
+		if (pBlackboard->GetData(BB::TargetItem, pItem) == false)
 		{
 			return false;
 		}
@@ -1353,23 +1463,25 @@ namespace BT_Conditions
 
 	bool IsItemNotInGrabRange(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Conditions::IsItemNotInGrabRange");
+
 		Item* pItem{};
 
-		if (pBlackboard->GetData("TargetItem", pItem) == false)
+		if (pBlackboard->GetData(BB::TargetItem, pItem) == false)
 		{
 			return false;
 		}
 
 		AgentInfo* pAgentInfo{};
 
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false || pAgentInfo == nullptr)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false || pAgentInfo == nullptr)
 		{
 			return false;
 		}
 
 		IExamInterface* pInterface{};
 
-		if (pBlackboard->GetData("Interface", pInterface) == false || pInterface == nullptr)
+		if (pBlackboard->GetData(BB::Interface, pInterface) == false || pInterface == nullptr)
 		{
 			return false;
 		}
@@ -1405,24 +1517,26 @@ namespace BT_Conditions
 
 	bool IsNotVisitedItemInVector(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Conditions::IsNotVisitedItemInVector");
+
 		bool* pIsRotating{};
-		if (pBlackboard->GetData("IsRotating", pIsRotating) == false)
+		if (pBlackboard->GetData(BB::IsRotating, pIsRotating) == false)
 		{
 			return false;
 		}
 
 		(*pIsRotating) = false;
 
-		std::vector<Item*>* pItemVector;
+		EntityRegistry<Item>* pItemVector;
 
-		if (pBlackboard->GetData("ItemVector", pItemVector) == false || pItemVector == nullptr)
+		if (pBlackboard->GetData(BB::ItemVector, pItemVector) == false || pItemVector == nullptr)
 		{
 			return false;
 		}
 
 		House* pTargetHouse{};
 
-		if (pBlackboard->GetData("TargetHouse", pTargetHouse) == false || pTargetHouse == nullptr)
+		if (pBlackboard->GetData(BB::TargetHouse, pTargetHouse) == false || pTargetHouse == nullptr)
 		{
 			return false;
 		}
@@ -1436,27 +1550,31 @@ namespace BT_Conditions
 
 	bool IsEnemyInVector(Elite::Blackboard* pBlackboard)
 	{
-		std::vector<EnemyInfo>* pEnemyVector;
+		TRACE_ZONE("BT_Conditions::IsEnemyInVector");
+
+		EnemyFovBuffer* pEnemyFov;
 
-		if (pBlackboard->GetData("EnemyVector", pEnemyVector) == false || pEnemyVector == nullptr)
+		if (pBlackboard->GetData(BB::EnemyFov, pEnemyFov) == false || pEnemyFov == nullptr)
 		{
 			return false;
 		}
 
-		return !pEnemyVector->empty();
+		return !pEnemyFov->empty();
 	}
 
 	//Purge Zones
 	bool IsInPurgeZone(Elite::Blackboard* pBlackboard)
 	{
-		std::vector<PurgeZone*>* pPurgeZones{};
-		if (pBlackboard->GetData("PurgeVector", pPurgeZones) == false || pPurgeZones == nullptr)
+		TRACE_ZONE("BT_Conditions::IsInPurgeZone");
+
+		EntityRegistry<PurgeZone>* pPurgeZones{};
+		if (pBlackboard->GetData(BB::PurgeVector, pPurgeZones) == false || pPurgeZones == nullptr)
 		{
 			return false;
 		}
 
 		AgentInfo* pAgentInfo{};
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false || pAgentInfo == nullptr)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false || pAgentInfo == nullptr)
 		{
 			return false;
 		}
@@ -1477,14 +1595,16 @@ namespace BT_Conditions
 	//House
 	bool IsAgentNotInsideTargetHouse(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Conditions::IsAgentNotInsideTargetHouse");
+
 		House* pHouse{};
-		if (pBlackboard->GetData("TargetHouse", pHouse) == false || pHouse == nullptr)
+		if (pBlackboard->GetData(BB::TargetHouse, pHouse) == false || pHouse == nullptr)
 		{
 			return false;
 		}
 
 		AgentInfo* pAgentInfo{};
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false || pAgentInfo == nullptr)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false || pAgentInfo == nullptr)
 		{
 			return false;
 		}
@@ -1497,9 +1617,11 @@ namespace BT_Conditions
 
 	bool IsNotVisitedHouseInVector(Elite::Blackboard* pBlackboard)
 	{
-		std::vector<House*>* pHouseVector;
+		TRACE_ZONE("BT_Conditions::IsNotVisitedHouseInVector");
+
+		EntityRegistry<House>* pHouseVector;
 
-		if (pBlackboard->GetData("HouseVector", pHouseVector) == false || pHouseVector == nullptr)
+		if (pBlackboard->GetData(BB::HouseVector, pHouseVector) == false || pHouseVector == nullptr)
 		{
 			return false;
 		}
@@ -1515,9 +1637,11 @@ namespace BT_Conditions
 
 	bool IsNotVisitedSearchPointInHouse(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Conditions::IsNotVisitedSearchPointInHouse");
+
 		House* pHouse{};
 
-		if (pBlackboard->GetData("TargetHouse", pHouse) == false || pHouse == nullptr)
+		if (pBlackboard->GetData(BB::TargetHouse, pHouse) == false || pHouse == nullptr)
 		{
 			return false;
 		}
@@ -1535,15 +1659,17 @@ namespace BT_Conditions
 
 	bool HasNotArrivedAtLocation(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Conditions::HasNotArrivedAtLocation");
+
 		Elite::Vector2 target{};
-		if (pBlackboard->GetData("Target", target) == false)
+		if (pBlackboard->GetData(BB::Target, target) == false)
 		{
 			return false;
 		}
 
 		AgentInfo* pAgentInfo{};
 
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false || pAgentInfo == nullptr)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false || pAgentInfo == nullptr)
 		{
 			return false;
 		}
@@ -1553,15 +1679,17 @@ namespace BT_Conditions
 
 	bool IsAimingFinished(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Conditions::IsAimingFinished");
+
 		Elite::Vector2 target{};
-		if (pBlackboard->GetData("Target", target) == false)
+		if (pBlackboard->GetData(BB::Target, target) == false)
 		{
 			return false;
 		}
 
 		AgentInfo* pAgentInfo{};
 
-		if (pBlackboard->GetData("AgentInfo", pAgentInfo) == false || pAgentInfo == nullptr)
+		if (pBlackboard->GetData(BB::AgentInfo, pAgentInfo) == false || pAgentInfo == nullptr)
 		{
 			return false;
 		}
@@ -1576,39 +1704,36 @@ namespace BT_Conditions
 
 	bool ShouldLookBack(Elite::Blackboard* pBlackboard)
 	{
-		float* pDeltaTime{};
-		if (pBlackboard->GetData("DeltaTime", pDeltaTime) == false || pDeltaTime == nullptr)
-		{
-			return false;
-		}
+		TRACE_ZONE("BT_Conditions::ShouldLookBack");
 
-		float* pWalkingTime{};
-		if (pBlackboard->GetData("WalkingTime", pWalkingTime) == false || pWalkingTime == nullptr)
+		TimerWheel* pTimers{};
+		if (pBlackboard->GetData(BB::Timers, pTimers) == false || pTimers == nullptr)
 		{
 			return false;
 		}
 
-		*pWalkingTime += *pDeltaTime;
-
-		if (*pWalkingTime >= 7.f)
+		TimerWheel::Handle* pWalkingTimer{};
+		if (pBlackboard->GetData(BB::WalkingTimer, pWalkingTimer) == false || pWalkingTimer == nullptr)
 		{
-			*pWalkingTime = 0.f;
 			return false;
 		}
-		else if(*pWalkingTime >= 5.f)
-		{
-			return true;
-		}
-		else
+
+		//Cycles of 7 seconds, the last 2 of them are spent looking back
+		if (!pTimers->IsPending(*pWalkingTimer))
 		{
+			*pWalkingTimer = pTimers->Schedule(7.f, nullptr);
 			return false;
 		}
+
+		return pTimers->GetRemainingTime(*pWalkingTimer) <= 2.f;
 	}
 
 	bool IsAgentNotRotating(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Conditions::IsAgentNotRotating");
+
 		bool* pIsRotating{};
-		if (pBlackboard->GetData("IsRotating", pIsRotating) == false)
+		if (pBlackboard->GetData(BB::IsRotating, pIsRotating) == false)
 		{
 			return false;
 		}
@@ -1618,9 +1743,11 @@ namespace BT_Conditions
 
 	bool IsRotationNotCompleted(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Conditions::IsRotationNotCompleted");
+
 		bool* pIsRotationCompleted{};
 
-		if (pBlackboard->GetData("IsRotationCompleted", pIsRotationCompleted) == false)
+		if (pBlackboard->GetData(BB::IsRotationCompleted, pIsRotationCompleted) == false)
 		{
 			return false;
 		}
@@ -1630,10 +1757,12 @@ namespace BT_Conditions
 
 	bool HasNoWeapon(Elite::Blackboard* pBlackboard)
 	{
+		TRACE_ZONE("BT_Conditions::HasNoWeapon");
+
 
 		std::vector<std::pair<int, InventoryItemType>>* pInventory;
 
-		if (pBlackboard->GetData("Inventory", pInventory) == false || pInventory == nullptr)
+		if (pBlackboard->GetData(BB::Inventory, pInventory) == false || pInventory == nullptr)
 		{
 			return false;
 		}
@@ -0,0 +1,123 @@
+#pragma once
+#include "Extensions.h"
+#include "EntityRegistry.h"
+#include "FovBuffers.h"
+#include "ExplorationGrid.h"
+#include "EliteAI/EliteData/EBlackboard.h"
+
+class IExamInterface;
+
+class ISteeringBehavior;
+class Seek;
+class Arrive;
+class Wander;
+class Face;
+class Flee;
+class RotateClockWise;
+class AddedSteering;
+class PrioritySteering;
+
+//Dense slot of every blackboard entry of the plugin
+namespace BBSlot
+{
+	enum : unsigned int
+	{
+		Interface,
+
+		//Vectors
+		PurgeVector,
+		ItemVector,
+		EnemyFov,
+		HouseVector,
+		Grid,
+		Inventory,
+
+		//Steerings
+		CurrentSteering,
+		Wander,
+		RotateClockWise,
+		Seek,
+		Face,
+		Flee,
+		Arrive,
+		SeekAndFace,
+		WanderAndSeek,
+		FaceAndSeek,
+		FleeAndFace,
+
+		//Agent
+		AgentInfo,
+		StartOrientation,
+
+		//Booleans
+		ShouldRun,
+		IsRotating,
+		IsRotationCompleted,
+
+		//Cells
+		CurrentCell,
+		CellSize,
+
+		//Targets
+		Target,
+		TargetItem,
+		TargetHouse,
+
+		//Timers
+		Timers,
+		WalkingTimer,
+		AlertedTimer,
+
+		Count
+	};
+}
+
+//Typed blackboard keys, reading a key into a variable of another type does not compile
+namespace BB
+{
+	constexpr Elite::BlackboardKey<IExamInterface*> Interface{ BBSlot::Interface, "Interface" };
+
+	//Vectors
+	constexpr Elite::BlackboardKey<EntityRegistry<PurgeZone>*> PurgeVector{ BBSlot::PurgeVector, "PurgeVector" };
+	constexpr Elite::BlackboardKey<EntityRegistry<Item>*> ItemVector{ BBSlot::ItemVector, "ItemVector" };
+	constexpr Elite::BlackboardKey<EnemyFovBuffer*> EnemyFov{ BBSlot::EnemyFov, "EnemyFov" };
+	constexpr Elite::BlackboardKey<EntityRegistry<House>*> HouseVector{ BBSlot::HouseVector, "HouseVector" };
+	constexpr Elite::BlackboardKey<ExplorationGrid*> Grid{ BBSlot::Grid, "Grid" };
+	constexpr Elite::BlackboardKey<std::vector<std::pair<int, InventoryItemType>>*> Inventory{ BBSlot::Inventory, "Inventory" };
+
+	//Steerings
+	constexpr Elite::BlackboardKey<ISteeringBehavior*> CurrentSteering{ BBSlot::CurrentSteering, "CurrentSteering" };
+	constexpr Elite::BlackboardKey<::Wander*> Wander{ BBSlot::Wander, "Wander" };
+	constexpr Elite::BlackboardKey<::RotateClockWise*> RotateClockWise{ BBSlot::RotateClockWise, "RotateClockWise" };
+	constexpr Elite::BlackboardKey<::Seek*> Seek{ BBSlot::Seek, "Seek" };
+	constexpr Elite::BlackboardKey<::Face*> Face{ BBSlot::Face, "Face" };
+	constexpr Elite::BlackboardKey<::Flee*> Flee{ BBSlot::Flee, "Flee" };
+	constexpr Elite::BlackboardKey<::Arrive*> Arrive{ BBSlot::Arrive, "Arrive" };
+	constexpr Elite::BlackboardKey<AddedSteering*> SeekAndFace{ BBSlot::SeekAndFace, "SeekAndFace" };
+	constexpr Elite::BlackboardKey<AddedSteering*> WanderAndSeek{ BBSlot::WanderAndSeek, "WanderAndSeek" };
+	constexpr Elite::BlackboardKey<PrioritySteering*> FaceAndSeek{ BBSlot::FaceAndSeek, "FaceAndSeek" };
+	constexpr Elite::BlackboardKey<AddedSteering*> FleeAndFace{ BBSlot::FleeAndFace, "FleeAndFace" };
+
+	//Agent
+	constexpr Elite::BlackboardKey<::AgentInfo*> AgentInfo{ BBSlot::AgentInfo, "AgentInfo" };
+	constexpr Elite::BlackboardKey<float*> StartOrientation{ BBSlot::StartOrientation, "StartOrientation" };
+
+	//Booleans
+	constexpr Elite::BlackboardKey<bool*> ShouldRun{ BBSlot::ShouldRun, "ShouldRun" };
+	constexpr Elite::BlackboardKey<bool*> IsRotating{ BBSlot::IsRotating, "IsRotating" };
+	constexpr Elite::BlackboardKey<bool*> IsRotationCompleted{ BBSlot::IsRotationCompleted, "IsRotationCompleted" };
+
+	//Cells
+	constexpr Elite::BlackboardKey<int*> CurrentCell{ BBSlot::CurrentCell, "CurrentCell" };
+	constexpr Elite::BlackboardKey<float> CellSize{ BBSlot::CellSize, "CellSize" };
+
+	//Targets
+	constexpr Elite::BlackboardKey<Elite::Vector2> Target{ BBSlot::Target, "Target" };
+	constexpr Elite::BlackboardKey<Item*> TargetItem{ BBSlot::TargetItem, "TargetItem" };
+	constexpr Elite::BlackboardKey<House*> TargetHouse{ BBSlot::TargetHouse, "TargetHouse" };
+
+	//Timers
+	constexpr Elite::BlackboardKey<TimerWheel*> Timers{ BBSlot::Timers, "Timers" };
+	constexpr Elite::BlackboardKey<TimerWheel::Handle*> WalkingTimer{ BBSlot::WalkingTimer, "WalkingTimer" };
+	constexpr Elite::BlackboardKey<TimerWheel::Handle*> AlertedTimer{ BBSlot::AlertedTimer, "AlertedTimer" };
+}
@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "CombinedSteeringBehaviors.h"
+#include "Tracing.h"
 #include <algorithm>
 #include "Exam_HelperStructs.h"
 
@@ -12,6 +13,8 @@ BlendedSteering::BlendedSteering(std::vector<WeightedBehavior> weightedBehaviors
 //BLENDED STEERING
 SteeringPlugin_Output_Extension BlendedSteering::CalculateSteering(float deltaT, AgentInfo& agentInfo)
 {
+	TRACE_ZONE("BlendedSteering::CalculateSteering");
+
 	SteeringPlugin_Output_Extension blendedSteering = {};
 	auto totalWeight = 0.f;
 
@@ -39,6 +42,8 @@ SteeringPlugin_Output_Extension BlendedSteering::CalculateSteering(float deltaT,
 //PRIORITY STEERING
 SteeringPlugin_Output_Extension PrioritySteering::CalculateSteering(float deltaT, AgentInfo& agentInfo)
 {
+	TRACE_ZONE("PrioritySteering::CalculateSteering");
+
 	SteeringPlugin_Output_Extension steering = {};
 
 	for (auto pBehavior : m_PriorityBehaviors)
@@ -55,6 +60,8 @@ SteeringPlugin_Output_Extension PrioritySteering::CalculateSteering(float deltaT
 //ADDED STEERING
 SteeringPlugin_Output_Extension AddedSteering::CalculateSteering(float deltaT, AgentInfo& agentInfo)
 {
+	TRACE_ZONE("AddedSteering::CalculateSteering");
+
 	SteeringPlugin_Output_Extension steering = {};
 
 	for (auto pBehavior : m_AddedBehaviors)
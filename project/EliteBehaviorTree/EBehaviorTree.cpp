@@ -1,8 +1,72 @@
 //=== General Includes ===
 #include "stdafx.h"
 #include "EBehaviorTree.h"
+#include <chrono>
 using namespace Elite;
 
+//-----------------------------------------------------------------
+// BEHAVIOR INTERFACE (BASE)
+//-----------------------------------------------------------------
+BehaviorState IBehavior::Tick(Blackboard* pBlackBoard)
+{
+	if (!m_pProfile)
+		return Execute(pBlackBoard);
+
+	const auto start = std::chrono::steady_clock::now();
+	const BehaviorState state = Execute(pBlackBoard);
+	m_pProfile->InclusiveTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	++m_pProfile->Executions;
+	switch (state)
+	{
+	case BehaviorState::Failure:
+		++m_pProfile->Failures;
+		break;
+	case BehaviorState::Success:
+		++m_pProfile->Successes;
+		break;
+	case BehaviorState::Running:
+		++m_pProfile->Running;
+		break;
+	}
+
+	return state;
+}
+
+void IBehavior::SetProfiling(bool isEnabled)
+{
+	m_pProfile.reset(isEnabled ? new BehaviorProfile() : nullptr);
+
+	for (size_t index = 0; index < GetChildCount(); ++index)
+		GetChild(index)->SetProfiling(isEnabled);
+}
+
+void IBehavior::WriteProfile(std::ostream& stream, int depth) const
+{
+	//Exclusive time is what is left after the children took their share
+	double childTime = 0.0;
+	for (size_t index = 0; index < GetChildCount(); ++index)
+	{
+		const IBehavior* pChild = GetChild(index);
+		if (pChild->m_pProfile)
+			childTime += pChild->m_pProfile->InclusiveTime;
+	}
+
+	const BehaviorProfile profile = m_pProfile ? *m_pProfile : BehaviorProfile{};
+	const std::string label = std::string(depth * 2, ' ') + (m_Name.empty() ? std::string(GetTypeName()) : m_Name + " (" + GetTypeName() + ")");
+	const double inclusiveUs = profile.InclusiveTime * 1e6;
+
+	char line[256] = {};
+	snprintf(line, sizeof(line), "%-64s %10u %10u %10u %10u %14.1f %14.1f %12.3f\n",
+		label.c_str(), profile.Executions, profile.Successes, profile.Failures, profile.Running,
+		inclusiveUs, (profile.InclusiveTime - childTime) * 1e6,
+		profile.Executions > 0 ? inclusiveUs / profile.Executions : 0.0);
+	stream << line;
+
+	for (size_t index = 0; index < GetChildCount(); ++index)
+		GetChild(index)->WriteProfile(stream, depth + 1);
+}
+
 //-----------------------------------------------------------------
 // BEHAVIOR TREE COMPOSITES (IBehavior)
 //-----------------------------------------------------------------
@@ -15,7 +79,7 @@ BehaviorState BehaviorSelector::Execute(Blackboard* pBlackBoard)
 	for (auto& child : m_ChildBehaviors)
 	{
 		//Every Child: Execute and store the result in m_CurrentState
-		m_CurrentState = child->Execute(pBlackBoard);
+		m_CurrentState = child->Tick(pBlackBoard);
 
 		switch (m_CurrentState)
 		{
@@ -41,7 +105,7 @@ BehaviorState BehaviorSequence::Execute(Blackboard* pBlackBoard)
 	for (auto& child : m_ChildBehaviors)
 	{
 		//Every Child: Execute and store the result in m_CurrentState
-		m_CurrentState = child->Execute(pBlackBoard);
+		m_CurrentState = child->Tick(pBlackBoard);
 
 		switch (m_CurrentState)
 		{
@@ -63,7 +127,7 @@ BehaviorState BehaviorPartialSequence::Execute(Blackboard* pBlackBoard)
 {
 	while (m_CurrentBehaviorIndex < m_ChildBehaviors.size())
 	{
-		m_CurrentState = m_ChildBehaviors[m_CurrentBehaviorIndex]->Execute(pBlackBoard);
+		m_CurrentState = m_ChildBehaviors[m_CurrentBehaviorIndex]->Tick(pBlackBoard);
 		switch (m_CurrentState)
 		{
 		case BehaviorState::Failure:
@@ -112,4 +176,24 @@ BehaviorState BehaviorAction::Execute(Blackboard* pBlackBoard)
 
 	m_CurrentState = m_fpAction(pBlackBoard);
 	return m_CurrentState;
+}
+//-----------------------------------------------------------------
+// BEHAVIOR TREE (BASE)
+//-----------------------------------------------------------------
+void BehaviorTree::SetProfiling(bool isEnabled)
+{
+	if (m_pRootBehavior)
+		m_pRootBehavior->SetProfiling(isEnabled);
+}
+
+void BehaviorTree::WriteProfile(std::ostream& stream) const
+{
+	char header[256] = {};
+	snprintf(header, sizeof(header), "%-64s %10s %10s %10s %10s %14s %14s %12s\n",
+		"Node", "Executions", "Success", "Failure", "Running", "Inclusive us", "Exclusive us", "us/exec");
+
+	stream << "Behavior tree profile, " << m_NrUpdates << " updates\n" << header;
+
+	if (m_pRootBehavior)
+		m_pRootBehavior->WriteProfile(stream, 0);
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+#pragma once
+#include "Extensions.h"
+
+//Registry keys
+//Houses have no hash, their center is quantized to a quarter unit instead
+inline uint64_t GetRegistryKey(const HouseInfo& house)
+{
+	const int32_t x{ static_cast<int32_t>(std::round(house.Center.x * 4.f)) };
+	const int32_t y{ static_cast<int32_t>(std::round(house.Center.y * 4.f)) };
+	return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+inline uint64_t GetRegistryKey(const EntityInfo& entity) { return static_cast<uint32_t>(entity.EntityHash); }
+inline uint64_t GetRegistryKey(const Item& item) { return GetRegistryKey(item.entityInfo); }
+inline uint64_t GetRegistryKey(const PurgeZoneInfo& purgeZone) { return static_cast<uint32_t>(purgeZone.ZoneHash); }
+
+//Known entities of one type, in the order they were discovered
+//Lookups go through an open-addressing (linear probing) table, iteration through a contiguous vector
+//Does not own the elements, removing one hands it back to the caller
+template<typename T>
+class EntityRegistry final
+{
+public:
+	using const_iterator = typename std::vector<T*>::const_iterator;
+
+	EntityRegistry() = default;
+	~EntityRegistry() = default;
+
+	EntityRegistry(const EntityRegistry& other) = delete;
+	EntityRegistry& operator=(const EntityRegistry& other) = delete;
+	EntityRegistry(EntityRegistry&& other) = delete;
+	EntityRegistry& operator=(EntityRegistry&& other) = delete;
+
+	//O(1), nullptr when the key is unknown
+	T* Find(uint64_t key) const
+	{
+		if (m_Slots.empty()) return nullptr;
+
+		for (size_t idx{ GetHomeSlot(key) };; idx = (idx + 1) & m_Mask)
+		{
+			const Slot& slot{ m_Slots[idx] };
+			if (slot.pElement == nullptr && !slot.IsTombstone) return nullptr;
+			if (slot.pElement != nullptr && slot.Key == key) return slot.pElement;
+		}
+	}
+
+	//O(1) amortized, fails when an element with the same key is already known
+	bool Add(T* pElement)
+	{
+		const uint64_t key{ GetRegistryKey(*pElement) };
+		if (Find(key) != nullptr) return false;
+
+		if ((m_NrUsedSlots + 1) * 4 > m_Slots.size() * 3)
+			Rehash();
+
+		size_t idx{ GetHomeSlot(key) };
+		while (m_Slots[idx].pElement != nullptr)
+			idx = (idx + 1) & m_Mask;
+
+		if (!m_Slots[idx].IsTombstone) ++m_NrUsedSlots;
+		m_Slots[idx] = Slot{ key, pElement, false };
+
+		m_pElements.push_back(pElement);
+		return true;
+	}
+
+	//Lookup is O(1), keeping the discovery order makes the erase from the vector O(n)
+	bool Remove(T* pElement)
+	{
+		if (!EraseKey(GetRegistryKey(*pElement), pElement)) return false;
+
+		m_pElements.erase(std::find(m_pElements.begin(), m_pElements.end(), pElement));
+		return true;
+	}
+
+	//Iteration in discovery order
+	const std::vector<T*>& GetElements() const { return m_pElements; }
+	const_iterator begin() const { return m_pElements.begin(); }
+	const_iterator end() const { return m_pElements.end(); }
+	size_t size() const { return m_pElements.size(); }
+	bool empty() const { return m_pElements.empty(); }
+
+private:
+	struct Slot
+	{
+		uint64_t Key{};
+		T* pElement{ nullptr };
+		bool IsTombstone{ false };
+	};
+
+	std::vector<Slot> m_Slots{};
+	size_t m_Mask{};
+	size_t m_NrUsedSlots{}; //Elements and tombstones, both lengthen the probe sequences
+
+	std::vector<T*> m_pElements{};
+
+	size_t GetHomeSlot(uint64_t key) const
+	{
+		//splitmix64 finalizer, hashes and quantized coordinates are far from uniform
+		key ^= key >> 30;
+		key *= 0xbf58476d1ce4e5b9ull;
+		key ^= key >> 27;
+		key *= 0x94d049bb133111ebull;
+		key ^= key >> 31;
+		return static_cast<size_t>(key) & m_Mask;
+	}
+
+	bool EraseKey(uint64_t key, const T* pElement)
+	{
+		if (m_Slots.empty()) return false;
+
+		for (size_t idx{ GetHomeSlot(key) };; idx = (idx + 1) & m_Mask)
+		{
+			Slot& slot{ m_Slots[idx] };
+			if (slot.pElement == nullptr && !slot.IsTombstone) return false;
+			if (slot.pElement == pElement)
+			{
+				slot = Slot{ 0, nullptr, true };
+				return true;
+			}
+		}
+	}
+
+	void Rehash()
+	{
+		//Sized for the live elements only, so a table full of tombstones is cleaned up instead of grown
+		size_t nrSlots{ 16 };
+		while ((m_pElements.size() + 1) * 2 > nrSlots)
+			nrSlots *= 2;
+
+		m_Slots.assign(nrSlots, Slot{});
+		m_Mask = nrSlots - 1;
+		m_NrUsedSlots = m_pElements.size();
+
+		for (T* pElement : m_pElements)
+		{
+			const uint64_t key{ GetRegistryKey(*pElement) };
+			size_t idx{ GetHomeSlot(key) };
+			while (m_Slots[idx].pElement != nullptr)
+				idx = (idx + 1) & m_Mask;
+			m_Slots[idx] = Slot{ key, pElement, false };
+		}
+	}
+};
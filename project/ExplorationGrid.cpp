@@ -0,0 +1,360 @@
+#include "stdafx.h"
+#include "ExplorationGrid.h"
+
+static_assert(ExplorationGrid::NrLayers <= InfluenceKernels::WeightedSumArguments::MaxNrPlanes, "The score kernel cannot combine all layers");
+
+ExplorationGrid::ExplorationGrid(const WorldInfo& world, int nrColumns)
+	: m_Origin{ world.Center - world.Dimensions / 2.f }
+	, m_CellSize{ world.Dimensions.x / (std::max)(nrColumns, 1) }
+	, m_NrColumns{ (std::max)(nrColumns, 1) }
+	//Rounded up so the rows never stop short of the world height, the tolerance keeps an exact fit from getting an extra row
+	, m_NrRows{ (std::max)(static_cast<int>(std::ceil(world.Dimensions.y / m_CellSize - 1e-4f)), 1) }
+{
+	const size_t nrCells{ static_cast<size_t>(m_NrColumns) * m_NrRows };
+	m_PositionsX.resize(nrCells);
+	m_PositionsY.resize(nrCells);
+	for (std::vector<float>& layer : m_Layers)
+	{
+		layer.resize(nrCells, 0.f);
+	}
+	m_Layers[static_cast<int>(eInfluenceLayer::Fog)].assign(nrCells, 1.f);
+	m_Score.resize(nrCells, 0.f);
+	m_IsVisited.resize(nrCells, 0);
+	m_IsCellDirty.resize(nrCells, 0);
+	m_Seen.Initialize(m_Origin, m_CellSize, m_NrColumns, m_NrRows);
+	m_Frontier.Initialize(m_NrColumns, m_NrRows, FrontierBucketSize);
+	m_NrUnvisitedNeighbors.resize(nrCells);
+
+	m_BestCells.Reset(static_cast<int>(nrCells));
+
+	for (int x{}; x < m_NrColumns; ++x)
+	{
+		for (int y{}; y < m_NrRows; ++y)
+		{
+			const int index{ GetIndex(x, y) };
+			m_PositionsX[index] = m_Origin.x + x * m_CellSize;
+			m_PositionsY[index] = m_Origin.y + y * m_CellSize;
+
+			NeighborArray neighbors{};
+			m_NrUnvisitedNeighbors[index] = static_cast<uint8_t>(GetNeighbors(index, neighbors));
+		}
+	}
+
+	SetInstructionSet(InfluenceKernels::GetSupportedInstructionSet());
+	UpdateScore();
+}
+
+void ExplorationGrid::SetVisited(int index, bool isVisited)
+{
+	if (IsVisited(index) != isVisited)
+	{
+		m_IsVisited[index] = isVisited ? 1 : 0;
+		m_Seen.SetSeen(index, isVisited);
+
+		NeighborArray neighbors{};
+		const int nrNeighbors{ GetNeighbors(index, neighbors) };
+		for (int idx{}; idx < nrNeighbors; ++idx)
+		{
+			m_NrUnvisitedNeighbors[neighbors[idx]] += isVisited ? -1 : 1;
+			UpdateFrontier(neighbors[idx]);
+		}
+		UpdateFrontier(index);
+	}
+
+	//Only the score of this cell changes with the fog, unless the whole score is recombined anyway
+	float& fog{ m_Layers[static_cast<int>(eInfluenceLayer::Fog)][index] };
+	const float newFog{ isVisited ? 0.f : 1.f };
+	if (fog != newFog)
+	{
+		fog = newFog;
+		if (!m_IsScoreDirty) m_Score[index] = CalculateScore(index);
+	}
+
+	if (isVisited)
+	{
+		m_BestCells.Remove(index);
+		return;
+	}
+
+	UpdateCellHeaps(index);
+}
+
+int ExplorationGrid::StampViewCone(const Elite::Vector2& apex, float orientation, float fovAngle, float range)
+{
+	m_NewlySeenCells.clear();
+	m_Seen.StampViewCone(apex, orientation, fovAngle, range, m_NewlySeenCells);
+
+	for (int index : m_NewlySeenCells)
+	{
+		SetVisited(index, true);
+	}
+
+	return static_cast<int>(m_NewlySeenCells.size());
+}
+
+int ExplorationGrid::GetNearestFrontierCell(const Elite::Vector2& position) const
+{
+	return m_Frontier.FindNearest((position.x - m_Origin.x) / m_CellSize, (position.y - m_Origin.y) / m_CellSize);
+}
+
+int ExplorationGrid::GetCellIndex(const Elite::Vector2& position) const
+{
+	const float halfSide{ m_CellSize / 2.f };
+
+	const int column{ static_cast<int>(std::floor((position.x - m_Origin.x) / m_CellSize + 0.5f)) };
+	const int row{ static_cast<int>(std::floor((position.y - m_Origin.y) / m_CellSize + 0.5f)) };
+
+	//A position on the border between cells belongs to the one with the lowest index,
+	//the candidates around the rounded cell are checked with the same test a full scan would use
+	for (int x{ (std::max)(column - 1, 0) }; x <= (std::min)(column + 1, m_NrColumns - 1); ++x)
+	{
+		for (int y{ (std::max)(row - 1, 0) }; y <= (std::min)(row + 1, m_NrRows - 1); ++y)
+		{
+			const int index{ GetIndex(x, y) };
+
+			if (std::abs(position.x - m_PositionsX[index]) <= halfSide && std::abs(position.y - m_PositionsY[index]) <= halfSide)
+			{
+				return index;
+			}
+		}
+	}
+
+	return -1;
+}
+
+int ExplorationGrid::GetNeighbors(int index, NeighborArray& neighbors) const
+{
+	const int column{ GetColumn(index) };
+	const int row{ GetRow(index) };
+
+	int nrNeighbors{};
+	for (int x{ (std::max)(column - 1, 0) }; x <= (std::min)(column + 1, m_NrColumns - 1); ++x)
+	{
+		for (int y{ (std::max)(row - 1, 0) }; y <= (std::min)(row + 1, m_NrRows - 1); ++y)
+		{
+			if (x == column && y == row) continue;
+
+			neighbors[nrNeighbors++] = GetIndex(x, y);
+		}
+	}
+
+	return nrNeighbors;
+}
+
+void ExplorationGrid::AddInfluence(const Elite::Vector2& source, float weight)
+{
+	std::vector<float>& influence{ m_Layers[static_cast<int>(eInfluenceLayer::House)] };
+
+	InfluenceKernels::InverseCubeArguments arguments{};
+	arguments.SourceX = source.x;
+	arguments.SourceY = source.y;
+	arguments.CellSize = m_CellSize;
+	arguments.Weight = weight;
+	arguments.MaxNrCells = m_InfluenceRadius;
+
+	if (m_InfluenceRadius <= 0.f)
+	{
+		m_IsScoreDirty = true;
+
+		arguments.pPositionsX = m_PositionsX.data();
+		arguments.pPositionsY = m_PositionsY.data();
+		arguments.pInfluence = influence.data();
+		arguments.Count = GetNrCells();
+		m_pAddInverseCube(arguments);
+		return;
+	}
+
+	//Truncated, every column of the bounding square is one contiguous run of rows
+	const float column{ (source.x - m_Origin.x) / m_CellSize };
+	const float row{ (source.y - m_Origin.y) / m_CellSize };
+
+	const int firstColumn{ (std::max)(0, static_cast<int>(std::ceil(column - m_InfluenceRadius))) };
+	const int lastColumn{ (std::min)(m_NrColumns - 1, static_cast<int>(std::floor(column + m_InfluenceRadius))) };
+	const int firstRow{ (std::max)(0, static_cast<int>(std::ceil(row - m_InfluenceRadius))) };
+	const int lastRow{ (std::min)(m_NrRows - 1, static_cast<int>(std::floor(row + m_InfluenceRadius))) };
+	if (firstRow > lastRow) return;
+
+	for (int x{ firstColumn }; x <= lastColumn; ++x)
+	{
+		const int first{ GetIndex(x, firstRow) };
+		arguments.pPositionsX = m_PositionsX.data() + first;
+		arguments.pPositionsY = m_PositionsY.data() + first;
+		arguments.pInfluence = influence.data() + first;
+		arguments.Count = lastRow - firstRow + 1;
+		m_pAddInverseCube(arguments);
+
+		for (int index{ first }; index < first + arguments.Count; ++index)
+		{
+			MarkCellDirty(index);
+		}
+	}
+}
+
+void ExplorationGrid::AddDisc(eInfluenceLayer layer, const Elite::Vector2& center, float radius, float amount)
+{
+	if (radius <= 0.f) return;
+
+	std::vector<float>& values{ m_Layers[static_cast<int>(layer)] };
+
+	const float nrCells{ radius / m_CellSize };
+	const float column{ (center.x - m_Origin.x) / m_CellSize };
+	const float row{ (center.y - m_Origin.y) / m_CellSize };
+
+	const int firstColumn{ (std::max)(0, static_cast<int>(std::ceil(column - nrCells))) };
+	const int lastColumn{ (std::min)(m_NrColumns - 1, static_cast<int>(std::floor(column + nrCells))) };
+	const int firstRow{ (std::max)(0, static_cast<int>(std::ceil(row - nrCells))) };
+	const int lastRow{ (std::min)(m_NrRows - 1, static_cast<int>(std::floor(row + nrCells))) };
+
+	for (int x{ firstColumn }; x <= lastColumn; ++x)
+	{
+		for (int y{ firstRow }; y <= lastRow; ++y)
+		{
+			const int index{ GetIndex(x, y) };
+			const float dx{ center.x - m_PositionsX[index] };
+			const float dy{ center.y - m_PositionsY[index] };
+			const float distance{ sqrtf(dx * dx + dy * dy) };
+			if (distance >= radius) continue;
+
+			values[index] += amount * (1.f - distance / radius);
+			MarkCellDirty(index);
+		}
+	}
+}
+
+void ExplorationGrid::ScaleLayer(eInfluenceLayer layer, float factor)
+{
+	std::vector<float>& values{ m_Layers[static_cast<int>(layer)] };
+
+	//A decaying layer is mostly zero, only the cells that hold a value change
+	for (int index{}; index < GetNrCells(); ++index)
+	{
+		if (values[index] == 0.f) continue;
+
+		values[index] *= factor;
+		MarkCellDirty(index);
+	}
+}
+
+void ExplorationGrid::ClearLayer(eInfluenceLayer layer)
+{
+	std::vector<float>& values{ m_Layers[static_cast<int>(layer)] };
+
+	//The fog always follows the visited cells
+	if (layer == eInfluenceLayer::Fog)
+	{
+		m_IsScoreDirty = true;
+
+		for (size_t index{}; index < values.size(); ++index)
+		{
+			values[index] = m_IsVisited[index] ? 0.f : 1.f;
+		}
+		return;
+	}
+
+	for (int index{}; index < GetNrCells(); ++index)
+	{
+		if (values[index] == 0.f) continue;
+
+		values[index] = 0.f;
+		MarkCellDirty(index);
+	}
+}
+
+void ExplorationGrid::SetLayerWeight(eInfluenceLayer layer, float weight)
+{
+	float& layerWeight{ m_LayerWeights[static_cast<int>(layer)] };
+	if (layerWeight == weight) return;
+
+	layerWeight = weight;
+	m_IsScoreDirty = true;
+}
+
+void ExplorationGrid::UpdateScore()
+{
+	//A few changed cells are cheaper one by one, a house without influence radius changes every cell
+	if (m_DirtyCells.size() * 8 >= static_cast<size_t>(GetNrCells())) m_IsScoreDirty = true;
+
+	if (!m_IsScoreDirty)
+	{
+		for (int index : m_DirtyCells)
+		{
+			m_IsCellDirty[index] = 0;
+			m_Score[index] = CalculateScore(index);
+
+			if (!m_IsVisited[index]) UpdateCellHeaps(index);
+		}
+		m_DirtyCells.clear();
+		return;
+	}
+
+	InfluenceKernels::WeightedSumArguments arguments{};
+	arguments.NrPlanes = NrLayers;
+	for (int layer{}; layer < NrLayers; ++layer)
+	{
+		arguments.pPlanes[layer] = m_Layers[layer].data();
+		arguments.Weights[layer] = m_LayerWeights[layer];
+	}
+	arguments.pOutput = m_Score.data();
+	arguments.Count = GetNrCells();
+
+	m_pWeightedSum(arguments);
+	m_IsScoreDirty = false;
+
+	for (int index : m_DirtyCells)
+	{
+		m_IsCellDirty[index] = 0;
+	}
+	m_DirtyCells.clear();
+
+	RebuildCellHeaps();
+}
+
+float ExplorationGrid::CalculateScore(int index) const
+{
+	float score{ m_LayerWeights[0] * m_Layers[0][index] };
+	for (int layer{ 1 }; layer < NrLayers; ++layer)
+	{
+		score += m_LayerWeights[layer] * m_Layers[layer][index];
+	}
+
+	return score;
+}
+
+void ExplorationGrid::MarkCellDirty(int index)
+{
+	if (m_IsScoreDirty || m_IsCellDirty[index]) return;
+
+	m_IsCellDirty[index] = 1;
+	m_DirtyCells.push_back(index);
+}
+
+void ExplorationGrid::UpdateCellHeaps(int index)
+{
+	m_BestCells.Set(index, m_Score[index]);
+}
+
+void ExplorationGrid::RebuildCellHeaps()
+{
+	m_RebuiltCells.clear();
+	for (int index{}; index < GetNrCells(); ++index)
+	{
+		if (m_IsVisited[index]) continue;
+
+		m_RebuiltCells.push_back(index);
+		m_BestCells.SetKeyUnordered(index, m_Score[index]);
+	}
+	m_BestCells.Assign(m_RebuiltCells.begin(), m_RebuiltCells.end());
+}
+
+void ExplorationGrid::UpdateFrontier(int index)
+{
+	if (m_IsVisited[index] && m_NrUnvisitedNeighbors[index] > 0) m_Frontier.Insert(index);
+	else m_Frontier.Remove(index);
+}
+
+void ExplorationGrid::SetInstructionSet(InfluenceKernels::eInstructionSet instructionSet)
+{
+	m_pAddInverseCube = InfluenceKernels::GetInverseCubeKernel(instructionSet);
+	m_pWeightedSum = InfluenceKernels::GetWeightedSumKernel(instructionSet);
+	m_InstructionSet = (std::min)(instructionSet, InfluenceKernels::GetSupportedInstructionSet());
+}
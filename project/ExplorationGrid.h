@@ -0,0 +1,145 @@
+#pragma once
+#include "Extensions.h"
+#include "InfluenceKernels.h"
+#include "FrontierSet.h"
+#include "IndexedMaxHeap.h"
+#include "SeenMap.h"
+
+//Influence layers, combined with a weight per layer into the score of a cell
+enum class eInfluenceLayer
+{
+	House, //Attraction of the known houses
+	Threat, //Decaying enemy sightings
+	PurgeDanger, //Known purge zones
+	Fog, //1 for unvisited cells, 0 for visited ones
+	Count
+};
+
+//Dense grid of exploration cells over the world
+//Cells are stored column by column (index = column * nrRows + row), every property in its own plane
+//Cell positions are cell centers, the first one sits on the bottom left corner of the world
+class ExplorationGrid final
+{
+public:
+	static constexpr int MaxNeighbors{ 8 };
+	using NeighborArray = int[MaxNeighbors];
+
+	static constexpr int NrLayers{ static_cast<int>(eInfluenceLayer::Count) };
+
+	//The cell size follows from the number of columns, rows are added until the world height is covered
+	ExplorationGrid(const WorldInfo& world, int nrColumns);
+	~ExplorationGrid() = default;
+
+	ExplorationGrid(const ExplorationGrid& other) = delete;
+	ExplorationGrid& operator=(const ExplorationGrid& other) = delete;
+	ExplorationGrid(ExplorationGrid&& other) = delete;
+	ExplorationGrid& operator=(ExplorationGrid&& other) = delete;
+
+	int GetNrColumns() const { return m_NrColumns; }
+	int GetNrRows() const { return m_NrRows; }
+	int GetNrCells() const { return static_cast<int>(m_PositionsX.size()); }
+	float GetCellSize() const { return m_CellSize; }
+
+	int GetIndex(int column, int row) const { return column * m_NrRows + row; }
+	int GetColumn(int index) const { return index / m_NrRows; }
+	int GetRow(int index) const { return index % m_NrRows; }
+
+	//Cells
+	Elite::Vector2 GetPosition(int index) const { return Elite::Vector2{ m_PositionsX[index], m_PositionsY[index] }; }
+	float GetInfluence(int index) const { return m_Layers[static_cast<int>(eInfluenceLayer::House)][index]; }
+	float GetLayer(eInfluenceLayer layer, int index) const { return m_Layers[static_cast<int>(layer)][index]; }
+	float GetScore(int index) const { return m_Score[index]; }
+	bool IsVisited(int index) const { return m_IsVisited[index] != 0; }
+	void SetVisited(int index, bool isVisited);
+
+	//Marks every cell whose center lies inside the view cone as visited, returns how many were not visited yet
+	int StampViewCone(const Elite::Vector2& apex, float orientation, float fovAngle, float range);
+
+	//Visited cells as one bit per cell, for coverage queries
+	const SeenMap& GetSeenMap() const { return m_Seen; }
+
+	//Frontier: visited cells next to at least one unvisited cell, kept up to date by SetVisited
+	int GetNrFrontierCells() const { return m_Frontier.GetNrCells(); }
+	bool IsFrontier(int index) const { return m_Frontier.Contains(index); }
+	//Frontier cell closest to the position, the lowest index on ties, -1 when there is none
+	int GetNearestFrontierCell(const Elite::Vector2& position) const;
+
+	//O(1), index of the first cell (in index order) whose square contains the position, -1 when outside the grid
+	int GetCellIndex(const Elite::Vector2& position) const;
+
+	//Indices of the up to 8 surrounding cells in ascending order, returns how many there are
+	int GetNeighbors(int index, NeighborArray& neighbors) const;
+
+	//House layer: adds weight / (distance in cells)^3 to every cell within the influence radius of the source
+	//A negative weight takes the contribution of a source away again
+	void AddInfluence(const Elite::Vector2& source, float weight);
+	void ClearInfluence() { ClearLayer(eInfluenceLayer::House); }
+
+	//Adds amount * (1 - distance / radius) to every cell closer than radius to the center
+	void AddDisc(eInfluenceLayer layer, const Elite::Vector2& center, float radius, float amount);
+	void ScaleLayer(eInfluenceLayer layer, float factor);
+	void ClearLayer(eInfluenceLayer layer);
+
+	//Score = sum of weight * layer in layer order, by default the house layer only
+	void SetLayerWeight(eInfluenceLayer layer, float weight);
+	float GetLayerWeight(eInfluenceLayer layer) const { return m_LayerWeights[static_cast<int>(layer)]; }
+
+	//Recombines the layers of the cells that changed since the last call and moves only those in the heaps,
+	//in one pass over the grid when a change touched every cell or more than an eighth of them changed
+	void UpdateScore();
+
+	//O(1), follows the scores of the last UpdateScore, -1 when there is no such cell
+	//Unvisited cell with the highest score, the highest index on ties
+	int GetBestUnvisitedCell() const { return m_BestCells.GetTop(); }
+
+	//Radius in cells, 0 leaves the kernel untruncated so it touches every cell
+	void SetInfluenceRadius(float nrCells) { m_InfluenceRadius = (std::max)(nrCells, 0.f); }
+	float GetInfluenceRadius() const { return m_InfluenceRadius; }
+
+	//Defaults to the best one the CPU supports
+	void SetInstructionSet(InfluenceKernels::eInstructionSet instructionSet);
+	InfluenceKernels::eInstructionSet GetInstructionSet() const { return m_InstructionSet; }
+
+private:
+	Elite::Vector2 m_Origin{};
+	float m_CellSize{};
+	int m_NrColumns{};
+	int m_NrRows{};
+	float m_InfluenceRadius{};
+
+	InfluenceKernels::eInstructionSet m_InstructionSet{};
+	InfluenceKernels::InverseCubeKernel m_pAddInverseCube{};
+	InfluenceKernels::WeightedSumKernel m_pWeightedSum{};
+
+	float m_LayerWeights[NrLayers]{ 1.f };
+
+	//Every score is recombined when set, otherwise only the cells in the dirty list
+	bool m_IsScoreDirty{ true };
+	std::vector<int> m_DirtyCells{};
+	std::vector<uint8_t> m_IsCellDirty{};
+
+	//Planes
+	std::vector<float> m_PositionsX{};
+	std::vector<float> m_PositionsY{};
+	std::vector<float> m_Layers[NrLayers]{};
+	std::vector<float> m_Score{};
+	std::vector<uint8_t> m_IsVisited{};
+	SeenMap m_Seen{};
+	std::vector<int> m_NewlySeenCells{};
+
+	//Frontier cells in buckets of FrontierBucketSize x FrontierBucketSize cells
+	static constexpr int FrontierBucketSize{ 8 };
+	FrontierSet m_Frontier{};
+	std::vector<uint8_t> m_NrUnvisitedNeighbors{};
+
+	//Unvisited cells by score
+	IndexedMaxHeap<float> m_BestCells{};
+	std::vector<int> m_RebuiltCells{};
+
+	//Same operation order as the score kernel, so both give the same result
+	float CalculateScore(int index) const;
+	void MarkCellDirty(int index);
+	void UpdateCellHeaps(int index);
+	void RebuildCellHeaps();
+	void UpdateFrontier(int index);
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include "Exam_HelperStructs.h"
 #include "stdafx.h"
+#include "TimerWheel.h"
 
 //Extension
 struct SearchPoint
@@ -9,16 +10,15 @@ struct SearchPoint
 	bool IsVisited{ false };
 };
 
-struct GridElement : public SearchPoint
-{
-	float Influence{};
-	std::vector<GridElement*> pNeighbors{};
-};
+struct Item;
 
 struct House : public HouseInfo
 {
+	static constexpr float RevisitTime{ 350.f }; //Seconds after a visit before the house is searched again
+
 	std::vector<SearchPoint*> pSearchPoints{};
-	float TimeSinceVisit{};
+	std::vector<Item*> pItems{}; //Known items inside the house that were not picked up
+	TimerWheel::Handle RevisitTimer{};
 	bool IsVisited{ false };
 };
 
@@ -32,7 +32,7 @@ struct Item
 
 struct PurgeZone: public PurgeZoneInfo
 {
-	float EstimatedLifeTime{};
+	static constexpr float EstimatedLifeTime{ 4.5f }; //Seconds the zone is avoided after it was first seen
 };
 
 struct SteeringPlugin_Output_Extension : SteeringPlugin_Output
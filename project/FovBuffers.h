@@ -0,0 +1,164 @@
+#pragma once
+#include "Extensions.h"
+
+//Field of view of the current tick, split per type into structure-of-arrays buffers
+//Clear keeps the capacity, so once the buffers have grown a tick does not allocate
+struct HouseFovBuffer
+{
+	std::vector<Elite::Vector2> Centers{};
+	std::vector<Elite::Vector2> Sizes{};
+
+	size_t size() const { return Centers.size(); }
+	bool empty() const { return Centers.empty(); }
+
+	void Clear()
+	{
+		Centers.clear();
+		Sizes.clear();
+	}
+
+	void Add(const HouseInfo& house)
+	{
+		Centers.push_back(house.Center);
+		Sizes.push_back(house.Size);
+	}
+
+	HouseInfo Get(size_t idx) const
+	{
+		HouseInfo house{};
+		house.Center = Centers[idx];
+		house.Size = Sizes[idx];
+		return house;
+	}
+};
+
+struct EnemyFovBuffer
+{
+	std::vector<eEnemyType> Types{};
+	std::vector<Elite::Vector2> Locations{};
+	std::vector<Elite::Vector2> LinearVelocities{};
+	std::vector<int> Hashes{};
+	std::vector<float> Sizes{};
+	std::vector<float> Healths{};
+
+	size_t size() const { return Locations.size(); }
+	bool empty() const { return Locations.empty(); }
+
+	void Clear()
+	{
+		Types.clear();
+		Locations.clear();
+		LinearVelocities.clear();
+		Hashes.clear();
+		Sizes.clear();
+		Healths.clear();
+	}
+
+	void Add(const EnemyInfo& enemy)
+	{
+		Types.push_back(enemy.Type);
+		Locations.push_back(enemy.Location);
+		LinearVelocities.push_back(enemy.LinearVelocity);
+		Hashes.push_back(enemy.EnemyHash);
+		Sizes.push_back(enemy.Size);
+		Healths.push_back(enemy.Health);
+	}
+};
+
+struct ItemFovBuffer
+{
+	std::vector<Elite::Vector2> Locations{};
+	std::vector<int> EntityHashes{};
+	std::vector<int> ItemHashes{};
+	std::vector<eItemType> Types{};
+
+	size_t size() const { return Locations.size(); }
+	bool empty() const { return Locations.empty(); }
+
+	void Clear()
+	{
+		Locations.clear();
+		EntityHashes.clear();
+		ItemHashes.clear();
+		Types.clear();
+	}
+
+	void Add(const EntityInfo& entity, const ItemInfo& item)
+	{
+		Locations.push_back(entity.Location);
+		EntityHashes.push_back(entity.EntityHash);
+		ItemHashes.push_back(item.ItemHash);
+		Types.push_back(item.Type);
+	}
+
+	EntityInfo GetEntity(size_t idx) const
+	{
+		EntityInfo entity{};
+		entity.Type = eEntityType::ITEM;
+		entity.Location = Locations[idx];
+		entity.EntityHash = EntityHashes[idx];
+		return entity;
+	}
+
+	ItemInfo GetItem(size_t idx) const
+	{
+		ItemInfo item{};
+		item.Type = Types[idx];
+		item.Location = Locations[idx];
+		item.ItemHash = ItemHashes[idx];
+		return item;
+	}
+};
+
+struct PurgeZoneFovBuffer
+{
+	std::vector<Elite::Vector2> Centers{};
+	std::vector<float> Radii{};
+	std::vector<int> Hashes{};
+
+	size_t size() const { return Centers.size(); }
+	bool empty() const { return Centers.empty(); }
+
+	void Clear()
+	{
+		Centers.clear();
+		Radii.clear();
+		Hashes.clear();
+	}
+
+	void Add(const PurgeZoneInfo& purgeZone)
+	{
+		Centers.push_back(purgeZone.Center);
+		Radii.push_back(purgeZone.Radius);
+		Hashes.push_back(purgeZone.ZoneHash);
+	}
+
+	PurgeZoneInfo Get(size_t idx) const
+	{
+		PurgeZoneInfo purgeZone{};
+		purgeZone.Center = Centers[idx];
+		purgeZone.Radius = Radii[idx];
+		purgeZone.ZoneHash = Hashes[idx];
+		return purgeZone;
+	}
+};
+
+struct FovBuffers
+{
+	//Raw entities as returned by Fov_GetEntityByIndex, before they are classified
+	std::vector<EntityInfo> Entities{};
+
+	HouseFovBuffer Houses{};
+	EnemyFovBuffer Enemies{};
+	ItemFovBuffer Items{};
+	PurgeZoneFovBuffer PurgeZones{};
+
+	void Clear()
+	{
+		Entities.clear();
+		Houses.Clear();
+		Enemies.Clear();
+		Items.Clear();
+		PurgeZones.Clear();
+	}
+};
@@ -0,0 +1,108 @@
+#include "stdafx.h"
+#include "FrontierSet.h"
+
+void FrontierSet::Initialize(int nrColumns, int nrRows, int bucketSize)
+{
+	m_NrColumns = nrColumns;
+	m_NrRows = nrRows;
+	m_BucketSize = (std::max)(bucketSize, 1);
+	m_NrBucketColumns = (nrColumns + m_BucketSize - 1) / m_BucketSize;
+	m_NrBucketRows = (nrRows + m_BucketSize - 1) / m_BucketSize;
+	m_NrCells = 0;
+
+	m_Positions.assign(static_cast<size_t>(nrColumns) * nrRows, -1);
+	m_Buckets.assign(static_cast<size_t>(m_NrBucketColumns) * m_NrBucketRows, std::vector<int>{});
+}
+
+void FrontierSet::Insert(int index)
+{
+	if (Contains(index)) return;
+
+	std::vector<int>& bucket{ m_Buckets[GetBucket(index)] };
+	m_Positions[index] = static_cast<int>(bucket.size());
+	bucket.push_back(index);
+	++m_NrCells;
+}
+
+void FrontierSet::Remove(int index)
+{
+	if (!Contains(index)) return;
+
+	//The last cell of the bucket takes the place of the removed one
+	std::vector<int>& bucket{ m_Buckets[GetBucket(index)] };
+	const int lastIndex{ bucket.back() };
+
+	bucket[m_Positions[index]] = lastIndex;
+	m_Positions[lastIndex] = m_Positions[index];
+	bucket.pop_back();
+
+	m_Positions[index] = -1;
+	--m_NrCells;
+}
+
+int FrontierSet::FindNearest(float column, float row) const
+{
+	if (m_NrCells == 0) return -1;
+
+	const int bucketColumn{ Elite::Clamp(static_cast<int>(std::floor(column / m_BucketSize)), 0, m_NrBucketColumns - 1) };
+	const int bucketRow{ Elite::Clamp(static_cast<int>(std::floor(row / m_BucketSize)), 0, m_NrBucketRows - 1) };
+	const int maxRing{ (std::max)((std::max)(bucketColumn, m_NrBucketColumns - 1 - bucketColumn), (std::max)(bucketRow, m_NrBucketRows - 1 - bucketRow)) };
+
+	int nearestIndex{ -1 };
+	float nearestDistanceSquared{};
+
+	auto searchBucket = [&](int x, int y)
+	{
+		if (x < 0 || x >= m_NrBucketColumns || y < 0 || y >= m_NrBucketRows) return;
+
+		for (int index : m_Buckets[x * m_NrBucketRows + y])
+		{
+			const float distanceX{ index / m_NrRows - column };
+			const float distanceY{ index % m_NrRows - row };
+			const float distanceSquared{ distanceX * distanceX + distanceY * distanceY };
+
+			if (nearestIndex < 0 || distanceSquared < nearestDistanceSquared || (distanceSquared == nearestDistanceSquared && index < nearestIndex))
+			{
+				nearestIndex = index;
+				nearestDistanceSquared = distanceSquared;
+			}
+		}
+	};
+
+	for (int ring{}; ring <= maxRing; ++ring)
+	{
+		//Every cell in this ring is more than ring - 1 buckets away
+		if (nearestIndex >= 0)
+		{
+			const float ringDistance{ static_cast<float>((ring - 1) * m_BucketSize) };
+			if (ringDistance * ringDistance > nearestDistanceSquared) break;
+		}
+
+		if (ring == 0)
+		{
+			searchBucket(bucketColumn, bucketRow);
+			continue;
+		}
+
+		for (int x{ bucketColumn - ring }; x <= bucketColumn + ring; ++x)
+		{
+			searchBucket(x, bucketRow - ring);
+			searchBucket(x, bucketRow + ring);
+		}
+		for (int y{ bucketRow - ring + 1 }; y < bucketRow + ring; ++y)
+		{
+			searchBucket(bucketColumn - ring, y);
+			searchBucket(bucketColumn + ring, y);
+		}
+	}
+
+	return nearestIndex;
+}
+
+int FrontierSet::GetBucket(int index) const
+{
+	const int column{ index / m_NrRows };
+	const int row{ index % m_NrRows };
+
+	return (column / m_BucketSize) * m_NrBucketRows + row / m_BucketSize;
+}
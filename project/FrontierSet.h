@@ -0,0 +1,42 @@
+#pragma once
+
+//Set of grid cells sorted into square buckets of cells, for nearest cell queries
+//Every cell knows its position in the cell list of its bucket, so adding and removing a cell is O(1)
+class FrontierSet final
+{
+public:
+	FrontierSet() = default;
+	~FrontierSet() = default;
+
+	FrontierSet(const FrontierSet& other) = delete;
+	FrontierSet& operator=(const FrontierSet& other) = delete;
+	FrontierSet(FrontierSet&& other) = delete;
+	FrontierSet& operator=(FrontierSet&& other) = delete;
+
+	//Empties the set, cells use the grid index (index = column * nrRows + row)
+	void Initialize(int nrColumns, int nrRows, int bucketSize);
+
+	bool Contains(int index) const { return m_Positions[index] >= 0; }
+	int GetNrCells() const { return m_NrCells; }
+
+	//O(1), inserting a cell that is already in the set or removing one that is not does nothing
+	void Insert(int index);
+	void Remove(int index);
+
+	//Cell closest to the given cell coordinates, the lowest index on ties, -1 when the set is empty
+	//Only the buckets that can still hold a closer cell than the best one so far are searched
+	int FindNearest(float column, float row) const;
+
+private:
+	int m_NrColumns{};
+	int m_NrRows{};
+	int m_BucketSize{ 1 };
+	int m_NrBucketColumns{};
+	int m_NrBucketRows{};
+	int m_NrCells{};
+
+	std::vector<int> m_Positions{}; //Per cell, -1 when it is not in the set
+	std::vector<std::vector<int>> m_Buckets{};
+
+	int GetBucket(int index) const;
+};
@@ -0,0 +1,267 @@
+#include "stdafx.h"
+#include "EliteAI/EliteGraphs/EGridGraph.h"
+#include "EliteAI/EliteGraphs/EliteGraphAlgorithms/EAStar.h"
+#include "HeadlessBenchmark.h"
+
+#include <chrono>
+
+//Usage: AStarBenchmark [--sides 64,256,1024] [--queries 50] [--heuristic octile|euclidean|manhattan] [--seed 1] [--out file.json]
+//Runs the same random queries on a side x side terrain grid with the generic AStar (heuristic through a function pointer,
+//neighbors from the frozen graph) and with PolicyAStar specialized for the heuristic on the connection lists, the frozen graph and the grid
+//All searches are checked to find paths of the same cost, ties between equal paths can be broken differently
+
+using TerrainGrid = Elite::GridGraph<Elite::GridTerrainNode, Elite::GraphConnection>;
+
+struct SearchResult
+{
+	std::string Search{};
+	int Side{};
+	int Queries{};
+	double TotalMs{};
+	double MeanUs{};
+	double MeanVisited{};
+	int NrSameCost{};
+};
+
+namespace
+{
+	constexpr float CostStraight{ 1.f };
+	constexpr float CostDiagonal{ 1.5f };
+
+	struct Query
+	{
+		int StartIdx{};
+		int GoalIdx{};
+	};
+
+	//Rectangles of mud and water like a level painted in the graph editor, water cells lose their connections
+	//and the cost of the others is scaled by the terrain like GridGraph does when connecting cells
+	std::unique_ptr<TerrainGrid> CreateGrid(int side, std::mt19937& randomEngine)
+	{
+		std::unique_ptr<TerrainGrid> pGrid{ std::make_unique<TerrainGrid>(side, side, 1, false, true, CostStraight, CostDiagonal) };
+
+		std::uniform_int_distribution<int> positionDistribution{ 0, side - 1 };
+		std::uniform_int_distribution<int> sizeDistribution{ 1, (std::max)(side / 16, 1) };
+
+		const int nrRectangles{ side * side / 256 + 4 };
+		for (int rectangle{}; rectangle < nrRectangles; ++rectangle)
+		{
+			const TerrainType terrain{ rectangle % 2 == 0 ? TerrainType::Water : TerrainType::Mud };
+			const int column{ positionDistribution(randomEngine) };
+			const int row{ positionDistribution(randomEngine) };
+			const int width{ sizeDistribution(randomEngine) };
+			const int height{ sizeDistribution(randomEngine) };
+
+			for (int x{ column }; x < (std::min)(column + width, side); ++x)
+			{
+				for (int y{ row }; y < (std::min)(row + height, side); ++y)
+				{
+					pGrid->GetNode(x, y)->SetTerrainType(terrain);
+				}
+			}
+		}
+
+		for (int idx{}; idx < side * side; ++idx)
+		{
+			if (pGrid->GetNode(idx)->GetTerrainType() != TerrainType::Water) continue;
+
+			std::vector<int> neighbors{};
+			for (Elite::GraphConnection* pConnection : pGrid->GetConnections(idx))
+			{
+				neighbors.push_back(pConnection->GetTo());
+			}
+
+			for (int neighborIdx : neighbors)
+			{
+				pGrid->RemoveConnection(idx, neighborIdx);
+			}
+		}
+
+		for (int idx{}; idx < side * side; ++idx)
+		{
+			for (Elite::GraphConnection* pConnection : pGrid->GetConnections(idx))
+			{
+				const int toIdx{ pConnection->GetTo() };
+				const bool isDiagonal{ idx % side != toIdx % side && idx / side != toIdx / side };
+				const float terrainFactor{ (int(pGrid->GetNode(idx)->GetTerrainType()) + int(pGrid->GetNode(toIdx)->GetTerrainType())) / 2.f };
+
+				pConnection->SetCost((isDiagonal ? CostDiagonal : CostStraight) * terrainFactor);
+			}
+		}
+
+		return pGrid;
+	}
+
+	float GetPathCost(const TerrainGrid& grid, const std::vector<int>& path)
+	{
+		float cost{};
+		for (size_t index{ 1 }; index < path.size(); ++index)
+		{
+			cost += grid.GetConnection(path[index - 1], path[index])->GetCost();
+		}
+		return cost;
+	}
+
+	//search(startIdx, goalIdx, nrVisited) returns the path as node indices, costs are compared to the reference ones when there are any
+	template <class T_Search>
+	SearchResult RunSearch(const std::string& name, T_Search& search, const TerrainGrid& grid, const std::vector<Query>& queries, const std::vector<float>* pReferenceCosts, std::vector<float>& costs)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		SearchResult result{};
+		result.Search = name;
+		result.Side = grid.GetColumns();
+		result.Queries = static_cast<int>(queries.size());
+
+		costs.clear();
+		double totalVisited{};
+
+		for (const Query& query : queries)
+		{
+			int nrVisited{};
+
+			const Clock::time_point start{ Clock::now() };
+			const std::vector<int> path{ search(query.StartIdx, query.GoalIdx, nrVisited) };
+			result.TotalMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+			totalVisited += nrVisited;
+			costs.push_back(GetPathCost(grid, path));
+		}
+
+		for (size_t index{}; index < costs.size(); ++index)
+		{
+			const float referenceCost{ pReferenceCosts ? (*pReferenceCosts)[index] : costs[index] };
+			if (std::abs(costs[index] - referenceCost) <= 1e-3f * (std::max)(referenceCost, 1.f)) ++result.NrSameCost;
+		}
+
+		result.MeanUs = queries.empty() ? 0.0 : result.TotalMs * 1000.0 / queries.size();
+		result.MeanVisited = queries.empty() ? 0.0 : totalVisited / queries.size();
+		return result;
+	}
+
+	template <class T_HeuristicPolicy>
+	void RunSide(int side, int nrQueries, Elite::Heuristic hFunction, unsigned int seed, std::vector<SearchResult>& results)
+	{
+		std::mt19937 randomEngine{ seed + static_cast<unsigned int>(side) };
+		const std::unique_ptr<TerrainGrid> pGrid{ CreateGrid(side, randomEngine) };
+
+		std::vector<Query> queries{};
+		std::uniform_int_distribution<int> nodeDistribution{ 0, side * side - 1 };
+		while (static_cast<int>(queries.size()) < nrQueries)
+		{
+			const Query query{ nodeDistribution(randomEngine), nodeDistribution(randomEngine) };
+			if (pGrid->GetNode(query.StartIdx)->GetTerrainType() == TerrainType::Water || pGrid->GetNode(query.GoalIdx)->GetTerrainType() == TerrainType::Water) continue;
+
+			queries.push_back(query);
+		}
+
+		std::vector<float> referenceCosts{};
+		std::vector<float> costs{};
+
+		//Generic: what the navigation code runs, node pointers in and out
+		Elite::AStar<Elite::GridTerrainNode, Elite::GraphConnection> generic{ pGrid.get(), hFunction };
+		std::vector<Elite::GridTerrainNode*> visitedNodes{};
+		auto genericSearch = [&](int startIdx, int goalIdx, int& nrVisited)
+		{
+			std::vector<int> path{};
+			for (Elite::GridTerrainNode* pNode : generic.FindPath(pGrid->GetNode(startIdx), pGrid->GetNode(goalIdx), visitedNodes))
+			{
+				path.push_back(pNode->GetIndex());
+			}
+
+			nrVisited = static_cast<int>(visitedNodes.size());
+			return path;
+		};
+		results.push_back(RunSearch("generic", genericSearch, *pGrid, queries, nullptr, referenceCosts));
+
+		std::vector<int> visitedIndices{};
+
+		//Only the heuristic inlined, neighbors still through the connection lists
+		Elite::PolicyAStar<T_HeuristicPolicy, Elite::GraphNeighbors<Elite::GridTerrainNode, Elite::GraphConnection>> graphPolicy{
+			Elite::GraphNeighbors<Elite::GridTerrainNode, Elite::GraphConnection>{ pGrid.get() } };
+		auto graphPolicySearch = [&](int startIdx, int goalIdx, int& nrVisited)
+		{
+			std::vector<int> path{ graphPolicy.FindPath(startIdx, goalIdx, visitedIndices) };
+			nrVisited = static_cast<int>(visitedIndices.size());
+			return path;
+		};
+		results.push_back(RunSearch("policy_graph", graphPolicySearch, *pGrid, queries, &referenceCosts, costs));
+
+		//Heuristic inlined, neighbors from the frozen graph
+		Elite::PolicyAStar<T_HeuristicPolicy, Elite::FrozenNeighbors> frozenPolicy{ Elite::FrozenNeighbors{ &pGrid->GetFrozenGraph() } };
+		auto frozenPolicySearch = [&](int startIdx, int goalIdx, int& nrVisited)
+		{
+			std::vector<int> path{ frozenPolicy.FindPath(startIdx, goalIdx, visitedIndices) };
+			nrVisited = static_cast<int>(visitedIndices.size());
+			return path;
+		};
+		results.push_back(RunSearch("policy_frozen", frozenPolicySearch, *pGrid, queries, &referenceCosts, costs));
+
+		//Heuristic and grid neighbors inlined, a grid the 8 directions do not fit stays on the frozen graph
+		Elite::PolicyAStar<T_HeuristicPolicy, Elite::GridNeighbors> gridPolicy{ Elite::GridNeighbors{} };
+		if (!gridPolicy.GetNeighbors().Rebuild(*pGrid))
+		{
+			std::cerr << "Grid of " << side << " x " << side << " has connections between cells that are not adjacent, policy_grid falls back on policy_frozen\n";
+			return;
+		}
+
+		auto gridPolicySearch = [&](int startIdx, int goalIdx, int& nrVisited)
+		{
+			std::vector<int> path{ gridPolicy.FindPath(startIdx, goalIdx, visitedIndices) };
+			nrVisited = static_cast<int>(visitedIndices.size());
+			return path;
+		};
+		results.push_back(RunSearch("policy_grid", gridPolicySearch, *pGrid, queries, &referenceCosts, costs));
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<int> sides{ 64, 256, 1024 };
+	int nrQueries{ 50 };
+	std::string heuristic{ "octile" };
+	unsigned int seed{ 1 };
+	std::string outputFile{};
+
+	const bool areArgumentsValid{ HeadlessBenchmark::ReadArguments(argc, argv, outputFile, [&](const std::string& argument, const std::string& value)
+	{
+		if (argument == "--sides") sides = HeadlessBenchmark::ReadList(value);
+		else if (argument == "--queries") nrQueries = atoi(value.c_str());
+		else if (argument == "--heuristic") heuristic = value;
+		else if (argument == "--seed") seed = static_cast<unsigned int>(atoi(value.c_str()));
+		else return false;
+
+		return true;
+	}) };
+	if (!areArgumentsValid) return 1;
+
+	if (heuristic != "octile" && heuristic != "euclidean" && heuristic != "manhattan")
+	{
+		std::cout << "Unknown heuristic '" << heuristic << "'\n";
+		return 1;
+	}
+
+	std::vector<SearchResult> results{};
+	for (int side : sides)
+	{
+		if (side <= 1) continue;
+
+		if (heuristic == "octile") RunSide<Elite::OctileHeuristic>(side, nrQueries, Elite::HeuristicFunctions::Octile, seed, results);
+		else if (heuristic == "euclidean") RunSide<Elite::EuclideanHeuristic>(side, nrQueries, Elite::HeuristicFunctions::Euclidean, seed, results);
+		else RunSide<Elite::ManhattanHeuristic>(side, nrQueries, Elite::HeuristicFunctions::Manhattan, seed, results);
+	}
+
+	std::stringstream json{};
+	json << "{\n\t\"benchmark\": \"astar\",\n\t\"heuristic\": \"" << heuristic << "\",\n\t\"queries\": " << nrQueries
+		<< ",\n\t\"seed\": " << seed << ",\n";
+
+	//Timed per query rather than with HeadlessBenchmark::Measure, every query is a different search
+	return HeadlessBenchmark::WriteReport(json, results, [](std::ostream& json, const SearchResult& result)
+	{
+		json << "\"search\": \"" << result.Search << "\", \"side\": " << result.Side
+			<< ", \"total_ms\": " << result.TotalMs
+			<< ", \"mean_us\": " << result.MeanUs
+			<< ", \"mean_visited\": " << result.MeanVisited
+			<< ", \"same_cost\": " << result.NrSameCost;
+	}, outputFile);
+}
@@ -0,0 +1,489 @@
+#include "stdafx.h"
+#include "EliteAI/EliteGraphs/EGraph2D.h"
+#include "EliteAI/EliteGraphs/EGridGraph.h"
+#include "EliteAI/EliteGraphs/EliteGraphAlgorithms/EAStar.h"
+#include "HeadlessCheck.h"
+
+#include <numeric>
+
+//Usage: AStarCheck [--queries 500] [--seed 1]
+//Runs random queries on terrain grids with water and mud and on random 2D graphs with unreachable parts, with the A*
+//that kept its open and closed lists in vectors and with the heap based searches that replaced it
+//AStar and PolicyAStar on the connection lists have to return the same path and visited nodes, the grid specialized
+//search walks the neighbours in another order and has to find a path of the same cost
+//Once a grid gets a connection between cells that are not adjacent the grid search has to refuse it, and the frozen graph
+//it falls back on has to return the same path and visited nodes
+//On the 2D graphs every query also joins a start and end position to their nearest nodes like NavMeshPathfinding joins them
+//to the lines of their triangles, once on a clone of the graph and once in an overlay on its frozen graph, and both have to
+//return the same path and visited nodes
+//Returns 1 at the first difference
+
+using TerrainGrid = Elite::GridGraph<Elite::GridTerrainNode, Elite::GraphConnection>;
+using RandomGraph = Elite::Graph2D<Elite::GraphNode2D, Elite::GraphConnection2D>;
+
+namespace
+{
+	//The A* before the binary heap and the per node arrays
+	template <class T_NodeType, class T_ConnectionType>
+	class ReferenceAStar final
+	{
+	public:
+		ReferenceAStar(Elite::IGraph<T_NodeType, T_ConnectionType>* pGraph, Elite::Heuristic hFunction)
+			: m_pGraph{ pGraph }
+			, m_HeuristicFunction{ hFunction }
+		{
+		}
+
+		std::vector<int> FindPath(int startIdx, int goalIdx, std::vector<int>& visitedNodes) const
+		{
+			T_NodeType* pStartNode{ m_pGraph->GetNode(startIdx) };
+			T_NodeType* pGoalNode{ m_pGraph->GetNode(goalIdx) };
+
+			visitedNodes.clear();
+
+			std::vector<int> path{};
+			std::vector<NodeRecord> openList{};
+			std::vector<NodeRecord> closedList{};
+			std::vector<NodeRecord> visitedList{};
+
+			NodeRecord currentRecord{ pStartNode };
+			currentRecord.estimatedTotalCost = GetHeuristicCost(pStartNode, pGoalNode);
+			openList.push_back(currentRecord);
+
+			while (!openList.empty())
+			{
+				currentRecord = *std::min_element(openList.begin(), openList.end());
+				if (currentRecord.pNode == pGoalNode) break;
+
+				for (T_ConnectionType* pConnection : m_pGraph->GetNodeConnections(currentRecord.pNode))
+				{
+					T_NodeType* pToNode{ m_pGraph->GetNode(pConnection->GetTo()) };
+					const float costSoFar{ currentRecord.costSoFar + pConnection->GetCost() };
+
+					const auto isToNode = [pToNode](const NodeRecord& record) { return record.pNode == pToNode; };
+					const auto closedRecord{ std::find_if(closedList.begin(), closedList.end(), isToNode) };
+					const auto openRecord{ closedRecord == closedList.end() ? std::find_if(openList.begin(), openList.end(), isToNode) : openList.end() };
+
+					if (closedRecord != closedList.end())
+					{
+						if (costSoFar >= closedRecord->costSoFar) continue;
+						closedList.erase(closedRecord);
+					}
+					else if (openRecord != openList.end())
+					{
+						if (costSoFar >= openRecord->costSoFar) continue;
+						openList.erase(openRecord);
+					}
+
+					NodeRecord newRecord{ pToNode };
+					newRecord.pConnection = pConnection;
+					newRecord.costSoFar = costSoFar;
+					newRecord.estimatedTotalCost = costSoFar + GetHeuristicCost(pToNode, pGoalNode);
+					openList.push_back(newRecord);
+				}
+
+				closedList.push_back(currentRecord);
+				visitedList.push_back(currentRecord);
+				openList.erase(std::find(openList.begin(), openList.end(), currentRecord));
+			}
+
+			for (const NodeRecord& record : visitedList)
+			{
+				visitedNodes.push_back(record.pNode->GetIndex());
+			}
+
+			if (currentRecord.pNode != pGoalNode)
+			{
+				//Fallback path to the closest node when the goal is unreachable
+				currentRecord = *std::min_element(visitedList.begin(), visitedList.end(), [](const NodeRecord& first, const NodeRecord& second)
+				{
+					return first.estimatedTotalCost - first.costSoFar < second.estimatedTotalCost - second.costSoFar;
+				});
+			}
+
+			while (currentRecord.pNode != pStartNode)
+			{
+				path.push_back(currentRecord.pNode->GetIndex());
+
+				//A parent that was reopened is not in the closed list, the old search looped forever there
+				T_NodeType* pParentNode{ m_pGraph->GetNode(currentRecord.pConnection->GetFrom()) };
+				const auto parentRecord{ std::find_if(closedList.begin(), closedList.end(), [pParentNode](const NodeRecord& record) { return record.pNode == pParentNode; }) };
+				if (parentRecord == closedList.end()) return {};
+
+				currentRecord = *parentRecord;
+			}
+
+			path.push_back(startIdx);
+			std::reverse(path.begin(), path.end());
+
+			return path;
+		}
+
+	private:
+		struct NodeRecord
+		{
+			T_NodeType* pNode = nullptr;
+			T_ConnectionType* pConnection = nullptr;
+			float costSoFar = 0.f;
+			float estimatedTotalCost = 0.f;
+
+			bool operator==(const NodeRecord& other) const
+			{
+				return pNode == other.pNode && pConnection == other.pConnection && costSoFar == other.costSoFar && estimatedTotalCost == other.estimatedTotalCost;
+			}
+
+			bool operator<(const NodeRecord& other) const { return estimatedTotalCost < other.estimatedTotalCost; }
+		};
+
+		Elite::IGraph<T_NodeType, T_ConnectionType>* m_pGraph;
+		Elite::Heuristic m_HeuristicFunction;
+
+		float GetHeuristicCost(T_NodeType* pNode, T_NodeType* pGoalNode) const
+		{
+			const Elite::Vector2 toGoal{ m_pGraph->GetNodePos(pGoalNode) - m_pGraph->GetNodePos(pNode) };
+			return m_HeuristicFunction(std::abs(toGoal.x), std::abs(toGoal.y));
+		}
+	};
+
+	struct Query
+	{
+		int StartIdx{};
+		int GoalIdx{};
+	};
+
+	//Rectangles of mud and water like the AStarBenchmark grids, water cells lose their connections
+	std::unique_ptr<TerrainGrid> CreateGrid(int side, std::mt19937& randomEngine)
+	{
+		constexpr float costStraight{ 1.f };
+		constexpr float costDiagonal{ 1.5f };
+
+		std::unique_ptr<TerrainGrid> pGrid{ std::make_unique<TerrainGrid>(side, side, 1, false, true, costStraight, costDiagonal) };
+
+		std::uniform_int_distribution<int> positionDistribution{ 0, side - 1 };
+		std::uniform_int_distribution<int> sizeDistribution{ 1, (std::max)(side / 6, 1) };
+
+		for (int rectangle{}; rectangle < side / 2 + 4; ++rectangle)
+		{
+			const TerrainType terrain{ rectangle % 2 == 0 ? TerrainType::Water : TerrainType::Mud };
+			const int column{ positionDistribution(randomEngine) };
+			const int row{ positionDistribution(randomEngine) };
+			const int width{ sizeDistribution(randomEngine) };
+			const int height{ sizeDistribution(randomEngine) };
+
+			for (int x{ column }; x < (std::min)(column + width, side); ++x)
+			{
+				for (int y{ row }; y < (std::min)(row + height, side); ++y)
+				{
+					pGrid->GetNode(x, y)->SetTerrainType(terrain);
+				}
+			}
+		}
+
+		for (int idx{}; idx < side * side; ++idx)
+		{
+			if (pGrid->GetNode(idx)->GetTerrainType() != TerrainType::Water) continue;
+
+			std::vector<int> neighbors{};
+			for (Elite::GraphConnection* pConnection : pGrid->GetConnections(idx))
+			{
+				neighbors.push_back(pConnection->GetTo());
+			}
+
+			for (int neighborIdx : neighbors)
+			{
+				pGrid->RemoveConnection(idx, neighborIdx);
+			}
+		}
+
+		for (int idx{}; idx < side * side; ++idx)
+		{
+			for (Elite::GraphConnection* pConnection : pGrid->GetConnections(idx))
+			{
+				const int toIdx{ pConnection->GetTo() };
+				const bool isDiagonal{ idx % side != toIdx % side && idx / side != toIdx / side };
+				const float terrainFactor{ (int(pGrid->GetNode(idx)->GetTerrainType()) + int(pGrid->GetNode(toIdx)->GetTerrainType())) / 2.f };
+
+				pConnection->SetCost((isDiagonal ? costDiagonal : costStraight) * terrainFactor);
+			}
+		}
+
+		return pGrid;
+	}
+
+	//Nodes connected to a few of their nearest neighbours, costs from the distance up to half again as much
+	//Some nodes stay without connections, so some goals cannot be reached
+	std::unique_ptr<RandomGraph> CreateGraph(int nrNodes, std::mt19937& randomEngine)
+	{
+		std::unique_ptr<RandomGraph> pGraph{ std::make_unique<RandomGraph>(false) };
+
+		std::uniform_real_distribution<float> positionDistribution{ 0.f, 100.f };
+		std::uniform_real_distribution<float> costDistribution{ 1.f, 1.5f };
+		std::uniform_int_distribution<int> nrConnectionsDistribution{ 0, 4 };
+
+		for (int idx{}; idx < nrNodes; ++idx)
+		{
+			pGraph->AddNode(new Elite::GraphNode2D{ idx, { positionDistribution(randomEngine), positionDistribution(randomEngine) } });
+		}
+
+		for (int idx{}; idx < nrNodes; ++idx)
+		{
+			std::vector<int> nearestNodes(static_cast<size_t>(nrNodes));
+			std::iota(nearestNodes.begin(), nearestNodes.end(), 0);
+
+			const Elite::Vector2 position{ pGraph->GetNodePos(idx) };
+			std::sort(nearestNodes.begin(), nearestNodes.end(), [&](int first, int second)
+			{
+				return Elite::DistanceSquared(position, pGraph->GetNodePos(first)) < Elite::DistanceSquared(position, pGraph->GetNodePos(second));
+			});
+
+			const int nrConnections{ nrConnectionsDistribution(randomEngine) };
+			for (int nearest{ 1 }; nearest <= nrConnections && nearest < nrNodes; ++nearest)
+			{
+				const int toIdx{ nearestNodes[nearest] };
+				if (pGraph->GetConnection(idx, toIdx)) continue;
+
+				pGraph->AddConnection(new Elite::GraphConnection2D{ idx, toIdx, Elite::Distance(position, pGraph->GetNodePos(toIdx)) * costDistribution(randomEngine) });
+			}
+		}
+
+		return pGraph;
+	}
+
+	template <class T_NodeType, class T_ConnectionType>
+	float GetPathCost(const Elite::IGraph<T_NodeType, T_ConnectionType>& graph, const std::vector<int>& path)
+	{
+		float cost{};
+		for (size_t index{ 1 }; index < path.size(); ++index)
+		{
+			cost += graph.GetConnection(path[index - 1], path[index])->GetCost();
+		}
+
+		return cost;
+	}
+
+	template <class T_NodeType>
+	std::vector<int> GetIndices(const std::vector<T_NodeType*>& nodes)
+	{
+		std::vector<int> indices{};
+		for (T_NodeType* pNode : nodes)
+		{
+			indices.push_back(pNode->GetIndex());
+		}
+
+		return indices;
+	}
+
+	bool CheckSame(const std::string& search, const Query& query, const std::vector<int>& referencePath, const std::vector<int>& referenceVisited,
+		const std::vector<int>& path, const std::vector<int>& visited)
+	{
+		if (referencePath.empty())
+		{
+			std::cout << "The reference search lost the parent of a reopened node from " << query.StartIdx << " to " << query.GoalIdx << "\n";
+			return false;
+		}
+
+		if (path != referencePath || visited != referenceVisited)
+		{
+			std::cout << search << " from " << query.StartIdx << " to " << query.GoalIdx << ": " << path.size() << " path nodes and "
+				<< visited.size() << " visited, the reference has " << referencePath.size() << " and " << referenceVisited.size()
+				<< (path.size() == referencePath.size() && visited.size() == referenceVisited.size() ? " in another order" : "") << "\n";
+			return false;
+		}
+
+		return true;
+	}
+
+	template <class T_NodeType, class T_ConnectionType>
+	std::vector<Query> CreateQueries(const Elite::IGraph<T_NodeType, T_ConnectionType>& graph, int nrQueries, std::mt19937& randomEngine)
+	{
+		std::uniform_int_distribution<int> nodeDistribution{ 0, graph.GetNrOfNodes() - 1 };
+
+		std::vector<Query> queries{};
+		for (int query{}; query < nrQueries; ++query)
+		{
+			queries.push_back(Query{ nodeDistribution(randomEngine), nodeDistribution(randomEngine) });
+		}
+
+		return queries;
+	}
+
+	bool RunGrid(int side, int nrQueries, std::mt19937& randomEngine)
+	{
+		const std::unique_ptr<TerrainGrid> pGrid{ CreateGrid(side, randomEngine) };
+
+		const ReferenceAStar<Elite::GridTerrainNode, Elite::GraphConnection> reference{ pGrid.get(), Elite::HeuristicFunctions::Octile };
+		Elite::AStar<Elite::GridTerrainNode, Elite::GraphConnection> generic{ pGrid.get(), Elite::HeuristicFunctions::Octile };
+		Elite::PolicyAStar<Elite::OctileHeuristic, Elite::GraphNeighbors<Elite::GridTerrainNode, Elite::GraphConnection>> graphPolicy{
+			Elite::GraphNeighbors<Elite::GridTerrainNode, Elite::GraphConnection>{ pGrid.get() } };
+		Elite::PolicyAStar<Elite::OctileHeuristic, Elite::GridNeighbors> gridPolicy{ Elite::GridNeighbors{} };
+		if (!gridPolicy.GetNeighbors().Rebuild(*pGrid))
+		{
+			std::cout << "The grid search refuses a plain grid\n";
+			return false;
+		}
+
+		std::vector<int> referenceVisited{};
+		std::vector<int> visited{};
+		std::vector<Elite::GridTerrainNode*> visitedNodes{};
+
+		for (const Query& query : CreateQueries(*pGrid, nrQueries, randomEngine))
+		{
+			const std::vector<int> referencePath{ reference.FindPath(query.StartIdx, query.GoalIdx, referenceVisited) };
+
+			const std::vector<int> genericPath{ GetIndices(generic.FindPath(pGrid->GetNode(query.StartIdx), pGrid->GetNode(query.GoalIdx), visitedNodes)) };
+			if (!CheckSame("AStar", query, referencePath, referenceVisited, genericPath, GetIndices(visitedNodes))) return false;
+
+			const std::vector<int> graphPolicyPath{ graphPolicy.FindPath(query.StartIdx, query.GoalIdx, visited) };
+			if (!CheckSame("PolicyAStar on the connections", query, referencePath, referenceVisited, graphPolicyPath, visited)) return false;
+
+			//Unreachable goals fall back on the closest visited cell, which other neighbour orders can pick differently
+			if (referencePath.back() != query.GoalIdx) continue;
+
+			const std::vector<int> gridPolicyPath{ gridPolicy.FindPath(query.StartIdx, query.GoalIdx, visited) };
+			const float referenceCost{ GetPathCost(*pGrid, referencePath) };
+			const float gridPolicyCost{ GetPathCost(*pGrid, gridPolicyPath) };
+			if (gridPolicyPath.back() != query.GoalIdx || std::abs(gridPolicyCost - referenceCost) > 1e-3f * (std::max)(referenceCost, 1.f))
+			{
+				std::cout << "PolicyAStar on the grid from " << query.StartIdx << " to " << query.GoalIdx << ": cost " << gridPolicyCost
+					<< ", the reference path costs " << referenceCost << "\n";
+				return false;
+			}
+		}
+
+		//A shortcut across the grid does not fit the 8 directions
+		pGrid->AddConnection(new Elite::GraphConnection{ 0, side * side - 1, 1.f });
+		if (gridPolicy.GetNeighbors().Rebuild(*pGrid) || gridPolicy.GetNeighbors().GetNrOfNodes() != 0)
+		{
+			std::cout << "The grid search accepts a connection between cells that are not adjacent\n";
+			return false;
+		}
+
+		Elite::PolicyAStar<Elite::OctileHeuristic, Elite::FrozenNeighbors> frozenPolicy{ Elite::FrozenNeighbors{ &pGrid->GetFrozenGraph() } };
+		for (const Query& query : CreateQueries(*pGrid, nrQueries, randomEngine))
+		{
+			const std::vector<int> referencePath{ reference.FindPath(query.StartIdx, query.GoalIdx, referenceVisited) };
+
+			const std::vector<int> frozenPolicyPath{ frozenPolicy.FindPath(query.StartIdx, query.GoalIdx, visited) };
+			if (!CheckSame("PolicyAStar on the frozen grid with a shortcut", query, referencePath, referenceVisited, frozenPolicyPath, visited)) return false;
+		}
+
+		return true;
+	}
+
+	std::vector<int> GetNearestNodes(const RandomGraph& graph, const Elite::Vector2& position, int nrNearestNodes)
+	{
+		std::vector<int> nearestNodes(static_cast<size_t>(graph.GetNrOfNodes()));
+		std::iota(nearestNodes.begin(), nearestNodes.end(), 0);
+
+		std::sort(nearestNodes.begin(), nearestNodes.end(), [&](int first, int second)
+		{
+			return Elite::DistanceSquared(position, graph.GetNodePos(first)) < Elite::DistanceSquared(position, graph.GetNodePos(second));
+		});
+
+		nearestNodes.resize((std::min)(nearestNodes.size(), static_cast<size_t>(nrNearestNodes)));
+		return nearestNodes;
+	}
+
+	//The nav mesh search before the overlay: start and end node added to a copy of the graph, with distance costs both ways
+	std::vector<int> FindClonePath(const RandomGraph& graph, const Elite::Vector2& startPos, const std::vector<int>& startNodes,
+		const Elite::Vector2& endPos, const std::vector<int>& endNodes, std::vector<int>& visited)
+	{
+		const std::shared_ptr<Elite::IGraph<Elite::GraphNode2D, Elite::GraphConnection2D>> pClone{ graph.Clone() };
+
+		Elite::GraphNode2D* pStartNode{ new Elite::GraphNode2D{ pClone->GetNextFreeNodeIndex(), startPos } };
+		pClone->AddNode(pStartNode);
+		for (int nodeIdx : startNodes)
+		{
+			pClone->AddConnection(new Elite::GraphConnection2D{ pStartNode->GetIndex(), nodeIdx, Elite::Distance(startPos, pClone->GetNodePos(nodeIdx)) });
+		}
+
+		Elite::GraphNode2D* pEndNode{ new Elite::GraphNode2D{ pClone->GetNextFreeNodeIndex(), endPos } };
+		pClone->AddNode(pEndNode);
+		for (int nodeIdx : endNodes)
+		{
+			pClone->AddConnection(new Elite::GraphConnection2D{ pEndNode->GetIndex(), nodeIdx, Elite::Distance(endPos, pClone->GetNodePos(nodeIdx)) });
+		}
+
+		Elite::AStar<Elite::GraphNode2D, Elite::GraphConnection2D> search{ pClone.get(), Elite::HeuristicFunctions::Euclidean };
+		std::vector<Elite::GraphNode2D*> visitedNodes{};
+		const std::vector<int> path{ GetIndices(search.FindPath(pStartNode, pEndNode, visitedNodes)) };
+
+		visited = GetIndices(visitedNodes);
+		return path;
+	}
+
+	bool RunGraph(int nrNodes, int nrQueries, std::mt19937& randomEngine)
+	{
+		const std::unique_ptr<RandomGraph> pGraph{ CreateGraph(nrNodes, randomEngine) };
+
+		const ReferenceAStar<Elite::GraphNode2D, Elite::GraphConnection2D> reference{ pGraph.get(), Elite::HeuristicFunctions::Euclidean };
+		Elite::AStar<Elite::GraphNode2D, Elite::GraphConnection2D> generic{ pGraph.get(), Elite::HeuristicFunctions::Euclidean };
+		Elite::PolicyAStar<Elite::EuclideanHeuristic, Elite::GraphNeighbors<Elite::GraphNode2D, Elite::GraphConnection2D>> graphPolicy{
+			Elite::GraphNeighbors<Elite::GraphNode2D, Elite::GraphConnection2D>{ pGraph.get() } };
+
+		Elite::PolicyAStar<Elite::EuclideanHeuristic, Elite::OverlayNeighbors> overlaySearch{ Elite::OverlayNeighbors{} };
+
+		std::uniform_real_distribution<float> positionDistribution{ 0.f, 100.f };
+		std::uniform_int_distribution<int> nrLinesDistribution{ 1, 3 };
+
+		std::vector<int> referenceVisited{};
+		std::vector<int> visited{};
+		std::vector<Elite::GraphNode2D*> visitedNodes{};
+
+		for (const Query& query : CreateQueries(*pGraph, nrQueries, randomEngine))
+		{
+			const std::vector<int> referencePath{ reference.FindPath(query.StartIdx, query.GoalIdx, referenceVisited) };
+
+			const std::vector<int> genericPath{ GetIndices(generic.FindPath(pGraph->GetNode(query.StartIdx), pGraph->GetNode(query.GoalIdx), visitedNodes)) };
+			if (!CheckSame("AStar", query, referencePath, referenceVisited, genericPath, GetIndices(visitedNodes))) return false;
+
+			const std::vector<int> graphPolicyPath{ graphPolicy.FindPath(query.StartIdx, query.GoalIdx, visited) };
+			if (!CheckSame("PolicyAStar on the connections", query, referencePath, referenceVisited, graphPolicyPath, visited)) return false;
+
+			//A triangle has up to 3 lines with a node
+			const Elite::Vector2 startPos{ positionDistribution(randomEngine), positionDistribution(randomEngine) };
+			const Elite::Vector2 endPos{ positionDistribution(randomEngine), positionDistribution(randomEngine) };
+			const std::vector<int> startNodes{ GetNearestNodes(*pGraph, startPos, nrLinesDistribution(randomEngine)) };
+			const std::vector<int> endNodes{ GetNearestNodes(*pGraph, endPos, nrLinesDistribution(randomEngine)) };
+
+			const std::vector<int> clonePath{ FindClonePath(*pGraph, startPos, startNodes, endPos, endNodes, referenceVisited) };
+
+			//Same setup as NavMeshPathfinding::FindPath
+			Elite::OverlayNeighbors& overlay{ overlaySearch.GetNeighbors() };
+			overlay.Reset(&pGraph->GetFrozenGraph());
+
+			const int startIdx{ overlay.AddNode(startPos) };
+			for (int nodeIdx : startNodes)
+			{
+				overlay.AddConnection(startIdx, nodeIdx, Elite::Distance(startPos, pGraph->GetNodePos(nodeIdx)));
+			}
+
+			const int endIdx{ overlay.AddNode(endPos) };
+			for (int nodeIdx : endNodes)
+			{
+				overlay.AddConnection(nodeIdx, endIdx, Elite::Distance(endPos, pGraph->GetNodePos(nodeIdx)));
+			}
+
+			const std::vector<int> overlayPath{ overlaySearch.FindPath(startIdx, endIdx, visited) };
+			if (!CheckSame("Overlay search", Query{ startIdx, endIdx }, clonePath, referenceVisited, overlayPath, visited)) return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	HeadlessCheck::Arguments arguments{ 500 };
+	if (!HeadlessCheck::ReadArguments(argc, argv, "queries", arguments)) return 1;
+
+	std::mt19937 randomEngine{ arguments.Seed };
+
+	const int sides[]{ 8, 24, 48 };
+	auto getGridName = [](int side) { return "Grid of " + std::to_string(side) + " x " + std::to_string(side); };
+	if (HeadlessCheck::CheckShapes(sides, arguments, "queries", getGridName, [&](int side) { return RunGrid(side, arguments.Count, randomEngine); }) != 0) return 1;
+
+	const int nrsOfNodes[]{ 20, 150, 600 };
+	auto getGraphName = [](int nrNodes) { return "Graph of " + std::to_string(nrNodes) + " nodes"; };
+	return HeadlessCheck::CheckShapes(nrsOfNodes, arguments, "queries", getGraphName, [&](int nrNodes) { return RunGraph(nrNodes, arguments.Count, randomEngine); });
+}
@@ -0,0 +1,243 @@
+#include "stdafx.h"
+#include "ExplorationGrid.h"
+#include "HeadlessCheck.h"
+
+//Usage: ExplorationGridCheck [--steps 2000] [--seed 1]
+//Applies random layer changes, visits and view cones to grids of a few shapes and after every UpdateScore compares
+//the scores with the layers recombined cell by cell, and the best unvisited cell with a linear scan over all cells
+//After every step the frontier is compared with the visited cells that have an unvisited neighbour, and the nearest
+//frontier cell to a few random positions with a scan over those cells
+//Returns 1 at the first difference
+
+namespace
+{
+	//Highest score among the unvisited cells, the highest index on ties
+	int FindBestUnvisitedCell(const ExplorationGrid& grid)
+	{
+		int bestIndex{ -1 };
+		for (int index{}; index < grid.GetNrCells(); ++index)
+		{
+			if (grid.IsVisited(index)) continue;
+
+			if (bestIndex == -1 || !(grid.GetScore(index) < grid.GetScore(bestIndex))) bestIndex = index;
+		}
+
+		return bestIndex;
+	}
+
+	//Same operation order as the score kernel
+	float CalculateScore(const ExplorationGrid& grid, int index)
+	{
+		float score{ grid.GetLayerWeight(static_cast<eInfluenceLayer>(0)) * grid.GetLayer(static_cast<eInfluenceLayer>(0), index) };
+		for (int layer{ 1 }; layer < ExplorationGrid::NrLayers; ++layer)
+		{
+			score += grid.GetLayerWeight(static_cast<eInfluenceLayer>(layer)) * grid.GetLayer(static_cast<eInfluenceLayer>(layer), index);
+		}
+
+		return score;
+	}
+
+	bool Check(const ExplorationGrid& grid, int step)
+	{
+		for (int index{}; index < grid.GetNrCells(); ++index)
+		{
+			if (grid.GetScore(index) != CalculateScore(grid, index))
+			{
+				std::cout << "Step " << step << ": score of cell " << index << " is " << grid.GetScore(index) << ", the layers give " << CalculateScore(grid, index) << "\n";
+				return false;
+			}
+		}
+
+		const int bestCell{ FindBestUnvisitedCell(grid) };
+		if (grid.GetBestUnvisitedCell() != bestCell)
+		{
+			std::cout << "Step " << step << ": best unvisited cell " << grid.GetBestUnvisitedCell() << ", the scan finds " << bestCell << "\n";
+			return false;
+		}
+
+		return true;
+	}
+
+	bool IsFrontier(const ExplorationGrid& grid, int index)
+	{
+		if (!grid.IsVisited(index)) return false;
+
+		const int column{ grid.GetColumn(index) };
+		const int row{ grid.GetRow(index) };
+		for (int x{ (std::max)(column - 1, 0) }; x <= (std::min)(column + 1, grid.GetNrColumns() - 1); ++x)
+		{
+			for (int y{ (std::max)(row - 1, 0) }; y <= (std::min)(row + 1, grid.GetNrRows() - 1); ++y)
+			{
+				if (!grid.IsVisited(grid.GetIndex(x, y))) return true;
+			}
+		}
+
+		return false;
+	}
+
+	//Distance in cells from the position, the lowest index on ties
+	int FindNearestFrontierCell(const ExplorationGrid& grid, const Elite::Vector2& position)
+	{
+		const Elite::Vector2 origin{ grid.GetPosition(0) };
+		const float column{ (position.x - origin.x) / grid.GetCellSize() };
+		const float row{ (position.y - origin.y) / grid.GetCellSize() };
+
+		int nearestIndex{ -1 };
+		float nearestDistanceSquared{};
+		for (int index{}; index < grid.GetNrCells(); ++index)
+		{
+			if (!IsFrontier(grid, index)) continue;
+
+			const float distanceX{ grid.GetColumn(index) - column };
+			const float distanceY{ grid.GetRow(index) - row };
+			const float distanceSquared{ distanceX * distanceX + distanceY * distanceY };
+			if (nearestIndex == -1 || distanceSquared < nearestDistanceSquared)
+			{
+				nearestIndex = index;
+				nearestDistanceSquared = distanceSquared;
+			}
+		}
+
+		return nearestIndex;
+	}
+
+	bool CheckFrontier(const ExplorationGrid& grid, int step, const Elite::Vector2 (&positions)[4])
+	{
+		int nrFrontierCells{};
+		for (int index{}; index < grid.GetNrCells(); ++index)
+		{
+			if (grid.IsFrontier(index) != IsFrontier(grid, index))
+			{
+				std::cout << "Step " << step << ": cell " << index << (grid.IsFrontier(index) ? " is" : " is not") << " in the frontier\n";
+				return false;
+			}
+
+			if (grid.IsFrontier(index)) ++nrFrontierCells;
+		}
+
+		if (grid.GetNrFrontierCells() != nrFrontierCells)
+		{
+			std::cout << "Step " << step << ": " << grid.GetNrFrontierCells() << " frontier cells, the scan finds " << nrFrontierCells << "\n";
+			return false;
+		}
+
+		for (const Elite::Vector2& position : positions)
+		{
+			const int nearestCell{ FindNearestFrontierCell(grid, position) };
+			if (grid.GetNearestFrontierCell(position) != nearestCell)
+			{
+				std::cout << "Step " << step << ": nearest frontier cell to (" << position.x << ", " << position.y << ") is "
+					<< grid.GetNearestFrontierCell(position) << ", the scan finds " << nearestCell << "\n";
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool RunGrid(const WorldInfo& world, int nrColumns, int nrSteps, unsigned int seed)
+	{
+		ExplorationGrid grid{ world, nrColumns };
+		grid.SetLayerWeight(eInfluenceLayer::Threat, -2.f);
+		grid.SetLayerWeight(eInfluenceLayer::Fog, 0.5f);
+
+		std::mt19937 randomEngine{ seed };
+		std::uniform_real_distribution<float> xDistribution{ world.Center.x - world.Dimensions.x / 2.f, world.Center.x + world.Dimensions.x / 2.f };
+		std::uniform_real_distribution<float> yDistribution{ world.Center.y - world.Dimensions.y / 2.f, world.Center.y + world.Dimensions.y / 2.f };
+		std::uniform_real_distribution<float> unitDistribution{ 0.f, 1.f };
+		std::uniform_int_distribution<int> operationDistribution{ 0, 99 };
+		std::uniform_int_distribution<int> cellDistribution{ 0, grid.GetNrCells() - 1 };
+
+		const float cellSize{ grid.GetCellSize() };
+		std::vector<std::pair<Elite::Vector2, float>> sources{};
+
+		for (int step{}; step < nrSteps; ++step)
+		{
+			const Elite::Vector2 position{ xDistribution(randomEngine), yDistribution(randomEngine) };
+			const int operation{ operationDistribution(randomEngine) };
+
+			//Mostly the small per tick changes of the plugin, now and then one that touches every cell
+			if (operation < 30)
+			{
+				grid.AddDisc(eInfluenceLayer::Threat, position, cellSize * (1.f + 3.f * unitDistribution(randomEngine)), unitDistribution(randomEngine));
+			}
+			else if (operation < 50)
+			{
+				grid.SetVisited(cellDistribution(randomEngine), unitDistribution(randomEngine) < 0.8f);
+			}
+			else if (operation < 60)
+			{
+				grid.StampViewCone(position, unitDistribution(randomEngine) * 6.28f, 1.5f, cellSize * 6.f);
+			}
+			else if (operation < 72)
+			{
+				grid.SetInfluenceRadius(unitDistribution(randomEngine) < 0.2f ? 0.f : 6.f);
+				const float weight{ unitDistribution(randomEngine) * 2.f - 0.5f };
+				grid.AddInfluence(position, weight);
+				sources.emplace_back(position, weight);
+			}
+			else if (operation < 76 && !sources.empty())
+			{
+				//Removed with the radius it was added with is not known here, so the house layer is rebuilt
+				grid.ClearInfluence();
+				sources.clear();
+			}
+			else if (operation < 84)
+			{
+				grid.ScaleLayer(eInfluenceLayer::Threat, 0.9f);
+			}
+			else if (operation < 86)
+			{
+				grid.ClearLayer(eInfluenceLayer::Threat);
+			}
+			else if (operation < 88)
+			{
+				grid.SetLayerWeight(eInfluenceLayer::PurgeDanger, -unitDistribution(randomEngine));
+				grid.AddDisc(eInfluenceLayer::PurgeDanger, position, cellSize * 4.f, 1.f);
+			}
+
+			//Queries from inside and around the grid
+			const Elite::Vector2 queries[4]{ { xDistribution(randomEngine), yDistribution(randomEngine) }, { xDistribution(randomEngine), yDistribution(randomEngine) },
+				{ xDistribution(randomEngine) * 1.5f, yDistribution(randomEngine) * 1.5f }, position };
+			if (!CheckFrontier(grid, step, queries)) return false;
+
+			//The plugin recombines once per tick, sometimes after several changes
+			if (operation % 3 == 0) continue;
+
+			grid.UpdateScore();
+			if (!Check(grid, step)) return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	HeadlessCheck::Arguments arguments{ 2000 };
+	if (!HeadlessCheck::ReadArguments(argc, argv, "steps", arguments)) return 1;
+
+	struct GridShape
+	{
+		Elite::Vector2 Center;
+		Elite::Vector2 Dimensions;
+		int NrColumns;
+	};
+
+	const GridShape shapes[]{ { { 0.f, 0.f }, { 300.f, 300.f }, 15 }, { { 50.f, -20.f }, { 640.f, 410.f }, 64 }, { { 0.f, 0.f }, { 100.f, 700.f }, 7 } };
+	auto getName = [](const GridShape& shape)
+	{
+		std::stringstream name{};
+		name << "Grid of " << shape.NrColumns << " columns over " << shape.Dimensions.x << " x " << shape.Dimensions.y;
+		return name.str();
+	};
+
+	return HeadlessCheck::CheckShapes(shapes, arguments, "steps", getName, [&](const GridShape& shape)
+	{
+		WorldInfo world{};
+		world.Center = shape.Center;
+		world.Dimensions = shape.Dimensions;
+
+		return RunGrid(world, shape.NrColumns, arguments.Count, arguments.Seed);
+	});
+}
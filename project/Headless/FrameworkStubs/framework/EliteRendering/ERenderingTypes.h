@@ -0,0 +1,15 @@
+#pragma once
+//The exam framework's renderer is not part of this repository, the headless build only needs its color type for the graph visuals
+namespace Elite
+{
+	struct Color
+	{
+		float r{}, g{}, b{}, a{ 1.f };
+
+		Color() = default;
+		Color(float red, float green, float blue, float alpha = 1.f)
+			: r{ red }, g{ green }, b{ blue }, a{ alpha }
+		{
+		}
+	};
+}
@@ -0,0 +1,330 @@
+#include "stdafx.h"
+#include "HeadlessRunner.h"
+
+#include <chrono>
+#include <numeric>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/wait.h>
+#endif
+
+//Usage: HeadlessBatch [--runs n] [--first-seed n] [--levels a.gppl,b.gppl] [--jobs n] [--ticks n] [--dt seconds] [--enemies n] [--csv file]
+//Runs every seed as its own headless process, levels are assigned round robin
+//Every run is a separate process so the plugin's rand() state and console output stay per run
+namespace
+{
+	struct BatchSettings
+	{
+		int Runs{ 100 };
+		int FirstSeed{ 1 };
+		int Jobs{ static_cast<int>((std::max)(std::thread::hardware_concurrency(), 1u)) };
+		std::vector<std::string> Levels{};
+		std::string CsvFile{};
+		HeadlessRunSettings Run{};
+	};
+
+	struct BatchResult
+	{
+		int Seed{};
+		int LevelIndex{};
+		bool IsValid{ false };
+		bool IsAgentDead{ false };
+		int TicksRun{};
+		double WallTime{};
+		StatisticsInfo Stats{};
+	};
+
+	struct Metric
+	{
+		const char* Name;
+		std::function<double(const BatchResult&)> GetValue;
+	};
+
+	bool ParseArguments(int argc, char* argv[], BatchSettings& settings)
+	{
+		for (int index{ 1 }; index < argc; ++index)
+		{
+			const std::string argument{ argv[index] };
+
+			if (index + 1 >= argc)
+			{
+				std::cout << "Missing value for '" << argument << "'\n";
+				return false;
+			}
+
+			const std::string value{ argv[++index] };
+
+			if (argument == "--runs") settings.Runs = atoi(value.c_str());
+			else if (argument == "--first-seed") settings.FirstSeed = atoi(value.c_str());
+			else if (argument == "--jobs") settings.Jobs = atoi(value.c_str());
+			else if (argument == "--ticks") settings.Run.Ticks = atoi(value.c_str());
+			else if (argument == "--dt") settings.Run.DeltaTime = static_cast<float>(atof(value.c_str()));
+			else if (argument == "--enemies") settings.Run.EnemyCount = atoi(value.c_str());
+			else if (argument == "--csv") settings.CsvFile = value;
+			else if (argument == "--levels")
+			{
+				std::stringstream stream{ value };
+				std::string level{};
+				while (std::getline(stream, level, ','))
+				{
+					if (!level.empty()) settings.Levels.push_back(level);
+				}
+			}
+			else
+			{
+				std::cout << "Unknown argument '" << argument << "'\n";
+				return false;
+			}
+		}
+
+		//Empty level keeps the one the plugin asks for
+		if (settings.Levels.empty()) settings.Levels.push_back("");
+
+		if (settings.Runs <= 0 || settings.Jobs <= 0 || settings.Run.Ticks <= 0 || settings.Run.DeltaTime <= 0.f)
+		{
+			std::cout << "Runs, jobs, ticks and dt have to be positive\n";
+			return false;
+		}
+
+		return true;
+	}
+
+	//Seed and level of the run, invalid until it ran
+	BatchResult CreateResult(const BatchSettings& settings, int runIndex)
+	{
+		BatchResult batchResult{};
+		batchResult.Seed = settings.FirstSeed + runIndex;
+		batchResult.LevelIndex = runIndex % static_cast<int>(settings.Levels.size());
+
+		return batchResult;
+	}
+
+	BatchResult RunJob(const BatchSettings& settings, int runIndex)
+	{
+		BatchResult batchResult{ CreateResult(settings, runIndex) };
+
+		HeadlessRunSettings runSettings{ settings.Run };
+		runSettings.Seed = batchResult.Seed;
+		runSettings.LevelFile = settings.Levels[batchResult.LevelIndex];
+
+		srand(static_cast<unsigned int>(batchResult.Seed));
+
+		HeadlessRunResult result{};
+		batchResult.IsValid = RunHeadless(runSettings, result);
+		batchResult.IsAgentDead = result.IsAgentDead;
+		batchResult.TicksRun = result.TicksRun;
+		batchResult.WallTime = result.WallTime;
+		batchResult.Stats = result.Stats;
+
+		return batchResult;
+	}
+
+#ifdef _WIN32
+	//No fork, the runs share the process and run one after the other
+	std::vector<BatchResult> RunBatch(const BatchSettings& settings)
+	{
+		std::vector<BatchResult> results{};
+
+		for (int runIndex{}; runIndex < settings.Runs; ++runIndex)
+		{
+			results.push_back(RunJob(settings, runIndex));
+		}
+
+		return results;
+	}
+#else
+	std::vector<BatchResult> RunBatch(const BatchSettings& settings)
+	{
+		struct Worker
+		{
+			pid_t Pid{};
+			int ReadFd{};
+			int RunIndex{};
+		};
+
+		std::vector<BatchResult> results{};
+		std::vector<Worker> workers{};
+		int nextRun{};
+
+		std::cout.flush();
+
+		while (nextRun < settings.Runs || !workers.empty())
+		{
+			//Keep every job slot busy
+			while (nextRun < settings.Runs && static_cast<int>(workers.size()) < settings.Jobs)
+			{
+				int fds[2]{};
+				if (pipe(fds) != 0)
+				{
+					//Tried again once a worker finished and closed its pipe, without any running the remaining runs can not start
+					if (workers.empty())
+					{
+						std::cout << "Could not create a pipe, runs " << nextRun << " to " << settings.Runs - 1 << " are recorded as failed\n";
+						for (; nextRun < settings.Runs; ++nextRun)
+						{
+							results.push_back(CreateResult(settings, nextRun));
+						}
+					}
+					else
+					{
+						std::cout << "Could not create a pipe\n";
+					}
+
+					break;
+				}
+
+				const pid_t pid{ fork() };
+				if (pid == 0)
+				{
+					close(fds[0]);
+
+					const int nullFd{ open("/dev/null", O_WRONLY) };
+					dup2(nullFd, STDOUT_FILENO);
+
+					const BatchResult result{ RunJob(settings, nextRun) };
+					const ssize_t written{ write(fds[1], &result, sizeof(result)) };
+
+					_exit(written == static_cast<ssize_t>(sizeof(result)) ? 0 : 1);
+				}
+
+				close(fds[1]);
+
+				if (pid < 0)
+				{
+					close(fds[0]);
+					std::cout << "Could not start run " << nextRun << ", it is recorded as failed\n";
+					results.push_back(CreateResult(settings, nextRun));
+					++nextRun;
+					continue;
+				}
+
+				workers.push_back(Worker{ pid, fds[0], nextRun });
+				++nextRun;
+			}
+
+			if (workers.empty()) break;
+
+			int status{};
+			const pid_t finishedPid{ wait(&status) };
+
+			auto compareWorker = [&](const Worker& worker) -> bool { return worker.Pid == finishedPid; };
+			auto iterator = std::find_if(workers.begin(), workers.end(), compareWorker);
+			if (iterator == workers.end()) continue;
+
+			BatchResult result{};
+			if (read(iterator->ReadFd, &result, sizeof(result)) != static_cast<ssize_t>(sizeof(result)))
+			{
+				result = CreateResult(settings, iterator->RunIndex);
+
+				std::cout << "Run with seed " << result.Seed << " crashed\n";
+			}
+
+			close(iterator->ReadFd);
+			workers.erase(iterator);
+
+			results.push_back(result);
+
+			if (results.size() % 100 == 0)
+			{
+				std::cout << results.size() << '/' << settings.Runs << " runs done\n";
+			}
+		}
+
+		auto compareSeed = [](const BatchResult& a, const BatchResult& b) -> bool { return a.Seed < b.Seed; };
+		std::sort(results.begin(), results.end(), compareSeed);
+
+		return results;
+	}
+#endif
+
+	void PrintReport(const BatchSettings& settings, const std::vector<BatchResult>& results, double wallTime)
+	{
+		const std::vector<Metric> metrics
+		{
+			{ "Score", [](const BatchResult& result) { return static_cast<double>(result.Stats.Score); } },
+			{ "TimeSurvived", [](const BatchResult& result) { return static_cast<double>(result.Stats.TimeSurvived); } },
+			{ "EnemiesKilled", [](const BatchResult& result) { return static_cast<double>(result.Stats.NumEnemiesKilled); } },
+			{ "EnemiesHit", [](const BatchResult& result) { return static_cast<double>(result.Stats.NumEnemiesHit); } },
+			{ "MissedShots", [](const BatchResult& result) { return static_cast<double>(result.Stats.NumMissedShots); } },
+			{ "ItemsPickedUp", [](const BatchResult& result) { return static_cast<double>(result.Stats.NumItemsPickUp); } }
+		};
+
+		std::vector<const BatchResult*> validResults{};
+		int nrDeaths{};
+		for (const BatchResult& result : results)
+		{
+			if (!result.IsValid) continue;
+
+			validResults.push_back(&result);
+			if (result.IsAgentDead) ++nrDeaths;
+		}
+
+		printf("Runs:     %d valid of %d, %d died, %d jobs, %.1f s wall time (%.0f runs/hour)\n",
+			static_cast<int>(validResults.size()), settings.Runs, nrDeaths, settings.Jobs, wallTime, wallTime > 0.0 ? results.size() * 3600.0 / wallTime : 0.0);
+
+		if (validResults.empty()) return;
+
+		printf("%-14s %10s %10s %10s %10s %10s %10s %10s %10s\n", "Metric", "Mean", "Variance", "StdDev", "Min", "P10", "P50", "P90", "Max");
+
+		for (const Metric& metric : metrics)
+		{
+			std::vector<double> values{};
+			for (const BatchResult* pResult : validResults)
+			{
+				values.push_back(metric.GetValue(*pResult));
+			}
+
+			const double mean{ std::accumulate(values.begin(), values.end(), 0.0) / values.size() };
+
+			double variance{};
+			for (double value : values)
+			{
+				variance += (value - mean) * (value - mean);
+			}
+			variance = values.size() > 1 ? variance / (values.size() - 1) : 0.0;
+
+			printf("%-14s %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n", metric.Name, mean, variance, sqrt(variance),
+				GetPercentile(values, 0.0), GetPercentile(values, 10.0), GetPercentile(values, 50.0), GetPercentile(values, 90.0), GetPercentile(values, 100.0));
+		}
+	}
+
+	bool WriteCsv(const BatchSettings& settings, const std::vector<BatchResult>& results)
+	{
+		std::ofstream file{ settings.CsvFile };
+		if (!file)
+		{
+			std::cout << "Could not write '" << settings.CsvFile << "'\n";
+			return false;
+		}
+
+		file << "seed,level,valid,dead,ticks,wall_time,score,time_survived,enemies_killed,enemies_hit,missed_shots,items_picked_up\n";
+
+		for (const BatchResult& result : results)
+		{
+			file << result.Seed << ',' << settings.Levels[result.LevelIndex] << ',' << result.IsValid << ',' << result.IsAgentDead << ','
+				<< result.TicksRun << ',' << result.WallTime << ',' << result.Stats.Score << ',' << result.Stats.TimeSurvived << ','
+				<< result.Stats.NumEnemiesKilled << ',' << result.Stats.NumEnemiesHit << ',' << result.Stats.NumMissedShots << ','
+				<< result.Stats.NumItemsPickUp << '\n';
+		}
+
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	BatchSettings settings{};
+	if (!ParseArguments(argc, argv, settings)) return 1;
+
+	const std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::now() };
+	const std::vector<BatchResult> results{ RunBatch(settings) };
+	const double wallTime{ std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() };
+
+	PrintReport(settings, results, wallTime);
+
+	if (!settings.CsvFile.empty() && !WriteCsv(settings, results)) return 1;
+
+	return 0;
+}
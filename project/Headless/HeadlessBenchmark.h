@@ -0,0 +1,136 @@
+#pragma once
+#include <chrono>
+
+//Harness of the benchmark programs: argument reading, the timing loop and the JSON report
+//Every benchmark takes "--out file.json" and prints the report when it is not given
+namespace HeadlessBenchmark
+{
+	struct Timing
+	{
+		int Iterations{};
+		double MeanNs{};
+		double MedianNs{};
+		double P99Ns{};
+		double MinNs{};
+	};
+
+	//"1,2,3" as a list of integers
+	inline std::vector<int> ReadList(const std::string& value)
+	{
+		std::vector<int> list{};
+
+		std::stringstream stream{ value };
+		std::string element{};
+		while (std::getline(stream, element, ','))
+		{
+			list.push_back(atoi(element.c_str()));
+		}
+
+		return list;
+	}
+
+	//Reads the arguments in pairs, read(argument, value) returns false for the ones it does not know
+	//Returns false after reporting the first unknown argument
+	template<typename Read>
+	bool ReadArguments(int argc, char* argv[], std::string& outputFile, Read read)
+	{
+		for (int index{ 1 }; index + 1 < argc; index += 2)
+		{
+			const std::string argument{ argv[index] };
+			const std::string value{ argv[index + 1] };
+
+			if (argument == "--out") outputFile = value;
+			else if (!read(argument, value))
+			{
+				std::cout << "Unknown argument '" << argument << "'\n";
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	inline double GetSortedPercentile(const std::vector<double>& sortedValues, double percentile)
+	{
+		const size_t index{ static_cast<size_t>(percentile / 100.0 * (sortedValues.size() - 1) + 0.5) };
+		return sortedValues[index];
+	}
+
+	//Calls function once to warm up caches and lazily grown containers, then times it until minTime seconds
+	//and minIterations calls have passed
+	template<typename Function>
+	Timing Measure(double minTime, int minIterations, Function function)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		constexpr int maxIterations{ 100000 };
+
+		function();
+
+		std::vector<double> durations{};
+		double totalTime{};
+
+		while (static_cast<int>(durations.size()) < maxIterations && (totalTime < minTime || static_cast<int>(durations.size()) < minIterations))
+		{
+			const Clock::time_point start{ Clock::now() };
+			function();
+			const double duration{ std::chrono::duration<double, std::nano>(Clock::now() - start).count() };
+
+			durations.push_back(duration);
+			totalTime += duration * 1e-9;
+		}
+
+		std::sort(durations.begin(), durations.end());
+
+		Timing timing{};
+		timing.Iterations = static_cast<int>(durations.size());
+		timing.MeanNs = totalTime * 1e9 / durations.size();
+		timing.MedianNs = GetSortedPercentile(durations, 50.0);
+		timing.P99Ns = GetSortedPercentile(durations, 99.0);
+		timing.MinNs = durations.front();
+
+		return timing;
+	}
+
+	inline void WriteTiming(std::ostream& json, const Timing& timing)
+	{
+		json << "\"iterations\": " << timing.Iterations
+			<< ", \"mean_ns\": " << timing.MeanNs
+			<< ", \"p50_ns\": " << timing.MedianNs
+			<< ", \"p99_ns\": " << timing.P99Ns
+			<< ", \"min_ns\": " << timing.MinNs;
+	}
+
+	//Closes the report that json opened with its own fields: writeResult(json, result) writes one result object per line
+	//Prints the report, or writes it to outputFile when there is one, and returns the exit code of the program
+	template<typename Result, typename WriteResult>
+	int WriteReport(std::stringstream& json, const std::vector<Result>& results, WriteResult writeResult, const std::string& outputFile)
+	{
+		json << "\t\"results\": [\n";
+
+		for (size_t index{}; index < results.size(); ++index)
+		{
+			json << "\t\t{ ";
+			writeResult(json, results[index]);
+			json << " }" << (index + 1 < results.size() ? ",\n" : "\n");
+		}
+
+		json << "\t]\n}\n";
+
+		if (outputFile.empty())
+		{
+			std::cout << json.str();
+			return 0;
+		}
+
+		std::ofstream file{ outputFile };
+		if (!file)
+		{
+			std::cout << "Could not write '" << outputFile << "'\n";
+			return 1;
+		}
+
+		file << json.str();
+		return 0;
+	}
+}
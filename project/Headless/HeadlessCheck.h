@@ -0,0 +1,51 @@
+#pragma once
+
+//Harness of the check programs, each one only brings its own comparison
+//Every check takes "--<count> n" for the amount of work per shape and "--seed n", and returns 1 at the first difference
+namespace HeadlessCheck
+{
+	struct Arguments
+	{
+		int Count{};
+		unsigned int Seed{ 1 };
+	};
+
+	//Reads the arguments in pairs, returns false after reporting the first one that is not --seed or --<countName>
+	inline bool ReadArguments(int argc, char* argv[], const std::string& countName, Arguments& arguments)
+	{
+		for (int index{ 1 }; index + 1 < argc; index += 2)
+		{
+			const std::string argument{ argv[index] };
+			const std::string value{ argv[index + 1] };
+
+			if (argument == "--" + countName) arguments.Count = atoi(value.c_str());
+			else if (argument == "--seed") arguments.Seed = static_cast<unsigned int>(atoi(value.c_str()));
+			else
+			{
+				std::cout << "Unknown argument '" << argument << "'\n";
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	//Runs check(shape) on every shape in order and reports each one as "<name>: <count> <countName> match" or "<name> differs"
+	//Returns the exit code of the program, 1 at the first shape that differs
+	template<class T_Shapes, class T_GetName, class T_Check>
+	int CheckShapes(const T_Shapes& shapes, const Arguments& arguments, const std::string& countName, T_GetName getName, T_Check check)
+	{
+		for (const auto& shape : shapes)
+		{
+			if (!check(shape))
+			{
+				std::cout << getName(shape) << " differs\n";
+				return 1;
+			}
+
+			std::cout << getName(shape) << ": " << arguments.Count << " " << countName << " match\n";
+		}
+
+		return 0;
+	}
+}
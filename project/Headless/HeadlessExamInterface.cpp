@@ -0,0 +1,879 @@
+#include "stdafx.h"
+#include "HeadlessExamInterface.h"
+
+using namespace Elite;
+
+//The exam framework normally provides these through GPP_PluginBase.lib
+IBaseInterface::IBaseInterface() {}
+IBaseInterface::~IBaseInterface() {}
+IExamInterface::IExamInterface() {}
+IExamInterface::~IExamInterface() {}
+
+void IBaseInterface::Draw_Polygon(const Elite::Vector2* points, int count, const Elite::Vector3& color) { Draw_Polygon(points, count, color, 0.f); }
+void IBaseInterface::Draw_SolidPolygon(const Elite::Vector2* points, int count, const Elite::Vector3& color) { Draw_SolidPolygon(points, count, color, 0.f); }
+void IBaseInterface::Draw_Circle(const Elite::Vector2& center, float radius, const Elite::Vector3& color) { Draw_Circle(center, radius, color, 0.f); }
+void IBaseInterface::Draw_SolidCircle(const Elite::Vector2& center, float32 radius, const Elite::Vector2& axis, const Elite::Vector3& color) { Draw_SolidCircle(center, radius, axis, color, 0.f); }
+void IBaseInterface::Draw_Segment(const Elite::Vector2& p1, const Elite::Vector2& p2, const Elite::Vector3& color) { Draw_Segment(p1, p2, color, 0.f); }
+void IBaseInterface::Draw_Transform(const b2Transform& xf) { Draw_Transform(xf, 0.f); }
+void IBaseInterface::Draw_Point(const Elite::Vector2& p, float size, const Elite::Vector3& color) { Draw_Point(p, size, color, 0.f); }
+
+namespace
+{
+	//Agent
+	constexpr float maxStat{ 10.f };
+	constexpr float walkSpeed{ 5.f };
+	constexpr float runSpeedMultiplier{ 2.f };
+	constexpr float staminaDrain{ 1.f };
+	constexpr float staminaRecovery{ 0.5f };
+	constexpr float energyDrain{ 0.1f };
+	constexpr float starvingDamage{ 0.2f };
+	constexpr float wasBittenDuration{ 0.5f };
+
+	//Enemies
+	constexpr float enemySenseRange{ 25.f };
+	constexpr float enemyAttackCooldown{ 1.f };
+	constexpr float enemyRespawnDelay{ 5.f };
+	constexpr float enemySpawnDistance{ 40.f };
+
+	//Weapons
+	constexpr float pistolRange{ 40.f };
+	constexpr float pistolDamage{ 1.f };
+	constexpr float shotgunRange{ 20.f };
+	constexpr float shotgunHalfAngle{ 0.35f };
+	constexpr float shotgunDamage{ 2.f };
+
+	//Purge zones
+	constexpr float purgeZoneFuseTime{ 8.f };
+
+	constexpr UINT inventoryCapacity{ 5 };
+
+	//Entity lists
+	template<class T_Entity>
+	void AddEntity(std::vector<T_Entity>& entities, std::unordered_map<int, size_t>& indices, const T_Entity& entity)
+	{
+		indices[entity.Entity.EntityHash] = entities.size();
+		entities.push_back(entity);
+	}
+
+	template<class T_Entity>
+	T_Entity* FindEntity(std::vector<T_Entity>& entities, const std::unordered_map<int, size_t>& indices, const EntityInfo& entity)
+	{
+		auto iterator = indices.find(entity.EntityHash);
+		return iterator == indices.end() ? nullptr : &entities[iterator->second];
+	}
+
+	//Both keep the order, so the entities after the first removed one are indexed again
+	template<class T_Entity>
+	void RemoveEntity(std::vector<T_Entity>& entities, std::unordered_map<int, size_t>& indices, int entityHash)
+	{
+		auto iterator = indices.find(entityHash);
+		if (iterator == indices.end()) return;
+
+		const size_t firstIndex{ iterator->second };
+		indices.erase(iterator);
+		entities.erase(entities.begin() + firstIndex);
+
+		for (size_t index{ firstIndex }; index < entities.size(); ++index)
+		{
+			indices[entities[index].Entity.EntityHash] = index;
+		}
+	}
+
+	template<class T_Entity, class T_Predicate>
+	void RemoveEntities(std::vector<T_Entity>& entities, std::unordered_map<int, size_t>& indices, T_Predicate predicate)
+	{
+		auto first = std::find_if(entities.begin(), entities.end(), predicate);
+		if (first == entities.end()) return;
+
+		for (auto iterator = first; iterator != entities.end(); ++iterator)
+		{
+			if (predicate(*iterator)) indices.erase(iterator->Entity.EntityHash);
+		}
+
+		const size_t firstIndex{ static_cast<size_t>(first - entities.begin()) };
+		entities.erase(std::remove_if(first, entities.end(), predicate), entities.end());
+
+		for (size_t index{ firstIndex }; index < entities.size(); ++index)
+		{
+			indices[entities[index].Entity.EntityHash] = index;
+		}
+	}
+}
+
+HeadlessExamInterface::HeadlessExamInterface(const HeadlessLevel& level, const HeadlessSettings& settings)
+	: m_Level(level)
+	, m_Settings(settings)
+	, m_RandomEngine(static_cast<std::mt19937::result_type>(settings.Seed))
+{
+	m_Agent.Stamina = maxStat;
+	m_Agent.Health = maxStat;
+	m_Agent.Energy = maxStat;
+	m_Agent.FOV_Angle = m_Settings.FOVAngle;
+	m_Agent.FOV_Range = m_Settings.FOVRange;
+	m_Agent.Position = m_Level.World.Center;
+	m_Agent.MaxLinearSpeed = walkSpeed;
+	m_Agent.MaxAngularSpeed = static_cast<float>(E_PI);
+	m_Agent.GrabRange = 3.5f;
+	m_Agent.AgentSize = 1.f;
+
+	m_Stats.Difficulty = 0.f;
+	m_Stats.KillCountdown = 60.f;
+
+	m_Inventory.resize(inventoryCapacity);
+
+	for (int index{}; index < m_Settings.ItemCount && !m_Level.Houses.empty(); ++index)
+	{
+		SpawnItem();
+	}
+
+	for (int index{}; m_Settings.SpawnEnemies && index < m_Settings.EnemyCount; ++index)
+	{
+		SpawnEnemy();
+	}
+
+	m_PurgeZoneSpawnTime = m_Settings.PurgeZoneInterval;
+
+	UpdateFov();
+}
+
+//Simulation
+void HeadlessExamInterface::Step(const SteeringPlugin_Output& steering, float dt)
+{
+	if (m_Agent.Death) return;
+
+	UpdateAgent(steering, dt);
+	UpdateEnemies(dt);
+	UpdatePurgeZones(dt);
+
+	m_Stats.TimeSurvived += dt;
+	m_Stats.Difficulty = m_Stats.TimeSurvived / 300.f;
+	m_Stats.KillCountdown = (std::max)(m_Stats.KillCountdown - dt, 0.f);
+	m_Stats.Score = static_cast<int>(m_Stats.TimeSurvived) + m_Stats.NumEnemiesKilled * 10 + m_Stats.NumItemsPickUp * 5;
+
+	if (m_Agent.Health <= 0.f)
+	{
+		if (m_Settings.GodMode)
+		{
+			m_Agent.Health = maxStat;
+		}
+		else
+		{
+			m_Agent.Health = 0.f;
+			m_Agent.Death = true;
+		}
+	}
+
+	UpdateFov();
+}
+
+void HeadlessExamInterface::UpdateAgent(const SteeringPlugin_Output& steering, float dt)
+{
+	m_Agent.Bitten = false;
+
+	m_WasBittenTime = (std::max)(m_WasBittenTime - dt, 0.f);
+	m_Agent.WasBitten = m_WasBittenTime > 0.f;
+
+	//Stamina
+	const bool canRun{ steering.RunMode && (m_Agent.Stamina > 0.f || m_Settings.InfiniteStamina) };
+	const float maxSpeed{ canRun ? walkSpeed * runSpeedMultiplier : walkSpeed };
+
+	Vector2 velocity{ steering.LinearVelocity };
+	if (velocity.MagnitudeSquared() > maxSpeed * maxSpeed)
+	{
+		velocity = velocity.GetNormalized() * maxSpeed;
+	}
+
+	const bool isMoving{ velocity.MagnitudeSquared() > 0.0001f };
+
+	if (m_Settings.InfiniteStamina)
+	{
+		m_Agent.Stamina = maxStat;
+	}
+	else if (canRun && isMoving)
+	{
+		m_Agent.Stamina = (std::max)(m_Agent.Stamina - staminaDrain * dt, 0.f);
+	}
+	else
+	{
+		m_Agent.Stamina = (std::min)(m_Agent.Stamina + staminaRecovery * dt, maxStat);
+	}
+
+	//Movement
+	m_Agent.RunMode = canRun;
+	m_Agent.MaxLinearSpeed = maxSpeed;
+	m_Agent.LinearVelocity = velocity;
+	m_Agent.CurrentLinearSpeed = velocity.Magnitude();
+	m_Agent.Position = ClampToWorld(m_Agent.Position + velocity * dt);
+
+	if (steering.AutoOrient)
+	{
+		m_Agent.AngularVelocity = 0.f;
+		if (isMoving)
+		{
+			m_Agent.Orientation = VectorToOrientation(velocity);
+		}
+	}
+	else
+	{
+		m_Agent.AngularVelocity = Clamp(steering.AngularVelocity, -m_Agent.MaxAngularSpeed, m_Agent.MaxAngularSpeed);
+		m_Agent.Orientation = ClampedAngle(m_Agent.Orientation + m_Agent.AngularVelocity * dt);
+	}
+
+	m_Agent.IsInHouse = false;
+	for (const HeadlessHouse& house : m_Level.Houses)
+	{
+		if (IsInsideHouse(house, m_Agent.Position, 0.f))
+		{
+			m_Agent.IsInHouse = true;
+			break;
+		}
+	}
+
+	//Energy
+	m_Agent.Energy = (std::max)(m_Agent.Energy - energyDrain * dt, 0.f);
+	if (m_Agent.Energy <= 0.f)
+	{
+		m_Agent.Health -= starvingDamage * dt;
+	}
+}
+
+void HeadlessExamInterface::UpdateEnemies(float dt)
+{
+	for (SimEnemy& enemy : m_Enemies)
+	{
+		const Vector2 toAgent{ m_Agent.Position - enemy.Info.Location };
+		const float distanceSq{ toAgent.MagnitudeSquared() };
+
+		Vector2 direction{};
+		if (distanceSq < enemySenseRange * enemySenseRange)
+		{
+			direction = toAgent;
+		}
+		else
+		{
+			if (enemy.WanderTarget.DistanceSquared(enemy.Info.Location) < 4.f)
+			{
+				enemy.WanderTarget = RandomPositionInWorld(enemy.Info.Size);
+			}
+
+			direction = enemy.WanderTarget - enemy.Info.Location;
+		}
+
+		direction.Normalize();
+		enemy.Info.LinearVelocity = direction * enemy.Speed;
+		enemy.Info.Location = ClampToWorld(enemy.Info.Location + enemy.Info.LinearVelocity * dt);
+		enemy.Entity.Location = enemy.Info.Location;
+
+		//Bite
+		enemy.AttackCooldown = (std::max)(enemy.AttackCooldown - dt, 0.f);
+
+		const float attackRange{ enemy.Info.Size + m_Agent.AgentSize };
+		if (enemy.AttackCooldown <= 0.f && distanceSq < attackRange * attackRange)
+		{
+			enemy.AttackCooldown = enemyAttackCooldown;
+
+			m_Agent.Health -= enemy.Damage;
+			m_Agent.Bitten = true;
+			m_Agent.WasBitten = true;
+			m_WasBittenTime = wasBittenDuration;
+		}
+	}
+
+	//Keep the enemy count up
+	if (!m_Settings.SpawnEnemies || static_cast<int>(m_Enemies.size()) >= m_Settings.EnemyCount)
+	{
+		m_EnemyRespawnTime = enemyRespawnDelay;
+		return;
+	}
+
+	m_EnemyRespawnTime -= dt;
+	if (m_EnemyRespawnTime <= 0.f)
+	{
+		m_EnemyRespawnTime = enemyRespawnDelay;
+		SpawnEnemy();
+	}
+}
+
+void HeadlessExamInterface::UpdatePurgeZones(float dt)
+{
+	for (SimPurgeZone& purgeZone : m_PurgeZones)
+	{
+		purgeZone.TimeLeft -= dt;
+		if (purgeZone.TimeLeft > 0.f) continue;
+
+		//Detonate
+		const float radiusSq{ purgeZone.Info.Radius * purgeZone.Info.Radius };
+
+		if (m_Agent.Position.DistanceSquared(purgeZone.Info.Center) < radiusSq)
+		{
+			m_Agent.Health = 0.f;
+		}
+
+		for (SimEnemy& enemy : m_Enemies)
+		{
+			if (enemy.Info.Location.DistanceSquared(purgeZone.Info.Center) < radiusSq)
+			{
+				enemy.Info.Health = 0.f;
+			}
+		}
+	}
+
+	auto isDetonated = [](const SimPurgeZone& purgeZone)->bool { return purgeZone.TimeLeft <= 0.f; };
+	RemoveEntities(m_PurgeZones, m_PurgeZoneIndices, isDetonated);
+
+	RemoveDeadEnemies();
+
+	if (m_Settings.PurgeZoneInterval <= 0.f) return;
+
+	m_PurgeZoneSpawnTime -= dt;
+	if (m_PurgeZoneSpawnTime <= 0.f)
+	{
+		m_PurgeZoneSpawnTime = m_Settings.PurgeZoneInterval;
+		SpawnPurgeZone();
+	}
+}
+
+void HeadlessExamInterface::UpdateFov()
+{
+	m_HousesInFov.clear();
+	for (const HeadlessHouse& house : m_Level.Houses)
+	{
+		if (IsHouseInFov(house))
+		{
+			m_HousesInFov.push_back(house);
+		}
+	}
+
+	m_EntitiesInFov.clear();
+	for (const SimItem& item : m_Items)
+	{
+		if (IsPointInFov(item.Entity.Location))
+		{
+			m_EntitiesInFov.push_back(item.Entity);
+		}
+	}
+
+	for (const SimEnemy& enemy : m_Enemies)
+	{
+		if (IsPointInFov(enemy.Entity.Location))
+		{
+			m_EntitiesInFov.push_back(enemy.Entity);
+		}
+	}
+
+	for (const SimPurgeZone& purgeZone : m_PurgeZones)
+	{
+		const bool isAgentInside{ m_Agent.Position.DistanceSquared(purgeZone.Info.Center) < purgeZone.Info.Radius * purgeZone.Info.Radius };
+
+		if (isAgentInside || IsPointInFov(purgeZone.Entity.Location))
+		{
+			m_EntitiesInFov.push_back(purgeZone.Entity);
+		}
+	}
+}
+
+//Spawning
+void HeadlessExamInterface::SpawnItem()
+{
+	std::uniform_int_distribution<size_t> houseDistribution{ 0, m_Level.Houses.size() - 1 };
+	const HeadlessHouse& house{ m_Level.Houses[houseDistribution(m_RandomEngine)] };
+
+	const Vector2 halfSize{ house.Size / 2.f - Vector2{ 2.f, 2.f } };
+
+	SimItem item{};
+	item.Entity.Type = eEntityType::ITEM;
+	item.Entity.Location = house.Center + Vector2{ RandomFloat(-halfSize.x, halfSize.x), RandomFloat(-halfSize.y, halfSize.y) };
+	item.Entity.EntityHash = m_NextHash++;
+
+	item.Info.Location = item.Entity.Location;
+	item.Info.ItemHash = m_NextHash++;
+
+	int value{};
+	const float roll{ RandomFloat(0.f, 1.f) };
+	if (roll < 0.2f)
+	{
+		item.Info.Type = eItemType::PISTOL;
+		value = static_cast<int>(RandomFloat(10.f, 20.f));
+	}
+	else if (roll < 0.3f)
+	{
+		item.Info.Type = eItemType::SHOTGUN;
+		value = static_cast<int>(RandomFloat(5.f, 10.f));
+	}
+	else if (roll < 0.5f)
+	{
+		item.Info.Type = eItemType::MEDKIT;
+		value = static_cast<int>(RandomFloat(2.f, 6.f));
+	}
+	else if (roll < 0.8f)
+	{
+		item.Info.Type = eItemType::FOOD;
+		value = static_cast<int>(RandomFloat(3.f, 7.f));
+	}
+	else
+	{
+		item.Info.Type = eItemType::GARBAGE;
+	}
+
+	m_ItemValues[item.Info.ItemHash] = value;
+	AddEntity(m_Items, m_ItemIndices, item);
+}
+
+void HeadlessExamInterface::SpawnEnemy()
+{
+	SimEnemy enemy{};
+
+	enemy.Entity.Type = eEntityType::ENEMY;
+	enemy.Entity.EntityHash = m_NextHash++;
+	enemy.Info.EnemyHash = m_NextHash++;
+
+	const float roll{ RandomFloat(0.f, 1.f) };
+	if (roll < 0.6f)
+	{
+		enemy.Info.Type = eEnemyType::ZOMBIE_NORMAL;
+		enemy.Info.Health = 2.f;
+		enemy.Info.Size = 1.5f;
+		enemy.Speed = 3.f;
+		enemy.Damage = 1.f;
+	}
+	else if (roll < 0.85f)
+	{
+		enemy.Info.Type = eEnemyType::ZOMBIE_RUNNER;
+		enemy.Info.Health = 1.f;
+		enemy.Info.Size = 1.2f;
+		enemy.Speed = 5.5f;
+		enemy.Damage = 0.5f;
+	}
+	else
+	{
+		enemy.Info.Type = eEnemyType::ZOMBIE_HEAVY;
+		enemy.Info.Health = 6.f;
+		enemy.Info.Size = 2.5f;
+		enemy.Speed = 2.f;
+		enemy.Damage = 2.f;
+	}
+
+	//Never spawn on top of the agent
+	Vector2 position{};
+	for (int attempt{}; attempt < 10; ++attempt)
+	{
+		position = RandomPositionInWorld(enemy.Info.Size);
+		if (position.DistanceSquared(m_Agent.Position) > enemySpawnDistance * enemySpawnDistance) break;
+	}
+
+	enemy.Info.Location = position;
+	enemy.Entity.Location = position;
+	enemy.WanderTarget = position;
+
+	AddEntity(m_Enemies, m_EnemyIndices, enemy);
+}
+
+void HeadlessExamInterface::SpawnPurgeZone()
+{
+	SimPurgeZone purgeZone{};
+
+	purgeZone.Entity.Type = eEntityType::PURGEZONE;
+	purgeZone.Entity.EntityHash = m_NextHash++;
+
+	purgeZone.Info.Radius = RandomFloat(15.f, 25.f);
+	purgeZone.Info.Center = RandomPositionInWorld(purgeZone.Info.Radius);
+	purgeZone.Info.ZoneHash = m_NextHash++;
+	purgeZone.Entity.Location = purgeZone.Info.Center;
+
+	purgeZone.TimeLeft = purgeZoneFuseTime;
+
+	AddEntity(m_PurgeZones, m_PurgeZoneIndices, purgeZone);
+}
+
+void HeadlessExamInterface::DamageEnemy(SimEnemy& enemy, float damage)
+{
+	++m_Stats.NumEnemiesHit;
+
+	enemy.Info.Health -= damage;
+	if (enemy.Info.Health <= 0.f)
+	{
+		++m_Stats.NumEnemiesKilled;
+		m_Stats.KillCountdown = 60.f;
+	}
+}
+
+void HeadlessExamInterface::RemoveDeadEnemies()
+{
+	auto isDead = [](const SimEnemy& enemy)->bool { return enemy.Info.Health <= 0.f; };
+	RemoveEntities(m_Enemies, m_EnemyIndices, isDead);
+}
+
+bool HeadlessExamInterface::FireWeapon(const ItemInfo& weapon)
+{
+	const Vector2 direction{ OrientationToVector(m_Agent.Orientation) };
+	bool hasHit{ false };
+
+	if (weapon.Type == eItemType::PISTOL)
+	{
+		//First enemy along the ray
+		SimEnemy* pHitEnemy{};
+		float closestDistance{ pistolRange };
+
+		for (SimEnemy& enemy : m_Enemies)
+		{
+			const Vector2 toEnemy{ enemy.Info.Location - m_Agent.Position };
+			const float alongRay{ Dot(toEnemy, direction) };
+
+			if (alongRay < 0.f || alongRay > closestDistance) continue;
+			if (abs(Cross(direction, toEnemy)) > enemy.Info.Size) continue;
+
+			closestDistance = alongRay;
+			pHitEnemy = &enemy;
+		}
+
+		if (pHitEnemy)
+		{
+			DamageEnemy(*pHitEnemy, pistolDamage);
+			hasHit = true;
+		}
+	}
+	else
+	{
+		//Every enemy inside the cone
+		for (SimEnemy& enemy : m_Enemies)
+		{
+			const Vector2 toEnemy{ enemy.Info.Location - m_Agent.Position };
+
+			if (toEnemy.MagnitudeSquared() > shotgunRange * shotgunRange) continue;
+			if (abs(AngleBetween(direction, toEnemy)) > shotgunHalfAngle) continue;
+
+			DamageEnemy(enemy, shotgunDamage);
+			hasHit = true;
+		}
+	}
+
+	if (!hasHit)
+	{
+		++m_Stats.NumMissedShots;
+	}
+
+	RemoveDeadEnemies();
+	return hasHit;
+}
+
+//FOV
+bool HeadlessExamInterface::Fov_GetHouseByIndex(UINT index, HouseInfo& houseInfo) const
+{
+	if (index >= m_HousesInFov.size()) return false;
+
+	houseInfo = m_HousesInFov[index];
+	return true;
+}
+
+bool HeadlessExamInterface::Fov_GetEntityByIndex(UINT index, EntityInfo& entityInfo) const
+{
+	if (index >= m_EntitiesInFov.size()) return false;
+
+	entityInfo = m_EntitiesInFov[index];
+	return true;
+}
+
+bool HeadlessExamInterface::Enemy_GetInfo(EntityInfo entity, EnemyInfo& enemy)
+{
+	const SimEnemy* pEnemy{ FindEntity(m_Enemies, m_EnemyIndices, entity) };
+	if (!pEnemy) return false;
+
+	enemy = pEnemy->Info;
+	return true;
+}
+
+//NAVMESH
+Elite::Vector2 HeadlessExamInterface::NavMesh_GetClosestPathPoint(Elite::Vector2 goal) const
+{
+	goal = ClampToWorld(goal);
+
+	const Vector2 start{ m_Agent.Position };
+	const Vector2 segment{ goal - start };
+	const float margin{ m_Agent.AgentSize };
+
+	//Closest house blocking the straight line (slab test)
+	const HeadlessHouse* pBlockingHouse{};
+	float closestHit{ 1.f };
+
+	for (const HeadlessHouse& house : m_Level.Houses)
+	{
+		if (IsInsideHouse(house, start, margin) || IsInsideHouse(house, goal, margin)) continue;
+
+		const Vector2 minimum{ house.Center - house.Size / 2.f - Vector2{ margin, margin } };
+		const Vector2 maximum{ house.Center + house.Size / 2.f + Vector2{ margin, margin } };
+
+		float entry{ 0.f };
+		float exit{ 1.f };
+		bool isMissed{ false };
+
+		for (int axis{}; axis < 2 && !isMissed; ++axis)
+		{
+			const float origin{ axis == 0 ? start.x : start.y };
+			const float delta{ axis == 0 ? segment.x : segment.y };
+			const float low{ axis == 0 ? minimum.x : minimum.y };
+			const float high{ axis == 0 ? maximum.x : maximum.y };
+
+			if (abs(delta) < FLT_EPSILON)
+			{
+				isMissed = origin < low || origin > high;
+				continue;
+			}
+
+			float t0{ (low - origin) / delta };
+			float t1{ (high - origin) / delta };
+			if (t0 > t1) std::swap(t0, t1);
+
+			entry = (std::max)(entry, t0);
+			exit = (std::min)(exit, t1);
+			isMissed = entry > exit;
+		}
+
+		if (!isMissed && entry < closestHit)
+		{
+			closestHit = entry;
+			pBlockingHouse = &house;
+		}
+	}
+
+	if (!pBlockingHouse) return goal;
+
+	//Walk around the shortest corner
+	const Vector2 halfSize{ pBlockingHouse->Size / 2.f + Vector2{ margin * 2.f, margin * 2.f } };
+	const Vector2 corners[4]
+	{
+		pBlockingHouse->Center + Vector2{ -halfSize.x, -halfSize.y },
+		pBlockingHouse->Center + Vector2{ halfSize.x, -halfSize.y },
+		pBlockingHouse->Center + Vector2{ halfSize.x, halfSize.y },
+		pBlockingHouse->Center + Vector2{ -halfSize.x, halfSize.y }
+	};
+
+	Vector2 bestCorner{ goal };
+	float bestLength{ FLT_MAX };
+
+	for (const Vector2& corner : corners)
+	{
+		if (corner.DistanceSquared(start) < 1.f) continue;
+
+		const float length{ start.Distance(corner) + corner.Distance(goal) };
+		if (length < bestLength)
+		{
+			bestLength = length;
+			bestCorner = corner;
+		}
+	}
+
+	return ClampToWorld(bestCorner);
+}
+
+//INVENTORY
+bool HeadlessExamInterface::Inventory_AddItem(UINT slotId, ItemInfo item)
+{
+	if (slotId >= m_Inventory.size() || m_Inventory[slotId].IsOccupied) return false;
+
+	auto compareItem = [&](const ItemInfo& grabbedItem) -> bool { return grabbedItem.ItemHash == item.ItemHash; };
+	auto iterator = std::find_if(m_GrabbedItems.begin(), m_GrabbedItems.end(), compareItem);
+
+	if (iterator == m_GrabbedItems.end()) return false;
+
+	m_Inventory[slotId].IsOccupied = true;
+	m_Inventory[slotId].Info = *iterator;
+
+	m_GrabbedItems.erase(iterator);
+	return true;
+}
+
+bool HeadlessExamInterface::Inventory_UseItem(UINT slotId)
+{
+	if (slotId >= m_Inventory.size() || !m_Inventory[slotId].IsOccupied) return false;
+
+	const ItemInfo& item{ m_Inventory[slotId].Info };
+	int& value{ m_ItemValues[item.ItemHash] };
+
+	switch (item.Type)
+	{
+	case eItemType::PISTOL:
+	case eItemType::SHOTGUN:
+		if (value <= 0) return false;
+		--value;
+		FireWeapon(item);
+		return true;
+	case eItemType::MEDKIT:
+		m_Agent.Health = (std::min)(m_Agent.Health + value, maxStat);
+		value = 0;
+		return true;
+	case eItemType::FOOD:
+		m_Agent.Energy = (std::min)(m_Agent.Energy + value, maxStat);
+		value = 0;
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool HeadlessExamInterface::Inventory_RemoveItem(UINT slotId)
+{
+	if (slotId >= m_Inventory.size() || !m_Inventory[slotId].IsOccupied) return false;
+
+	m_ItemValues.erase(m_Inventory[slotId].Info.ItemHash);
+	m_Inventory[slotId] = InventorySlot{};
+	return true;
+}
+
+bool HeadlessExamInterface::Inventory_GetItem(UINT slotId, ItemInfo& item)
+{
+	if (slotId >= m_Inventory.size() || !m_Inventory[slotId].IsOccupied) return false;
+
+	item = m_Inventory[slotId].Info;
+	return true;
+}
+
+//ITEMS
+bool HeadlessExamInterface::Item_GetInfo(EntityInfo entity, ItemInfo& item)
+{
+	const SimItem* pItem{ FindEntity(m_Items, m_ItemIndices, entity) };
+	if (!pItem) return false;
+
+	item = pItem->Info;
+	return true;
+}
+
+bool HeadlessExamInterface::Item_Grab(EntityInfo entity, ItemInfo& item)
+{
+	const float grabRangeSq{ m_Agent.GrabRange * m_Agent.GrabRange };
+	const SimItem* pItem{};
+
+	if (m_Settings.AutoGrabClosestItem)
+	{
+		float closestDistanceSq{ grabRangeSq };
+		for (const SimItem& simItem : m_Items)
+		{
+			const float distanceSq{ simItem.Entity.Location.DistanceSquared(m_Agent.Position) };
+			if (distanceSq <= closestDistanceSq)
+			{
+				closestDistanceSq = distanceSq;
+				pItem = &simItem;
+			}
+		}
+	}
+	else
+	{
+		pItem = FindEntity(m_Items, m_ItemIndices, entity);
+		if (pItem && pItem->Entity.Location.DistanceSquared(m_Agent.Position) > grabRangeSq)
+		{
+			pItem = nullptr;
+		}
+	}
+
+	if (!pItem) return false;
+
+	item = pItem->Info;
+	m_GrabbedItems.push_back(item);
+
+	RemoveEntity(m_Items, m_ItemIndices, pItem->Entity.EntityHash);
+
+	++m_Stats.NumItemsPickUp;
+	SpawnItem();
+
+	return true;
+}
+
+bool HeadlessExamInterface::Item_Destroy(EntityInfo entity)
+{
+	const SimItem* pItem{ FindEntity(m_Items, m_ItemIndices, entity) };
+	if (!pItem) return false;
+
+	if (pItem->Entity.Location.DistanceSquared(m_Agent.Position) > m_Agent.GrabRange * m_Agent.GrabRange) return false;
+
+	m_ItemValues.erase(pItem->Info.ItemHash);
+
+	RemoveEntity(m_Items, m_ItemIndices, pItem->Entity.EntityHash);
+
+	SpawnItem();
+
+	return true;
+}
+
+int HeadlessExamInterface::GetItemValue(const ItemInfo& item, eItemType firstType, eItemType secondType) const
+{
+	if (item.Type != firstType && item.Type != secondType) return -1;
+
+	auto iterator = m_ItemValues.find(item.ItemHash);
+	return iterator == m_ItemValues.end() ? 0 : iterator->second;
+}
+
+//PURGEZONE
+bool HeadlessExamInterface::PurgeZone_GetInfo(EntityInfo entity, PurgeZoneInfo& zone)
+{
+	const SimPurgeZone* pPurgeZone{ FindEntity(m_PurgeZones, m_PurgeZoneIndices, entity) };
+	if (!pPurgeZone) return false;
+
+	zone = pPurgeZone->Info;
+	return true;
+}
+
+//Geometry helpers
+float HeadlessExamInterface::RandomFloat(float min, float max)
+{
+	std::uniform_real_distribution<float> distribution{ min, max };
+	return distribution(m_RandomEngine);
+}
+
+Elite::Vector2 HeadlessExamInterface::RandomPositionInWorld(float margin)
+{
+	const Vector2 halfSize{ m_Level.World.Dimensions / 2.f - Vector2{ margin, margin } };
+	return m_Level.World.Center + Vector2{ RandomFloat(-halfSize.x, halfSize.x), RandomFloat(-halfSize.y, halfSize.y) };
+}
+
+Elite::Vector2 HeadlessExamInterface::ClampToWorld(const Elite::Vector2& position) const
+{
+	const Vector2 minimum{ m_Level.World.Center - m_Level.World.Dimensions / 2.f };
+	const Vector2 maximum{ m_Level.World.Center + m_Level.World.Dimensions / 2.f };
+
+	return Vector2{ Clamp(position.x, minimum.x, maximum.x), Clamp(position.y, minimum.y, maximum.y) };
+}
+
+bool HeadlessExamInterface::IsInsideHouse(const HouseInfo& house, const Elite::Vector2& position, float margin) const
+{
+	const Vector2 distance{ position - house.Center };
+	return abs(distance.x) < house.Size.x / 2.f + margin && abs(distance.y) < house.Size.y / 2.f + margin;
+}
+
+bool HeadlessExamInterface::IsPointInFov(const Elite::Vector2& point) const
+{
+	const Vector2 toPoint{ point - m_Agent.Position };
+	const float distanceSq{ toPoint.MagnitudeSquared() };
+
+	if (distanceSq > m_Agent.FOV_Range * m_Agent.FOV_Range) return false;
+	if (distanceSq < FLT_EPSILON) return true;
+
+	return abs(AngleBetween(OrientationToVector(m_Agent.Orientation), toPoint)) <= m_Agent.FOV_Angle / 2.f;
+}
+
+bool HeadlessExamInterface::IsHouseInFov(const HouseInfo& house) const
+{
+	if (IsInsideHouse(house, m_Agent.Position, 0.f)) return true;
+
+	const Vector2 halfSize{ house.Size / 2.f };
+	const Vector2 closestPoint
+	{
+		Clamp(m_Agent.Position.x, house.Center.x - halfSize.x, house.Center.x + halfSize.x),
+		Clamp(m_Agent.Position.y, house.Center.y - halfSize.y, house.Center.y + halfSize.y)
+	};
+
+	const Vector2 samplePoints[6]
+	{
+		closestPoint,
+		house.Center,
+		house.Center + Vector2{ -halfSize.x, -halfSize.y },
+		house.Center + Vector2{ halfSize.x, -halfSize.y },
+		house.Center + Vector2{ halfSize.x, halfSize.y },
+		house.Center + Vector2{ -halfSize.x, halfSize.y }
+	};
+
+	for (const Vector2& samplePoint : samplePoints)
+	{
+		if (IsPointInFov(samplePoint)) return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,176 @@
+#pragma once
+#include <unordered_map>
+#include "HeadlessLevel.h"
+#include "IExamInterface.h"
+
+//Settings of a single headless run, mirrors the parts of GameDebugParams the simulation uses
+struct HeadlessSettings
+{
+	std::string LevelFile{ "GameLevel.gppl" };
+	int Seed{ 0 };
+	bool SpawnEnemies{ true };
+	int EnemyCount{ 20 };
+	int ItemCount{ 40 };
+	bool GodMode{ false };
+	bool AutoGrabClosestItem{ true };
+	bool InfiniteStamina{ false };
+	float PurgeZoneInterval{ 60.f };
+	float FOVRange{ 25.f };
+	float FOVAngle{ static_cast<float>(E_PI_2) };
+};
+
+//IExamInterface implementation without renderer, physics or input
+//Walls are ignored, houses only block the straight line in NavMesh_GetClosestPathPoint
+class HeadlessExamInterface final : public IExamInterface
+{
+public:
+	HeadlessExamInterface(const HeadlessLevel& level, const HeadlessSettings& settings);
+	~HeadlessExamInterface() = default;
+
+	HeadlessExamInterface(const HeadlessExamInterface& other) = delete;
+	HeadlessExamInterface& operator=(const HeadlessExamInterface& other) = delete;
+	HeadlessExamInterface(HeadlessExamInterface&& other) = delete;
+	HeadlessExamInterface& operator=(HeadlessExamInterface&& other) = delete;
+
+	//Simulation
+	void Step(const SteeringPlugin_Output& steering, float dt);
+	bool IsAgentDead() const { return m_Agent.Death; }
+	bool IsShutdownRequested() const { return m_IsShutdownRequested; }
+
+	//WORLD & ENTITIES
+	WorldInfo World_GetInfo() const override { return m_Level.World; }
+	StatisticsInfo World_GetStats() const override { return m_Stats; }
+
+	bool Fov_GetHouseByIndex(UINT index, HouseInfo& houseInfo) const override;
+	bool Fov_GetEntityByIndex(UINT index, EntityInfo& entityInfo) const override;
+
+	AgentInfo Agent_GetInfo() const override { return m_Agent; }
+	bool Enemy_GetInfo(EntityInfo entity, EnemyInfo& enemy) override;
+
+	//NAVMESH
+	Elite::Vector2 NavMesh_GetClosestPathPoint(Elite::Vector2 goal) const override;
+
+	//INVENTORY
+	bool Inventory_AddItem(UINT slotId, ItemInfo item) override;
+	bool Inventory_UseItem(UINT slotId) override;
+	bool Inventory_RemoveItem(UINT slotId) override;
+	bool Inventory_GetItem(UINT slotId, ItemInfo& item) override;
+	UINT Inventory_GetCapacity() const override { return static_cast<UINT>(m_Inventory.size()); }
+
+	bool Item_GetInfo(EntityInfo entity, ItemInfo& item) override;
+	bool Item_Grab(EntityInfo entity, ItemInfo& item) override;
+	bool Item_Destroy(EntityInfo entity) override;
+
+	int Weapon_GetAmmo(ItemInfo& item) override { return GetItemValue(item, eItemType::PISTOL, eItemType::SHOTGUN); }
+	int Medkit_GetHealth(ItemInfo& item) override { return GetItemValue(item, eItemType::MEDKIT, eItemType::MEDKIT); }
+	int Food_GetEnergy(ItemInfo& item) override { return GetItemValue(item, eItemType::FOOD, eItemType::FOOD); }
+
+	//PURGEZONE
+	bool PurgeZone_GetInfo(EntityInfo entity, PurgeZoneInfo& zone) override;
+
+	//DEBUG
+	Elite::Vector2 Debug_ConvertScreenToWorld(Elite::Vector2 screenPos) const override { return screenPos; }
+	Elite::Vector2 Debug_ConvertWorldToScreen(Elite::Vector2 worldPos) const override { return worldPos; }
+
+	//INPUT
+	bool Input_IsKeyboardKeyDown(Elite::InputScancode) const override { return false; }
+	bool Input_IsKeyboardKeyUp(Elite::InputScancode) const override { return false; }
+	bool Input_IsMouseButtonDown(Elite::InputMouseButton) const override { return false; }
+	bool Input_IsMouseButtonUp(Elite::InputMouseButton) const override { return false; }
+	Elite::MouseData Input_GetMouseData(Elite::InputType, Elite::InputMouseButton) const override { return Elite::MouseData{}; }
+
+	//EVENT
+	void RequestShutdown() const override { m_IsShutdownRequested = true; }
+
+	//RENDERER (nothing is drawn)
+	void Draw_Polygon(const Elite::Vector2*, int, const Elite::Vector3&, float) override {}
+	void Draw_SolidPolygon(const Elite::Vector2*, int, const Elite::Vector3&, float, bool) override {}
+	void Draw_Circle(const Elite::Vector2&, float, const Elite::Vector3&, float) override {}
+	void Draw_SolidCircle(const Elite::Vector2&, float32, const Elite::Vector2&, const Elite::Vector3&, float) override {}
+	void Draw_Segment(const Elite::Vector2&, const Elite::Vector2&, const Elite::Vector3&, float) override {}
+	void Draw_Direction(const Elite::Vector2&, Elite::Vector2, float, const Elite::Vector3&, float) override {}
+	void Draw_Transform(const b2Transform&, float) override {}
+	void Draw_Point(const Elite::Vector2&, float, const Elite::Vector3&, float) override {}
+	float NextDepthSlice() override { return 0.f; }
+
+private:
+	struct SimItem
+	{
+		EntityInfo Entity{};
+		ItemInfo Info{};
+	};
+
+	struct SimEnemy
+	{
+		EntityInfo Entity{};
+		EnemyInfo Info{};
+		float Speed{};
+		float Damage{};
+		float AttackCooldown{};
+		Elite::Vector2 WanderTarget{};
+	};
+
+	struct SimPurgeZone
+	{
+		EntityInfo Entity{};
+		PurgeZoneInfo Info{};
+		float TimeLeft{};
+	};
+
+	struct InventorySlot
+	{
+		bool IsOccupied{ false };
+		ItemInfo Info{};
+	};
+
+	const HeadlessLevel& m_Level;
+	const HeadlessSettings m_Settings;
+	std::mt19937 m_RandomEngine;
+
+	AgentInfo m_Agent{};
+	StatisticsInfo m_Stats{};
+	float m_WasBittenTime{};
+	mutable bool m_IsShutdownRequested{ false };
+
+	//Spawn order, which the field of view and the weapons follow, with the index of every entity hash beside it
+	std::vector<SimItem> m_Items{};
+	std::vector<SimEnemy> m_Enemies{};
+	std::vector<SimPurgeZone> m_PurgeZones{};
+	std::unordered_map<int, size_t> m_ItemIndices{};
+	std::unordered_map<int, size_t> m_EnemyIndices{};
+	std::unordered_map<int, size_t> m_PurgeZoneIndices{};
+	std::vector<ItemInfo> m_GrabbedItems{};
+	std::vector<InventorySlot> m_Inventory{};
+	std::unordered_map<int, int> m_ItemValues{};
+	int m_NextHash{ 1 };
+
+	float m_EnemyRespawnTime{};
+	float m_PurgeZoneSpawnTime{};
+
+	//Field of view, rebuilt at the end of every step
+	std::vector<HouseInfo> m_HousesInFov{};
+	std::vector<EntityInfo> m_EntitiesInFov{};
+
+	//Simulation helpers
+	void UpdateAgent(const SteeringPlugin_Output& steering, float dt);
+	void UpdateEnemies(float dt);
+	void UpdatePurgeZones(float dt);
+	void UpdateFov();
+
+	void SpawnItem();
+	void SpawnEnemy();
+	void SpawnPurgeZone();
+	void DamageEnemy(SimEnemy& enemy, float damage);
+	void RemoveDeadEnemies();
+	bool FireWeapon(const ItemInfo& weapon);
+
+	int GetItemValue(const ItemInfo& item, eItemType firstType, eItemType secondType) const;
+
+	//Geometry helpers
+	float RandomFloat(float min, float max);
+	Elite::Vector2 RandomPositionInWorld(float margin);
+	Elite::Vector2 ClampToWorld(const Elite::Vector2& position) const;
+	bool IsInsideHouse(const HouseInfo& house, const Elite::Vector2& position, float margin) const;
+	bool IsPointInFov(const Elite::Vector2& point) const;
+	bool IsHouseInFov(const HouseInfo& house) const;
+};
@@ -0,0 +1,83 @@
+#include "stdafx.h"
+#include "HeadlessLevel.h"
+
+namespace
+{
+	//Binary layout (little endian, 4 byte fields):
+	//  world dimensions (2 floats), nrHouses
+	//  per house: center, size, nrWalls, walls, nrOutlines, outlines
+	//  per polygon: nrPoints, points (2 floats each)
+	class LevelReader final
+	{
+	public:
+		explicit LevelReader(std::ifstream& file) : m_File(file) {}
+
+		bool Read(int& value) { return ReadRaw(&value, sizeof(value)); }
+		bool Read(float& value) { return ReadRaw(&value, sizeof(value)); }
+		bool Read(Elite::Vector2& value) { return Read(value.x) && Read(value.y); }
+
+		bool Read(std::vector<std::vector<Elite::Vector2>>& polygons)
+		{
+			int nrPolygons{};
+			if (!Read(nrPolygons) || nrPolygons < 0) return false;
+
+			polygons.resize(nrPolygons);
+			for (std::vector<Elite::Vector2>& polygon : polygons)
+			{
+				int nrPoints{};
+				if (!Read(nrPoints) || nrPoints < 0) return false;
+
+				polygon.resize(nrPoints);
+				for (Elite::Vector2& point : polygon)
+				{
+					if (!Read(point)) return false;
+				}
+			}
+
+			return true;
+		}
+
+	private:
+		std::ifstream& m_File;
+
+		bool ReadRaw(void* pData, size_t size)
+		{
+			m_File.read(static_cast<char*>(pData), size);
+			return static_cast<size_t>(m_File.gcount()) == size;
+		}
+	};
+}
+
+bool LoadHeadlessLevel(const std::string& path, HeadlessLevel& level)
+{
+	std::ifstream file{ path, std::ios::binary };
+	if (!file)
+	{
+		std::cout << "Level '" << path << "' could not be opened\n";
+		return false;
+	}
+
+	LevelReader reader{ file };
+
+	level = HeadlessLevel{};
+	level.World.Center = Elite::ZeroVector2;
+
+	int nrHouses{};
+	if (!reader.Read(level.World.Dimensions) || !reader.Read(nrHouses) || nrHouses < 0)
+	{
+		std::cout << "Level '" << path << "' has an invalid header\n";
+		return false;
+	}
+
+	level.Houses.resize(nrHouses);
+	for (HeadlessHouse& house : level.Houses)
+	{
+		if (!reader.Read(house.Center) || !reader.Read(house.Size) || !reader.Read(house.Walls) || !reader.Read(house.Outlines))
+		{
+			std::cout << "Level '" << path << "' is truncated\n";
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "stdafx.h"
+#include "Exam_HelperStructs.h"
+
+//Level data as stored in the .gppl files of the exam framework
+struct HeadlessHouse : public HouseInfo
+{
+	std::vector<std::vector<Elite::Vector2>> Walls{};
+	std::vector<std::vector<Elite::Vector2>> Outlines{};
+};
+
+struct HeadlessLevel
+{
+	WorldInfo World{};
+	std::vector<HeadlessHouse> Houses{};
+};
+
+//Reads a .gppl level file, returns false when the file is missing or truncated
+bool LoadHeadlessLevel(const std::string& path, HeadlessLevel& level);
@@ -0,0 +1,89 @@
+#include "stdafx.h"
+#include "HeadlessRunner.h"
+
+//Usage: Headless [--level file.gppl] [--ticks n] [--dt seconds] [--seed n] [--enemies n] [--keep-running] [--record trace]
+//       Headless --replay trace
+namespace
+{
+	bool ParseArguments(int argc, char* argv[], HeadlessRunSettings& settings, std::string& replayFile)
+	{
+		for (int index{ 1 }; index < argc; ++index)
+		{
+			const std::string argument{ argv[index] };
+
+			if (argument == "--keep-running")
+			{
+				settings.StopOnDeath = false;
+				continue;
+			}
+
+			if (index + 1 >= argc)
+			{
+				std::cout << "Missing value for '" << argument << "'\n";
+				return false;
+			}
+
+			const char* pValue{ argv[++index] };
+
+			if (argument == "--level") settings.LevelFile = pValue;
+			else if (argument == "--ticks") settings.Ticks = atoi(pValue);
+			else if (argument == "--dt") settings.DeltaTime = static_cast<float>(atof(pValue));
+			else if (argument == "--seed") settings.Seed = atoi(pValue);
+			else if (argument == "--enemies") settings.EnemyCount = atoi(pValue);
+			else if (argument == "--record") settings.RecordFile = pValue;
+			else if (argument == "--replay") replayFile = pValue;
+			else
+			{
+				std::cout << "Unknown argument '" << argument << "'\n";
+				return false;
+			}
+		}
+
+		if (settings.Ticks <= 0 || settings.DeltaTime <= 0.f)
+		{
+			std::cout << "Ticks and dt have to be positive\n";
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	HeadlessRunSettings settings{};
+	std::string replayFile{};
+	if (!ParseArguments(argc, argv, settings, replayFile)) return 1;
+
+	const bool isReplay{ !replayFile.empty() };
+
+	HeadlessRunResult result{};
+	if (isReplay ? !ReplayHeadless(replayFile, result) : !RunHeadless(settings, result)) return 1;
+
+	const double ticksPerSecond{ result.WallTime > 0.0 ? result.TicksRun / result.WallTime : 0.0 };
+
+	if (isReplay)
+	{
+		printf("Ticks:          %d replayed%s\n", result.TicksRun, result.HasDiverged ? ", DIVERGED" : "");
+	}
+	else
+	{
+		printf("Ticks:          %d (%.1f s simulated)\n", result.TicksRun, result.TicksRun * settings.DeltaTime);
+	}
+
+	printf("Ticks/sec:      %.1f\n", ticksPerSecond);
+	printf("UpdateSteering: p50 %.2f us, p90 %.2f us, p99 %.2f us, p99.9 %.2f us, max %.2f us\n",
+		GetPercentile(result.SteeringLatencies, 50.0),
+		GetPercentile(result.SteeringLatencies, 90.0),
+		GetPercentile(result.SteeringLatencies, 99.0),
+		GetPercentile(result.SteeringLatencies, 99.9),
+		GetPercentile(result.SteeringLatencies, 100.0));
+
+	if (isReplay) return result.HasDiverged ? 1 : 0;
+
+	printf("Survived:       %.1f s, score %d, %s\n", result.Stats.TimeSurvived, result.Stats.Score, result.IsAgentDead ? "dead" : "alive");
+	printf("Enemies:        %d killed, %d hit, %d missed shots\n", result.Stats.NumEnemiesKilled, result.Stats.NumEnemiesHit, result.Stats.NumMissedShots);
+	printf("Items:          %d picked up\n", result.Stats.NumItemsPickUp);
+
+	return 0;
+}
@@ -0,0 +1,11 @@
+#pragma once
+//What the framework headers get from windows.h, SDL and Box2D in the exam build, for the headless host
+#include <Box2D/Common/b2Math.h>
+
+#ifndef _WIN32
+typedef unsigned int UINT;
+#endif
+
+//FMatrix.h uses the unqualified min and max of windows.h
+using std::min;
+using std::max;
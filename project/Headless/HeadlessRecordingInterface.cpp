@@ -0,0 +1,308 @@
+#include "stdafx.h"
+#include "HeadlessRecordingInterface.h"
+
+HeadlessRecordingInterface::HeadlessRecordingInterface(IExamInterface& examInterface, const std::string& traceFile)
+	: m_Interface(examInterface)
+	, m_Writer{ traceFile }
+{
+}
+
+void HeadlessRecordingInterface::BeginTick(float dt)
+{
+	m_Writer.Write(eTraceRecord::TickBegin);
+	m_Writer.Write(dt);
+}
+
+void HeadlessRecordingInterface::EndTick(const SteeringPlugin_Output& steering)
+{
+	m_Writer.Write(eTraceRecord::TickEnd);
+	m_Writer.Write(steering);
+}
+
+//WORLD & ENTITIES
+WorldInfo HeadlessRecordingInterface::World_GetInfo() const
+{
+	const WorldInfo result{ m_Interface.World_GetInfo() };
+
+	m_Writer.Write(eTraceRecord::World_GetInfo);
+	m_Writer.Write(result);
+	return result;
+}
+
+StatisticsInfo HeadlessRecordingInterface::World_GetStats() const
+{
+	const StatisticsInfo result{ m_Interface.World_GetStats() };
+
+	m_Writer.Write(eTraceRecord::World_GetStats);
+	m_Writer.Write(result);
+	return result;
+}
+
+bool HeadlessRecordingInterface::Fov_GetHouseByIndex(UINT index, HouseInfo& houseInfo) const
+{
+	const bool result{ m_Interface.Fov_GetHouseByIndex(index, houseInfo) };
+
+	m_Writer.Write(eTraceRecord::Fov_GetHouseByIndex);
+	m_Writer.Write(index);
+	m_Writer.Write(result);
+	m_Writer.Write(houseInfo);
+	return result;
+}
+
+bool HeadlessRecordingInterface::Fov_GetEntityByIndex(UINT index, EntityInfo& entityInfo) const
+{
+	const bool result{ m_Interface.Fov_GetEntityByIndex(index, entityInfo) };
+
+	m_Writer.Write(eTraceRecord::Fov_GetEntityByIndex);
+	m_Writer.Write(index);
+	m_Writer.Write(result);
+	m_Writer.Write(entityInfo);
+	return result;
+}
+
+AgentInfo HeadlessRecordingInterface::Agent_GetInfo() const
+{
+	const AgentInfo result{ m_Interface.Agent_GetInfo() };
+
+	m_Writer.Write(eTraceRecord::Agent_GetInfo);
+	m_Writer.Write(result);
+	return result;
+}
+
+bool HeadlessRecordingInterface::Enemy_GetInfo(EntityInfo entity, EnemyInfo& enemy)
+{
+	const bool result{ m_Interface.Enemy_GetInfo(entity, enemy) };
+
+	m_Writer.Write(eTraceRecord::Enemy_GetInfo);
+	m_Writer.Write(entity.EntityHash);
+	m_Writer.Write(result);
+	m_Writer.Write(enemy);
+	return result;
+}
+
+//NAVMESH
+Elite::Vector2 HeadlessRecordingInterface::NavMesh_GetClosestPathPoint(Elite::Vector2 goal) const
+{
+	const Elite::Vector2 result{ m_Interface.NavMesh_GetClosestPathPoint(goal) };
+
+	m_Writer.Write(eTraceRecord::NavMesh_GetClosestPathPoint);
+	m_Writer.Write(goal);
+	m_Writer.Write(result);
+	return result;
+}
+
+//INVENTORY
+bool HeadlessRecordingInterface::Inventory_AddItem(UINT slotId, ItemInfo item)
+{
+	const bool result{ m_Interface.Inventory_AddItem(slotId, item) };
+
+	m_Writer.Write(eTraceRecord::Inventory_AddItem);
+	m_Writer.Write(slotId);
+	m_Writer.Write(item.ItemHash);
+	m_Writer.Write(result);
+	return result;
+}
+
+bool HeadlessRecordingInterface::Inventory_UseItem(UINT slotId)
+{
+	const bool result{ m_Interface.Inventory_UseItem(slotId) };
+
+	m_Writer.Write(eTraceRecord::Inventory_UseItem);
+	m_Writer.Write(slotId);
+	m_Writer.Write(result);
+	return result;
+}
+
+bool HeadlessRecordingInterface::Inventory_RemoveItem(UINT slotId)
+{
+	const bool result{ m_Interface.Inventory_RemoveItem(slotId) };
+
+	m_Writer.Write(eTraceRecord::Inventory_RemoveItem);
+	m_Writer.Write(slotId);
+	m_Writer.Write(result);
+	return result;
+}
+
+bool HeadlessRecordingInterface::Inventory_GetItem(UINT slotId, ItemInfo& item)
+{
+	const bool result{ m_Interface.Inventory_GetItem(slotId, item) };
+
+	m_Writer.Write(eTraceRecord::Inventory_GetItem);
+	m_Writer.Write(slotId);
+	m_Writer.Write(result);
+	m_Writer.Write(item);
+	return result;
+}
+
+UINT HeadlessRecordingInterface::Inventory_GetCapacity() const
+{
+	const UINT result{ m_Interface.Inventory_GetCapacity() };
+
+	m_Writer.Write(eTraceRecord::Inventory_GetCapacity);
+	m_Writer.Write(result);
+	return result;
+}
+
+bool HeadlessRecordingInterface::Item_GetInfo(EntityInfo entity, ItemInfo& item)
+{
+	const bool result{ m_Interface.Item_GetInfo(entity, item) };
+
+	m_Writer.Write(eTraceRecord::Item_GetInfo);
+	m_Writer.Write(entity.EntityHash);
+	m_Writer.Write(result);
+	m_Writer.Write(item);
+	return result;
+}
+
+bool HeadlessRecordingInterface::Item_Grab(EntityInfo entity, ItemInfo& item)
+{
+	const bool result{ m_Interface.Item_Grab(entity, item) };
+
+	m_Writer.Write(eTraceRecord::Item_Grab);
+	m_Writer.Write(entity.EntityHash);
+	m_Writer.Write(result);
+	m_Writer.Write(item);
+	return result;
+}
+
+bool HeadlessRecordingInterface::Item_Destroy(EntityInfo entity)
+{
+	const bool result{ m_Interface.Item_Destroy(entity) };
+
+	m_Writer.Write(eTraceRecord::Item_Destroy);
+	m_Writer.Write(entity.EntityHash);
+	m_Writer.Write(result);
+	return result;
+}
+
+int HeadlessRecordingInterface::Weapon_GetAmmo(ItemInfo& item)
+{
+	const int result{ m_Interface.Weapon_GetAmmo(item) };
+
+	m_Writer.Write(eTraceRecord::Weapon_GetAmmo);
+	m_Writer.Write(item.ItemHash);
+	m_Writer.Write(result);
+	return result;
+}
+
+int HeadlessRecordingInterface::Medkit_GetHealth(ItemInfo& item)
+{
+	const int result{ m_Interface.Medkit_GetHealth(item) };
+
+	m_Writer.Write(eTraceRecord::Medkit_GetHealth);
+	m_Writer.Write(item.ItemHash);
+	m_Writer.Write(result);
+	return result;
+}
+
+int HeadlessRecordingInterface::Food_GetEnergy(ItemInfo& item)
+{
+	const int result{ m_Interface.Food_GetEnergy(item) };
+
+	m_Writer.Write(eTraceRecord::Food_GetEnergy);
+	m_Writer.Write(item.ItemHash);
+	m_Writer.Write(result);
+	return result;
+}
+
+//PURGEZONE
+bool HeadlessRecordingInterface::PurgeZone_GetInfo(EntityInfo entity, PurgeZoneInfo& zone)
+{
+	const bool result{ m_Interface.PurgeZone_GetInfo(entity, zone) };
+
+	m_Writer.Write(eTraceRecord::PurgeZone_GetInfo);
+	m_Writer.Write(entity.EntityHash);
+	m_Writer.Write(result);
+	m_Writer.Write(zone);
+	return result;
+}
+
+//DEBUG
+Elite::Vector2 HeadlessRecordingInterface::Debug_ConvertScreenToWorld(Elite::Vector2 screenPos) const
+{
+	const Elite::Vector2 result{ m_Interface.Debug_ConvertScreenToWorld(screenPos) };
+
+	m_Writer.Write(eTraceRecord::Debug_ConvertScreenToWorld);
+	m_Writer.Write(screenPos);
+	m_Writer.Write(result);
+	return result;
+}
+
+Elite::Vector2 HeadlessRecordingInterface::Debug_ConvertWorldToScreen(Elite::Vector2 worldPos) const
+{
+	const Elite::Vector2 result{ m_Interface.Debug_ConvertWorldToScreen(worldPos) };
+
+	m_Writer.Write(eTraceRecord::Debug_ConvertWorldToScreen);
+	m_Writer.Write(worldPos);
+	m_Writer.Write(result);
+	return result;
+}
+
+//INPUT
+bool HeadlessRecordingInterface::Input_IsKeyboardKeyDown(Elite::InputScancode key) const
+{
+	const bool result{ m_Interface.Input_IsKeyboardKeyDown(key) };
+
+	m_Writer.Write(eTraceRecord::Input_IsKeyboardKeyDown);
+	m_Writer.Write(static_cast<int>(key));
+	m_Writer.Write(result);
+	return result;
+}
+
+bool HeadlessRecordingInterface::Input_IsKeyboardKeyUp(Elite::InputScancode key) const
+{
+	const bool result{ m_Interface.Input_IsKeyboardKeyUp(key) };
+
+	m_Writer.Write(eTraceRecord::Input_IsKeyboardKeyUp);
+	m_Writer.Write(static_cast<int>(key));
+	m_Writer.Write(result);
+	return result;
+}
+
+bool HeadlessRecordingInterface::Input_IsMouseButtonDown(Elite::InputMouseButton button) const
+{
+	const bool result{ m_Interface.Input_IsMouseButtonDown(button) };
+
+	m_Writer.Write(eTraceRecord::Input_IsMouseButtonDown);
+	m_Writer.Write(static_cast<int>(button));
+	m_Writer.Write(result);
+	return result;
+}
+
+bool HeadlessRecordingInterface::Input_IsMouseButtonUp(Elite::InputMouseButton button) const
+{
+	const bool result{ m_Interface.Input_IsMouseButtonUp(button) };
+
+	m_Writer.Write(eTraceRecord::Input_IsMouseButtonUp);
+	m_Writer.Write(static_cast<int>(button));
+	m_Writer.Write(result);
+	return result;
+}
+
+Elite::MouseData HeadlessRecordingInterface::Input_GetMouseData(Elite::InputType type, Elite::InputMouseButton button) const
+{
+	const Elite::MouseData result{ m_Interface.Input_GetMouseData(type, button) };
+
+	m_Writer.Write(eTraceRecord::Input_GetMouseData);
+	m_Writer.Write(static_cast<int>(type));
+	m_Writer.Write(static_cast<int>(button));
+	m_Writer.Write(result);
+	return result;
+}
+
+//EVENT
+void HeadlessRecordingInterface::RequestShutdown() const
+{
+	m_Interface.RequestShutdown();
+
+	m_Writer.Write(eTraceRecord::RequestShutdown);
+}
+
+float HeadlessRecordingInterface::NextDepthSlice()
+{
+	const float result{ m_Interface.NextDepthSlice() };
+
+	m_Writer.Write(eTraceRecord::NextDepthSlice);
+	m_Writer.Write(result);
+	return result;
+}
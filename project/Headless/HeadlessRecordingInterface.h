@@ -0,0 +1,82 @@
+#pragma once
+#include "HeadlessTrace.h"
+#include "IExamInterface.h"
+
+//Forwards every call to the wrapped interface and writes the call and its result to a trace
+class HeadlessRecordingInterface final : public IExamInterface
+{
+public:
+	HeadlessRecordingInterface(IExamInterface& examInterface, const std::string& traceFile);
+	~HeadlessRecordingInterface() = default;
+
+	HeadlessRecordingInterface(const HeadlessRecordingInterface& other) = delete;
+	HeadlessRecordingInterface& operator=(const HeadlessRecordingInterface& other) = delete;
+	HeadlessRecordingInterface(HeadlessRecordingInterface&& other) = delete;
+	HeadlessRecordingInterface& operator=(HeadlessRecordingInterface&& other) = delete;
+
+	bool IsRecording() const { return m_Writer.IsOpen(); }
+
+	//Tick boundaries, everything the plugin asks in between belongs to this tick
+	void BeginTick(float dt);
+	void EndTick(const SteeringPlugin_Output& steering);
+
+	//WORLD & ENTITIES
+	WorldInfo World_GetInfo() const override;
+	StatisticsInfo World_GetStats() const override;
+
+	bool Fov_GetHouseByIndex(UINT index, HouseInfo& houseInfo) const override;
+	bool Fov_GetEntityByIndex(UINT index, EntityInfo& entityInfo) const override;
+
+	AgentInfo Agent_GetInfo() const override;
+	bool Enemy_GetInfo(EntityInfo entity, EnemyInfo& enemy) override;
+
+	//NAVMESH
+	Elite::Vector2 NavMesh_GetClosestPathPoint(Elite::Vector2 goal) const override;
+
+	//INVENTORY
+	bool Inventory_AddItem(UINT slotId, ItemInfo item) override;
+	bool Inventory_UseItem(UINT slotId) override;
+	bool Inventory_RemoveItem(UINT slotId) override;
+	bool Inventory_GetItem(UINT slotId, ItemInfo& item) override;
+	UINT Inventory_GetCapacity() const override;
+
+	bool Item_GetInfo(EntityInfo entity, ItemInfo& item) override;
+	bool Item_Grab(EntityInfo entity, ItemInfo& item) override;
+	bool Item_Destroy(EntityInfo entity) override;
+
+	int Weapon_GetAmmo(ItemInfo& item) override;
+	int Medkit_GetHealth(ItemInfo& item) override;
+	int Food_GetEnergy(ItemInfo& item) override;
+
+	//PURGEZONE
+	bool PurgeZone_GetInfo(EntityInfo entity, PurgeZoneInfo& zone) override;
+
+	//DEBUG
+	Elite::Vector2 Debug_ConvertScreenToWorld(Elite::Vector2 screenPos) const override;
+	Elite::Vector2 Debug_ConvertWorldToScreen(Elite::Vector2 worldPos) const override;
+
+	//INPUT
+	bool Input_IsKeyboardKeyDown(Elite::InputScancode key) const override;
+	bool Input_IsKeyboardKeyUp(Elite::InputScancode key) const override;
+	bool Input_IsMouseButtonDown(Elite::InputMouseButton button) const override;
+	bool Input_IsMouseButtonUp(Elite::InputMouseButton button) const override;
+	Elite::MouseData Input_GetMouseData(Elite::InputType type, Elite::InputMouseButton button) const override;
+
+	//EVENT
+	void RequestShutdown() const override;
+
+	//RENDERER (forwarded, not recorded)
+	void Draw_Polygon(const Elite::Vector2* points, int count, const Elite::Vector3& color, float depth) override { m_Interface.Draw_Polygon(points, count, color, depth); }
+	void Draw_SolidPolygon(const Elite::Vector2* points, int count, const Elite::Vector3& color, float depth, bool triangulate) override { m_Interface.Draw_SolidPolygon(points, count, color, depth, triangulate); }
+	void Draw_Circle(const Elite::Vector2& center, float radius, const Elite::Vector3& color, float depth) override { m_Interface.Draw_Circle(center, radius, color, depth); }
+	void Draw_SolidCircle(const Elite::Vector2& center, float32 radius, const Elite::Vector2& axis, const Elite::Vector3& color, float depth) override { m_Interface.Draw_SolidCircle(center, radius, axis, color, depth); }
+	void Draw_Segment(const Elite::Vector2& p1, const Elite::Vector2& p2, const Elite::Vector3& color, float depth) override { m_Interface.Draw_Segment(p1, p2, color, depth); }
+	void Draw_Direction(const Elite::Vector2& p, Elite::Vector2 dir, float length, const Elite::Vector3& color, float depth) override { m_Interface.Draw_Direction(p, dir, length, color, depth); }
+	void Draw_Transform(const b2Transform& xf, float depth) override { m_Interface.Draw_Transform(xf, depth); }
+	void Draw_Point(const Elite::Vector2& p, float size, const Elite::Vector3& color, float depth) override { m_Interface.Draw_Point(p, size, color, depth); }
+	float NextDepthSlice() override;
+
+private:
+	IExamInterface& m_Interface;
+	mutable TraceWriter m_Writer;
+};
@@ -0,0 +1,299 @@
+#include "stdafx.h"
+#include "HeadlessReplayInterface.h"
+
+HeadlessReplayInterface::HeadlessReplayInterface(const std::string& traceFile)
+	: m_Reader{ traceFile }
+{
+}
+
+bool HeadlessReplayInterface::BeginTick(float& dt)
+{
+	if (m_HasDiverged || !m_Reader.IsOpen() || m_Reader.IsAtEnd()) return false;
+
+	m_Reader.ReleaseConsumed();
+
+	if (!Expect(eTraceRecord::TickBegin)) return false;
+
+	ReadResult(dt);
+	++m_TickCount;
+
+	return !m_HasDiverged;
+}
+
+bool HeadlessReplayInterface::EndTick(const SteeringPlugin_Output& steering)
+{
+	if (!Expect(eTraceRecord::TickEnd)) return false;
+
+	const SteeringPlugin_Output recorded{ ReadResult<SteeringPlugin_Output>() };
+	if (m_HasDiverged) return false;
+
+	const bool isSame
+	{
+		recorded.LinearVelocity.x == steering.LinearVelocity.x && recorded.LinearVelocity.y == steering.LinearVelocity.y
+		&& recorded.AngularVelocity == steering.AngularVelocity
+		&& recorded.AutoOrient == steering.AutoOrient && recorded.RunMode == steering.RunMode
+	};
+
+	if (!isSame)
+	{
+		Diverge("steering output differs from the recording");
+	}
+
+	return isSame;
+}
+
+bool HeadlessReplayInterface::Expect(eTraceRecord record) const
+{
+	if (m_HasDiverged) return false;
+
+	eTraceRecord recorded{};
+	if (!m_Reader.Read(recorded))
+	{
+		Diverge(std::string{ "trace ended, plugin called " } + ToString(record));
+		return false;
+	}
+
+	if (recorded != record)
+	{
+		Diverge(std::string{ "plugin called " } + ToString(record) + ", trace has " + ToString(recorded));
+		return false;
+	}
+
+	return true;
+}
+
+bool HeadlessReplayInterface::ExpectArgument(int argument) const
+{
+	const int recorded{ ReadResult<int>() };
+	if (!m_HasDiverged && recorded != argument)
+	{
+		Diverge("argument " + std::to_string(argument) + " differs from recorded " + std::to_string(recorded));
+	}
+
+	return !m_HasDiverged;
+}
+
+bool HeadlessReplayInterface::ExpectArgument(UINT argument) const
+{
+	const UINT recorded{ ReadResult<UINT>() };
+	if (!m_HasDiverged && recorded != argument)
+	{
+		Diverge("argument " + std::to_string(argument) + " differs from recorded " + std::to_string(recorded));
+	}
+
+	return !m_HasDiverged;
+}
+
+bool HeadlessReplayInterface::ExpectArgument(const Elite::Vector2& argument) const
+{
+	const Elite::Vector2 recorded{ ReadResult<Elite::Vector2>() };
+	if (!m_HasDiverged && (recorded.x != argument.x || recorded.y != argument.y))
+	{
+		Diverge("position argument differs from the recording");
+	}
+
+	return !m_HasDiverged;
+}
+
+void HeadlessReplayInterface::Diverge(const std::string& reason) const
+{
+	if (m_HasDiverged) return;
+
+	m_HasDiverged = true;
+	std::cout << "Replay diverged at tick " << m_TickCount << ": " << reason << '\n';
+}
+
+//WORLD & ENTITIES
+WorldInfo HeadlessReplayInterface::World_GetInfo() const
+{
+	if (!Expect(eTraceRecord::World_GetInfo)) return WorldInfo{};
+	return ReadResult<WorldInfo>();
+}
+
+StatisticsInfo HeadlessReplayInterface::World_GetStats() const
+{
+	if (!Expect(eTraceRecord::World_GetStats)) return StatisticsInfo{};
+	return ReadResult<StatisticsInfo>();
+}
+
+bool HeadlessReplayInterface::Fov_GetHouseByIndex(UINT index, HouseInfo& houseInfo) const
+{
+	if (!Expect(eTraceRecord::Fov_GetHouseByIndex) || !ExpectArgument(index)) return false;
+
+	const bool result{ ReadResult<bool>() };
+	ReadResult(houseInfo);
+	return result;
+}
+
+bool HeadlessReplayInterface::Fov_GetEntityByIndex(UINT index, EntityInfo& entityInfo) const
+{
+	if (!Expect(eTraceRecord::Fov_GetEntityByIndex) || !ExpectArgument(index)) return false;
+
+	const bool result{ ReadResult<bool>() };
+	ReadResult(entityInfo);
+	return result;
+}
+
+AgentInfo HeadlessReplayInterface::Agent_GetInfo() const
+{
+	if (!Expect(eTraceRecord::Agent_GetInfo)) return AgentInfo{};
+	return ReadResult<AgentInfo>();
+}
+
+bool HeadlessReplayInterface::Enemy_GetInfo(EntityInfo entity, EnemyInfo& enemy)
+{
+	if (!Expect(eTraceRecord::Enemy_GetInfo) || !ExpectArgument(entity.EntityHash)) return false;
+
+	const bool result{ ReadResult<bool>() };
+	ReadResult(enemy);
+	return result;
+}
+
+//NAVMESH
+Elite::Vector2 HeadlessReplayInterface::NavMesh_GetClosestPathPoint(Elite::Vector2 goal) const
+{
+	if (!Expect(eTraceRecord::NavMesh_GetClosestPathPoint) || !ExpectArgument(goal)) return goal;
+	return ReadResult<Elite::Vector2>();
+}
+
+//INVENTORY
+bool HeadlessReplayInterface::Inventory_AddItem(UINT slotId, ItemInfo item)
+{
+	if (!Expect(eTraceRecord::Inventory_AddItem) || !ExpectArgument(slotId) || !ExpectArgument(item.ItemHash)) return false;
+	return ReadResult<bool>();
+}
+
+bool HeadlessReplayInterface::Inventory_UseItem(UINT slotId)
+{
+	if (!Expect(eTraceRecord::Inventory_UseItem) || !ExpectArgument(slotId)) return false;
+	return ReadResult<bool>();
+}
+
+bool HeadlessReplayInterface::Inventory_RemoveItem(UINT slotId)
+{
+	if (!Expect(eTraceRecord::Inventory_RemoveItem) || !ExpectArgument(slotId)) return false;
+	return ReadResult<bool>();
+}
+
+bool HeadlessReplayInterface::Inventory_GetItem(UINT slotId, ItemInfo& item)
+{
+	if (!Expect(eTraceRecord::Inventory_GetItem) || !ExpectArgument(slotId)) return false;
+
+	const bool result{ ReadResult<bool>() };
+	ReadResult(item);
+	return result;
+}
+
+UINT HeadlessReplayInterface::Inventory_GetCapacity() const
+{
+	if (!Expect(eTraceRecord::Inventory_GetCapacity)) return 0;
+	return ReadResult<UINT>();
+}
+
+bool HeadlessReplayInterface::Item_GetInfo(EntityInfo entity, ItemInfo& item)
+{
+	if (!Expect(eTraceRecord::Item_GetInfo) || !ExpectArgument(entity.EntityHash)) return false;
+
+	const bool result{ ReadResult<bool>() };
+	ReadResult(item);
+	return result;
+}
+
+bool HeadlessReplayInterface::Item_Grab(EntityInfo entity, ItemInfo& item)
+{
+	if (!Expect(eTraceRecord::Item_Grab) || !ExpectArgument(entity.EntityHash)) return false;
+
+	const bool result{ ReadResult<bool>() };
+	ReadResult(item);
+	return result;
+}
+
+bool HeadlessReplayInterface::Item_Destroy(EntityInfo entity)
+{
+	if (!Expect(eTraceRecord::Item_Destroy) || !ExpectArgument(entity.EntityHash)) return false;
+	return ReadResult<bool>();
+}
+
+int HeadlessReplayInterface::Weapon_GetAmmo(ItemInfo& item)
+{
+	if (!Expect(eTraceRecord::Weapon_GetAmmo) || !ExpectArgument(item.ItemHash)) return -1;
+	return ReadResult<int>();
+}
+
+int HeadlessReplayInterface::Medkit_GetHealth(ItemInfo& item)
+{
+	if (!Expect(eTraceRecord::Medkit_GetHealth) || !ExpectArgument(item.ItemHash)) return -1;
+	return ReadResult<int>();
+}
+
+int HeadlessReplayInterface::Food_GetEnergy(ItemInfo& item)
+{
+	if (!Expect(eTraceRecord::Food_GetEnergy) || !ExpectArgument(item.ItemHash)) return -1;
+	return ReadResult<int>();
+}
+
+//PURGEZONE
+bool HeadlessReplayInterface::PurgeZone_GetInfo(EntityInfo entity, PurgeZoneInfo& zone)
+{
+	if (!Expect(eTraceRecord::PurgeZone_GetInfo) || !ExpectArgument(entity.EntityHash)) return false;
+
+	const bool result{ ReadResult<bool>() };
+	ReadResult(zone);
+	return result;
+}
+
+//DEBUG
+Elite::Vector2 HeadlessReplayInterface::Debug_ConvertScreenToWorld(Elite::Vector2 screenPos) const
+{
+	if (!Expect(eTraceRecord::Debug_ConvertScreenToWorld) || !ExpectArgument(screenPos)) return screenPos;
+	return ReadResult<Elite::Vector2>();
+}
+
+Elite::Vector2 HeadlessReplayInterface::Debug_ConvertWorldToScreen(Elite::Vector2 worldPos) const
+{
+	if (!Expect(eTraceRecord::Debug_ConvertWorldToScreen) || !ExpectArgument(worldPos)) return worldPos;
+	return ReadResult<Elite::Vector2>();
+}
+
+//INPUT
+bool HeadlessReplayInterface::Input_IsKeyboardKeyDown(Elite::InputScancode key) const
+{
+	if (!Expect(eTraceRecord::Input_IsKeyboardKeyDown) || !ExpectArgument(static_cast<int>(key))) return false;
+	return ReadResult<bool>();
+}
+
+bool HeadlessReplayInterface::Input_IsKeyboardKeyUp(Elite::InputScancode key) const
+{
+	if (!Expect(eTraceRecord::Input_IsKeyboardKeyUp) || !ExpectArgument(static_cast<int>(key))) return false;
+	return ReadResult<bool>();
+}
+
+bool HeadlessReplayInterface::Input_IsMouseButtonDown(Elite::InputMouseButton button) const
+{
+	if (!Expect(eTraceRecord::Input_IsMouseButtonDown) || !ExpectArgument(static_cast<int>(button))) return false;
+	return ReadResult<bool>();
+}
+
+bool HeadlessReplayInterface::Input_IsMouseButtonUp(Elite::InputMouseButton button) const
+{
+	if (!Expect(eTraceRecord::Input_IsMouseButtonUp) || !ExpectArgument(static_cast<int>(button))) return false;
+	return ReadResult<bool>();
+}
+
+Elite::MouseData HeadlessReplayInterface::Input_GetMouseData(Elite::InputType type, Elite::InputMouseButton button) const
+{
+	if (!Expect(eTraceRecord::Input_GetMouseData) || !ExpectArgument(static_cast<int>(type)) || !ExpectArgument(static_cast<int>(button))) return Elite::MouseData{};
+	return ReadResult<Elite::MouseData>();
+}
+
+//EVENT
+void HeadlessReplayInterface::RequestShutdown() const
+{
+	Expect(eTraceRecord::RequestShutdown);
+}
+
+float HeadlessReplayInterface::NextDepthSlice()
+{
+	if (!Expect(eTraceRecord::NextDepthSlice)) return 0.f;
+	return ReadResult<float>();
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include "HeadlessTrace.h"
+#include "IExamInterface.h"
+
+//Answers the plugin with the data of a recorded trace, there is no simulation behind it
+//The plugin has to ask exactly the same questions as during the recording, the first
+//difference (call, argument or steering output) marks the replay as diverged and ends it
+class HeadlessReplayInterface final : public IExamInterface
+{
+public:
+	explicit HeadlessReplayInterface(const std::string& traceFile);
+	~HeadlessReplayInterface() = default;
+
+	HeadlessReplayInterface(const HeadlessReplayInterface& other) = delete;
+	HeadlessReplayInterface& operator=(const HeadlessReplayInterface& other) = delete;
+	HeadlessReplayInterface(HeadlessReplayInterface&& other) = delete;
+	HeadlessReplayInterface& operator=(HeadlessReplayInterface&& other) = delete;
+
+	bool IsOpen() const { return m_Reader.IsOpen(); }
+	bool HasDiverged() const { return m_HasDiverged; }
+
+	//Returns false at the end of the trace or after a divergence
+	bool BeginTick(float& dt);
+	//Returns false when the plugin steered differently than during the recording
+	bool EndTick(const SteeringPlugin_Output& steering);
+
+	//WORLD & ENTITIES
+	WorldInfo World_GetInfo() const override;
+	StatisticsInfo World_GetStats() const override;
+
+	bool Fov_GetHouseByIndex(UINT index, HouseInfo& houseInfo) const override;
+	bool Fov_GetEntityByIndex(UINT index, EntityInfo& entityInfo) const override;
+
+	AgentInfo Agent_GetInfo() const override;
+	bool Enemy_GetInfo(EntityInfo entity, EnemyInfo& enemy) override;
+
+	//NAVMESH
+	Elite::Vector2 NavMesh_GetClosestPathPoint(Elite::Vector2 goal) const override;
+
+	//INVENTORY
+	bool Inventory_AddItem(UINT slotId, ItemInfo item) override;
+	bool Inventory_UseItem(UINT slotId) override;
+	bool Inventory_RemoveItem(UINT slotId) override;
+	bool Inventory_GetItem(UINT slotId, ItemInfo& item) override;
+	UINT Inventory_GetCapacity() const override;
+
+	bool Item_GetInfo(EntityInfo entity, ItemInfo& item) override;
+	bool Item_Grab(EntityInfo entity, ItemInfo& item) override;
+	bool Item_Destroy(EntityInfo entity) override;
+
+	int Weapon_GetAmmo(ItemInfo& item) override;
+	int Medkit_GetHealth(ItemInfo& item) override;
+	int Food_GetEnergy(ItemInfo& item) override;
+
+	//PURGEZONE
+	bool PurgeZone_GetInfo(EntityInfo entity, PurgeZoneInfo& zone) override;
+
+	//DEBUG
+	Elite::Vector2 Debug_ConvertScreenToWorld(Elite::Vector2 screenPos) const override;
+	Elite::Vector2 Debug_ConvertWorldToScreen(Elite::Vector2 worldPos) const override;
+
+	//INPUT
+	bool Input_IsKeyboardKeyDown(Elite::InputScancode key) const override;
+	bool Input_IsKeyboardKeyUp(Elite::InputScancode key) const override;
+	bool Input_IsMouseButtonDown(Elite::InputMouseButton button) const override;
+	bool Input_IsMouseButtonUp(Elite::InputMouseButton button) const override;
+	Elite::MouseData Input_GetMouseData(Elite::InputType type, Elite::InputMouseButton button) const override;
+
+	//EVENT
+	void RequestShutdown() const override;
+
+	//RENDERER (nothing is drawn)
+	void Draw_Polygon(const Elite::Vector2*, int, const Elite::Vector3&, float) override {}
+	void Draw_SolidPolygon(const Elite::Vector2*, int, const Elite::Vector3&, float, bool) override {}
+	void Draw_Circle(const Elite::Vector2&, float, const Elite::Vector3&, float) override {}
+	void Draw_SolidCircle(const Elite::Vector2&, float32, const Elite::Vector2&, const Elite::Vector3&, float) override {}
+	void Draw_Segment(const Elite::Vector2&, const Elite::Vector2&, const Elite::Vector3&, float) override {}
+	void Draw_Direction(const Elite::Vector2&, Elite::Vector2, float, const Elite::Vector3&, float) override {}
+	void Draw_Transform(const b2Transform&, float) override {}
+	void Draw_Point(const Elite::Vector2&, float, const Elite::Vector3&, float) override {}
+	float NextDepthSlice() override;
+
+private:
+	mutable TraceReader m_Reader;
+	mutable bool m_HasDiverged{ false };
+	int m_TickCount{};
+
+	//Checks the next record against the call the plugin makes
+	bool Expect(eTraceRecord record) const;
+	bool ExpectArgument(int argument) const;
+	bool ExpectArgument(UINT argument) const;
+	bool ExpectArgument(const Elite::Vector2& argument) const;
+
+	template<typename T>
+	T ReadResult() const;
+	template<typename T>
+	void ReadResult(T& value) const;
+
+	void Diverge(const std::string& reason) const;
+};
+
+template<typename T>
+T HeadlessReplayInterface::ReadResult() const
+{
+	T value{};
+	ReadResult(value);
+	return value;
+}
+
+template<typename T>
+void HeadlessReplayInterface::ReadResult(T& value) const
+{
+	if (!m_HasDiverged && !m_Reader.Read(value))
+	{
+		Diverge("trace is truncated");
+	}
+}
@@ -0,0 +1,151 @@
+#include "stdafx.h"
+#include "HeadlessRunner.h"
+#include "HeadlessRecordingInterface.h"
+#include "HeadlessReplayInterface.h"
+#include "IExamPlugin.h"
+
+#include <chrono>
+
+//Defined in Plugin.cpp, the plugin sources are linked into the host
+extern "C" IPluginBase* Register();
+
+namespace
+{
+	HeadlessSettings CreateSettings(const GameDebugParams& params, const HeadlessRunSettings& runSettings)
+	{
+		HeadlessSettings settings{};
+		settings.LevelFile = runSettings.LevelFile.empty() ? params.LevelFile : runSettings.LevelFile;
+		settings.Seed = runSettings.Seed >= 0 ? runSettings.Seed : (std::max)(params.Seed, 0);
+		settings.SpawnEnemies = params.SpawnEnemies;
+		settings.EnemyCount = runSettings.EnemyCount >= 0 ? runSettings.EnemyCount : params.EnemyCount;
+		settings.ItemCount = params.ItemCount;
+		settings.GodMode = params.GodMode;
+		settings.AutoGrabClosestItem = params.AutoGrabClosestItem;
+		settings.InfiniteStamina = params.InfiniteStamina;
+		return settings;
+	}
+}
+
+bool RunHeadless(const HeadlessRunSettings& runSettings, HeadlessRunResult& result)
+{
+	using Clock = std::chrono::steady_clock;
+
+	result = HeadlessRunResult{};
+
+	IExamPlugin* pPlugin{ static_cast<IExamPlugin*>(Register()) };
+	pPlugin->DllInit();
+
+	GameDebugParams params{};
+	pPlugin->InitGameDebugParams(params);
+
+	const HeadlessSettings settings{ CreateSettings(params, runSettings) };
+
+	HeadlessLevel level{};
+	if (!LoadHeadlessLevel(settings.LevelFile, level))
+	{
+		pPlugin->DllShutdown();
+		delete pPlugin;
+		return false;
+	}
+
+	HeadlessExamInterface examInterface{ level, settings };
+
+	std::unique_ptr<HeadlessRecordingInterface> pRecorder{};
+	if (!runSettings.RecordFile.empty())
+	{
+		pRecorder.reset(new HeadlessRecordingInterface{ examInterface, runSettings.RecordFile });
+	}
+
+	PluginInfo info{};
+	pPlugin->Initialize(pRecorder ? static_cast<IExamInterface*>(pRecorder.get()) : &examInterface, info);
+
+	result.SteeringLatencies.reserve(runSettings.Ticks);
+
+	const Clock::time_point runStart{ Clock::now() };
+
+	for (int tick{}; tick < runSettings.Ticks; ++tick)
+	{
+		if (pRecorder) pRecorder->BeginTick(runSettings.DeltaTime);
+
+		pPlugin->Update(runSettings.DeltaTime);
+
+		const Clock::time_point steeringStart{ Clock::now() };
+		const SteeringPlugin_Output steering{ pPlugin->UpdateSteering(runSettings.DeltaTime) };
+		const Clock::time_point steeringEnd{ Clock::now() };
+
+		result.SteeringLatencies.push_back(std::chrono::duration<double, std::micro>(steeringEnd - steeringStart).count());
+
+		if (pRecorder) pRecorder->EndTick(steering);
+
+		examInterface.Step(steering, runSettings.DeltaTime);
+		++result.TicksRun;
+
+		if (examInterface.IsShutdownRequested()) break;
+		if (runSettings.StopOnDeath && examInterface.IsAgentDead()) break;
+	}
+
+	result.WallTime = std::chrono::duration<double>(Clock::now() - runStart).count();
+	result.Stats = examInterface.World_GetStats();
+	result.IsAgentDead = examInterface.IsAgentDead();
+
+	pPlugin->DllShutdown();
+	delete pPlugin;
+
+	return true;
+}
+
+bool ReplayHeadless(const std::string& traceFile, HeadlessRunResult& result)
+{
+	using Clock = std::chrono::steady_clock;
+
+	result = HeadlessRunResult{};
+
+	HeadlessReplayInterface replayInterface{ traceFile };
+	if (!replayInterface.IsOpen()) return false;
+
+	IExamPlugin* pPlugin{ static_cast<IExamPlugin*>(Register()) };
+	pPlugin->DllInit();
+
+	GameDebugParams params{};
+	pPlugin->InitGameDebugParams(params);
+
+	PluginInfo info{};
+	pPlugin->Initialize(&replayInterface, info);
+
+	const Clock::time_point runStart{ Clock::now() };
+
+	float dt{};
+	while (replayInterface.BeginTick(dt))
+	{
+		pPlugin->Update(dt);
+
+		const Clock::time_point steeringStart{ Clock::now() };
+		const SteeringPlugin_Output steering{ pPlugin->UpdateSteering(dt) };
+		const Clock::time_point steeringEnd{ Clock::now() };
+
+		result.SteeringLatencies.push_back(std::chrono::duration<double, std::micro>(steeringEnd - steeringStart).count());
+
+		if (!replayInterface.EndTick(steering)) break;
+		++result.TicksRun;
+	}
+
+	result.WallTime = std::chrono::duration<double>(Clock::now() - runStart).count();
+	result.HasDiverged = replayInterface.HasDiverged();
+
+	pPlugin->DllShutdown();
+	delete pPlugin;
+
+	return true;
+}
+
+double GetPercentile(std::vector<double>& values, double percentile)
+{
+	if (values.empty()) return 0.0;
+
+	std::sort(values.begin(), values.end());
+
+	const double rank{ ceil(percentile / 100.0 * values.size()) };
+	const size_t index{ static_cast<size_t>((std::max)(rank, 1.0)) - 1 };
+
+	return values[(std::min)(index, values.size() - 1)];
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "HeadlessExamInterface.h"
+
+//Parameters of a headless run, negative or empty values keep what the plugin asked for in InitGameDebugParams
+struct HeadlessRunSettings
+{
+	std::string LevelFile{};
+	int Seed{ -1 };
+	int EnemyCount{ -1 };
+	int Ticks{ 10000 };
+	float DeltaTime{ 1.f / 60.f };
+	bool StopOnDeath{ true };
+	std::string RecordFile{}; //writes the interface traffic to this trace when set
+};
+
+struct HeadlessRunResult
+{
+	StatisticsInfo Stats{};
+	int TicksRun{};
+	bool IsAgentDead{ false };
+	bool HasDiverged{ false }; //replay only
+	double WallTime{}; //seconds spent in the simulation loop
+	std::vector<double> SteeringLatencies{}; //microseconds per UpdateSteering call
+};
+
+//Runs the plugin returned by Register() against a HeadlessExamInterface with a fixed timestep
+//Returns false when the level could not be loaded
+bool RunHeadless(const HeadlessRunSettings& runSettings, HeadlessRunResult& result);
+
+//Feeds a recorded trace back into the plugin, no simulation runs behind it
+//Returns false when the trace could not be opened
+bool ReplayHeadless(const std::string& traceFile, HeadlessRunResult& result);
+
+//Nearest-rank percentile, sorts the values in place
+double GetPercentile(std::vector<double>& values, double percentile);
@@ -0,0 +1,417 @@
+#include "stdafx.h"
+#include "HeadlessTrace.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+	constexpr char traceMagic[4]{ 'G', 'P', 'T', 'R' };
+	constexpr uint32_t traceVersion{ 1 };
+
+	constexpr size_t writeBufferSize{ 1 << 20 };
+	constexpr size_t releaseGranularity{ 64 << 20 };
+}
+
+const char* ToString(eTraceRecord record)
+{
+	switch (record)
+	{
+	case eTraceRecord::TickBegin: return "TickBegin";
+	case eTraceRecord::TickEnd: return "TickEnd";
+	case eTraceRecord::World_GetInfo: return "World_GetInfo";
+	case eTraceRecord::World_GetStats: return "World_GetStats";
+	case eTraceRecord::Fov_GetHouseByIndex: return "Fov_GetHouseByIndex";
+	case eTraceRecord::Fov_GetEntityByIndex: return "Fov_GetEntityByIndex";
+	case eTraceRecord::Agent_GetInfo: return "Agent_GetInfo";
+	case eTraceRecord::Enemy_GetInfo: return "Enemy_GetInfo";
+	case eTraceRecord::NavMesh_GetClosestPathPoint: return "NavMesh_GetClosestPathPoint";
+	case eTraceRecord::Inventory_AddItem: return "Inventory_AddItem";
+	case eTraceRecord::Inventory_UseItem: return "Inventory_UseItem";
+	case eTraceRecord::Inventory_RemoveItem: return "Inventory_RemoveItem";
+	case eTraceRecord::Inventory_GetItem: return "Inventory_GetItem";
+	case eTraceRecord::Inventory_GetCapacity: return "Inventory_GetCapacity";
+	case eTraceRecord::Item_GetInfo: return "Item_GetInfo";
+	case eTraceRecord::Item_Grab: return "Item_Grab";
+	case eTraceRecord::Item_Destroy: return "Item_Destroy";
+	case eTraceRecord::Weapon_GetAmmo: return "Weapon_GetAmmo";
+	case eTraceRecord::Medkit_GetHealth: return "Medkit_GetHealth";
+	case eTraceRecord::Food_GetEnergy: return "Food_GetEnergy";
+	case eTraceRecord::PurgeZone_GetInfo: return "PurgeZone_GetInfo";
+	case eTraceRecord::Debug_ConvertScreenToWorld: return "Debug_ConvertScreenToWorld";
+	case eTraceRecord::Debug_ConvertWorldToScreen: return "Debug_ConvertWorldToScreen";
+	case eTraceRecord::Input_IsKeyboardKeyDown: return "Input_IsKeyboardKeyDown";
+	case eTraceRecord::Input_IsKeyboardKeyUp: return "Input_IsKeyboardKeyUp";
+	case eTraceRecord::Input_IsMouseButtonDown: return "Input_IsMouseButtonDown";
+	case eTraceRecord::Input_IsMouseButtonUp: return "Input_IsMouseButtonUp";
+	case eTraceRecord::Input_GetMouseData: return "Input_GetMouseData";
+	case eTraceRecord::RequestShutdown: return "RequestShutdown";
+	case eTraceRecord::NextDepthSlice: return "NextDepthSlice";
+	default: return "Unknown";
+	}
+}
+
+//Writer
+TraceWriter::TraceWriter(const std::string& path)
+	: m_File{ path, std::ios::binary | std::ios::trunc }
+{
+	if (!m_File)
+	{
+		std::cout << "Trace '" << path << "' could not be created\n";
+		return;
+	}
+
+	m_Buffer.reserve(writeBufferSize);
+
+	WriteRaw(traceMagic, sizeof(traceMagic));
+	WriteRaw(&traceVersion, sizeof(traceVersion));
+}
+
+TraceWriter::~TraceWriter()
+{
+	Flush();
+}
+
+void TraceWriter::Flush()
+{
+	if (!m_File.is_open() || m_Buffer.empty()) return;
+
+	m_File.write(m_Buffer.data(), m_Buffer.size());
+	m_Buffer.clear();
+}
+
+void TraceWriter::WriteRaw(const void* pData, size_t size)
+{
+	const char* pBytes{ static_cast<const char*>(pData) };
+	m_Buffer.insert(m_Buffer.end(), pBytes, pBytes + size);
+
+	if (m_Buffer.size() >= writeBufferSize)
+	{
+		Flush();
+	}
+}
+
+void TraceWriter::Write(eTraceRecord record) { WriteRaw(&record, sizeof(record)); }
+void TraceWriter::Write(bool value) { const uint8_t byte{ value ? uint8_t{ 1 } : uint8_t{ 0 } }; WriteRaw(&byte, sizeof(byte)); }
+void TraceWriter::Write(int value) { const int32_t word{ value }; WriteRaw(&word, sizeof(word)); }
+void TraceWriter::Write(UINT value) { const uint32_t word{ value }; WriteRaw(&word, sizeof(word)); }
+void TraceWriter::Write(float value) { WriteRaw(&value, sizeof(value)); }
+void TraceWriter::Write(const Elite::Vector2& value) { Write(value.x); Write(value.y); }
+
+void TraceWriter::Write(const WorldInfo& info)
+{
+	Write(info.Center);
+	Write(info.Dimensions);
+}
+
+void TraceWriter::Write(const StatisticsInfo& info)
+{
+	Write(info.Score);
+	Write(info.Difficulty);
+	Write(info.TimeSurvived);
+	Write(info.KillCountdown);
+	Write(info.NumEnemiesKilled);
+	Write(info.NumEnemiesHit);
+	Write(info.NumItemsPickUp);
+	Write(info.NumMissedShots);
+	Write(info.NumChkpntsReached);
+}
+
+void TraceWriter::Write(const HouseInfo& info)
+{
+	Write(info.Center);
+	Write(info.Size);
+}
+
+void TraceWriter::Write(const EntityInfo& info)
+{
+	Write(static_cast<int>(info.Type));
+	Write(info.Location);
+	Write(info.EntityHash);
+}
+
+void TraceWriter::Write(const AgentInfo& info)
+{
+	Write(info.Stamina);
+	Write(info.Health);
+	Write(info.Energy);
+	Write(info.RunMode);
+	Write(info.IsInHouse);
+	Write(info.Bitten);
+	Write(info.WasBitten);
+	Write(info.Death);
+	Write(info.FOV_Angle);
+	Write(info.FOV_Range);
+	Write(info.LinearVelocity);
+	Write(info.AngularVelocity);
+	Write(info.CurrentLinearSpeed);
+	Write(info.Position);
+	Write(info.Orientation);
+	Write(info.MaxLinearSpeed);
+	Write(info.MaxAngularSpeed);
+	Write(info.GrabRange);
+	Write(info.AgentSize);
+}
+
+void TraceWriter::Write(const EnemyInfo& info)
+{
+	Write(static_cast<int>(info.Type));
+	Write(info.Location);
+	Write(info.LinearVelocity);
+	Write(info.EnemyHash);
+	Write(info.Size);
+	Write(info.Health);
+}
+
+void TraceWriter::Write(const ItemInfo& info)
+{
+	Write(static_cast<int>(info.Type));
+	Write(info.Location);
+	Write(info.ItemHash);
+}
+
+void TraceWriter::Write(const PurgeZoneInfo& info)
+{
+	Write(info.Center);
+	Write(info.Radius);
+	Write(info.ZoneHash);
+}
+
+void TraceWriter::Write(const Elite::MouseData& data)
+{
+	Write(data.TimeStamp);
+	Write(static_cast<int>(data.Button));
+	Write(data.X);
+	Write(data.Y);
+	Write(data.XRel);
+	Write(data.YRel);
+}
+
+void TraceWriter::Write(const SteeringPlugin_Output& output)
+{
+	Write(output.LinearVelocity);
+	Write(output.AngularVelocity);
+	Write(output.AutoOrient);
+	Write(output.RunMode);
+}
+
+//Reader
+TraceReader::TraceReader(const std::string& path)
+{
+#ifdef _WIN32
+	m_FileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (m_FileHandle == INVALID_HANDLE_VALUE)
+	{
+		m_FileHandle = nullptr;
+		std::cout << "Trace '" << path << "' could not be opened\n";
+		return;
+	}
+
+	LARGE_INTEGER fileSize{};
+	GetFileSizeEx(m_FileHandle, &fileSize);
+	m_Size = static_cast<size_t>(fileSize.QuadPart);
+
+	m_MappingHandle = CreateFileMappingA(m_FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_MappingHandle)
+	{
+		m_pData = static_cast<const char*>(MapViewOfFile(m_MappingHandle, FILE_MAP_READ, 0, 0, 0));
+	}
+#else
+	const int fileDescriptor{ open(path.c_str(), O_RDONLY) };
+	if (fileDescriptor < 0)
+	{
+		std::cout << "Trace '" << path << "' could not be opened\n";
+		return;
+	}
+
+	struct stat fileStatus {};
+	if (fstat(fileDescriptor, &fileStatus) == 0 && fileStatus.st_size > 0)
+	{
+		m_Size = static_cast<size_t>(fileStatus.st_size);
+
+		void* pMapping{ mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0) };
+		if (pMapping != MAP_FAILED)
+		{
+			madvise(pMapping, m_Size, MADV_SEQUENTIAL);
+			m_pData = static_cast<const char*>(pMapping);
+		}
+	}
+
+	//The mapping keeps the file alive
+	close(fileDescriptor);
+#endif
+
+	if (!m_pData)
+	{
+		std::cout << "Trace '" << path << "' could not be mapped\n";
+		Close();
+		return;
+	}
+
+	char magic[sizeof(traceMagic)]{};
+	uint32_t version{};
+	if (!ReadRaw(magic, sizeof(magic)) || !ReadRaw(&version, sizeof(version))
+		|| memcmp(magic, traceMagic, sizeof(magic)) != 0 || version != traceVersion)
+	{
+		std::cout << "Trace '" << path << "' is not a supported trace\n";
+		Close();
+	}
+}
+
+TraceReader::~TraceReader()
+{
+	Close();
+}
+
+void TraceReader::Close()
+{
+#ifdef _WIN32
+	if (m_pData) UnmapViewOfFile(m_pData);
+	if (m_MappingHandle) CloseHandle(m_MappingHandle);
+	if (m_FileHandle) CloseHandle(m_FileHandle);
+
+	m_MappingHandle = nullptr;
+	m_FileHandle = nullptr;
+#else
+	if (m_pData) munmap(const_cast<char*>(m_pData), m_Size);
+#endif
+
+	m_pData = nullptr;
+	m_Size = 0;
+	m_Offset = 0;
+	m_ReleasedOffset = 0;
+}
+
+void TraceReader::ReleaseConsumed()
+{
+#ifndef _WIN32
+	if (!m_pData || m_Offset - m_ReleasedOffset < releaseGranularity) return;
+
+	//Only whole pages can be released
+	const size_t pageSize{ static_cast<size_t>(sysconf(_SC_PAGESIZE)) };
+	const size_t releaseEnd{ m_Offset / pageSize * pageSize };
+
+	madvise(const_cast<char*>(m_pData) + m_ReleasedOffset, releaseEnd - m_ReleasedOffset, MADV_DONTNEED);
+	m_ReleasedOffset = releaseEnd;
+#endif
+}
+
+bool TraceReader::ReadRaw(void* pData, size_t size)
+{
+	if (m_Size - m_Offset < size) return false;
+
+	memcpy(pData, m_pData + m_Offset, size);
+	m_Offset += size;
+	return true;
+}
+
+bool TraceReader::Read(eTraceRecord& record) { return ReadRaw(&record, sizeof(record)); }
+
+bool TraceReader::Read(bool& value)
+{
+	uint8_t byte{};
+	if (!ReadRaw(&byte, sizeof(byte))) return false;
+
+	value = byte != 0;
+	return true;
+}
+
+bool TraceReader::Read(int& value)
+{
+	int32_t word{};
+	if (!ReadRaw(&word, sizeof(word))) return false;
+
+	value = word;
+	return true;
+}
+
+bool TraceReader::Read(UINT& value)
+{
+	uint32_t word{};
+	if (!ReadRaw(&word, sizeof(word))) return false;
+
+	value = word;
+	return true;
+}
+
+bool TraceReader::Read(float& value) { return ReadRaw(&value, sizeof(value)); }
+bool TraceReader::Read(Elite::Vector2& value) { return Read(value.x) && Read(value.y); }
+
+bool TraceReader::Read(WorldInfo& info)
+{
+	return Read(info.Center) && Read(info.Dimensions);
+}
+
+bool TraceReader::Read(StatisticsInfo& info)
+{
+	return Read(info.Score) && Read(info.Difficulty) && Read(info.TimeSurvived) && Read(info.KillCountdown)
+		&& Read(info.NumEnemiesKilled) && Read(info.NumEnemiesHit) && Read(info.NumItemsPickUp)
+		&& Read(info.NumMissedShots) && Read(info.NumChkpntsReached);
+}
+
+bool TraceReader::Read(HouseInfo& info)
+{
+	return Read(info.Center) && Read(info.Size);
+}
+
+bool TraceReader::Read(EntityInfo& info)
+{
+	int type{};
+	if (!Read(type) || !Read(info.Location) || !Read(info.EntityHash)) return false;
+
+	info.Type = static_cast<eEntityType>(type);
+	return true;
+}
+
+bool TraceReader::Read(AgentInfo& info)
+{
+	return Read(info.Stamina) && Read(info.Health) && Read(info.Energy)
+		&& Read(info.RunMode) && Read(info.IsInHouse) && Read(info.Bitten) && Read(info.WasBitten) && Read(info.Death)
+		&& Read(info.FOV_Angle) && Read(info.FOV_Range)
+		&& Read(info.LinearVelocity) && Read(info.AngularVelocity) && Read(info.CurrentLinearSpeed)
+		&& Read(info.Position) && Read(info.Orientation)
+		&& Read(info.MaxLinearSpeed) && Read(info.MaxAngularSpeed) && Read(info.GrabRange) && Read(info.AgentSize);
+}
+
+bool TraceReader::Read(EnemyInfo& info)
+{
+	int type{};
+	if (!Read(type) || !Read(info.Location) || !Read(info.LinearVelocity) || !Read(info.EnemyHash) || !Read(info.Size) || !Read(info.Health)) return false;
+
+	info.Type = static_cast<eEnemyType>(type);
+	return true;
+}
+
+bool TraceReader::Read(ItemInfo& info)
+{
+	int type{};
+	if (!Read(type) || !Read(info.Location) || !Read(info.ItemHash)) return false;
+
+	info.Type = static_cast<eItemType>(type);
+	return true;
+}
+
+bool TraceReader::Read(PurgeZoneInfo& info)
+{
+	return Read(info.Center) && Read(info.Radius) && Read(info.ZoneHash);
+}
+
+bool TraceReader::Read(Elite::MouseData& data)
+{
+	int button{};
+	if (!Read(data.TimeStamp) || !Read(button) || !Read(data.X) || !Read(data.Y) || !Read(data.XRel) || !Read(data.YRel)) return false;
+
+	data.Button = static_cast<Elite::InputMouseButton>(button);
+	return true;
+}
+
+bool TraceReader::Read(SteeringPlugin_Output& output)
+{
+	return Read(output.LinearVelocity) && Read(output.AngularVelocity) && Read(output.AutoOrient) && Read(output.RunMode);
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+#include <cstdint>
+#include <cstring>
+
+//Binary trace of the IExamInterface traffic of a headless run
+//Layout: header (magic, version), then records, each starting with an eTraceRecord byte
+//  TickBegin: dt
+//  TickEnd: SteeringPlugin_Output returned by UpdateSteering
+//  calls: arguments (hashes, slots, positions), then the returned data
+enum class eTraceRecord : uint8_t
+{
+	TickBegin,
+	TickEnd,
+
+	World_GetInfo,
+	World_GetStats,
+	Fov_GetHouseByIndex,
+	Fov_GetEntityByIndex,
+	Agent_GetInfo,
+	Enemy_GetInfo,
+
+	NavMesh_GetClosestPathPoint,
+
+	Inventory_AddItem,
+	Inventory_UseItem,
+	Inventory_RemoveItem,
+	Inventory_GetItem,
+	Inventory_GetCapacity,
+
+	Item_GetInfo,
+	Item_Grab,
+	Item_Destroy,
+	Weapon_GetAmmo,
+	Medkit_GetHealth,
+	Food_GetEnergy,
+
+	PurgeZone_GetInfo,
+
+	Debug_ConvertScreenToWorld,
+	Debug_ConvertWorldToScreen,
+
+	Input_IsKeyboardKeyDown,
+	Input_IsKeyboardKeyUp,
+	Input_IsMouseButtonDown,
+	Input_IsMouseButtonUp,
+	Input_GetMouseData,
+
+	RequestShutdown,
+	NextDepthSlice
+};
+
+const char* ToString(eTraceRecord record);
+
+//Buffered writer, fields are stored one by one so padding never ends up in the trace
+class TraceWriter final
+{
+public:
+	explicit TraceWriter(const std::string& path);
+	~TraceWriter();
+
+	TraceWriter(const TraceWriter& other) = delete;
+	TraceWriter& operator=(const TraceWriter& other) = delete;
+	TraceWriter(TraceWriter&& other) = delete;
+	TraceWriter& operator=(TraceWriter&& other) = delete;
+
+	bool IsOpen() const { return m_File.is_open(); }
+	void Flush();
+
+	void Write(eTraceRecord record);
+	void Write(bool value);
+	void Write(int value);
+	void Write(UINT value);
+	void Write(float value);
+	void Write(const Elite::Vector2& value);
+
+	void Write(const WorldInfo& info);
+	void Write(const StatisticsInfo& info);
+	void Write(const HouseInfo& info);
+	void Write(const EntityInfo& info);
+	void Write(const AgentInfo& info);
+	void Write(const EnemyInfo& info);
+	void Write(const ItemInfo& info);
+	void Write(const PurgeZoneInfo& info);
+	void Write(const Elite::MouseData& data);
+	void Write(const SteeringPlugin_Output& output);
+
+private:
+	std::ofstream m_File;
+	std::vector<char> m_Buffer{};
+
+	void WriteRaw(const void* pData, size_t size);
+};
+
+//Reads a trace through a memory mapping, pages that were consumed are handed back to the OS
+//so traces bigger than the available memory can be replayed
+class TraceReader final
+{
+public:
+	explicit TraceReader(const std::string& path);
+	~TraceReader();
+
+	TraceReader(const TraceReader& other) = delete;
+	TraceReader& operator=(const TraceReader& other) = delete;
+	TraceReader(TraceReader&& other) = delete;
+	TraceReader& operator=(TraceReader&& other) = delete;
+
+	bool IsOpen() const { return m_pData != nullptr; }
+	bool IsAtEnd() const { return m_Offset >= m_Size; }
+	void ReleaseConsumed();
+
+	bool Read(eTraceRecord& record);
+	bool Read(bool& value);
+	bool Read(int& value);
+	bool Read(UINT& value);
+	bool Read(float& value);
+	bool Read(Elite::Vector2& value);
+
+	bool Read(WorldInfo& info);
+	bool Read(StatisticsInfo& info);
+	bool Read(HouseInfo& info);
+	bool Read(EntityInfo& info);
+	bool Read(AgentInfo& info);
+	bool Read(EnemyInfo& info);
+	bool Read(ItemInfo& info);
+	bool Read(PurgeZoneInfo& info);
+	bool Read(Elite::MouseData& data);
+	bool Read(SteeringPlugin_Output& output);
+
+private:
+	const char* m_pData{};
+	size_t m_Size{};
+	size_t m_Offset{};
+	size_t m_ReleasedOffset{};
+
+#ifdef _WIN32
+	void* m_FileHandle{};
+	void* m_MappingHandle{};
+#endif
+
+	bool ReadRaw(void* pData, size_t size);
+	void Close();
+};
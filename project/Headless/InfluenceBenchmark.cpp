@@ -0,0 +1,147 @@
+#include "stdafx.h"
+#include "ExplorationGrid.h"
+#include "HeadlessBenchmark.h"
+
+//Usage: InfluenceBenchmark [--sides 15,256,1024] [--sources 16] [--min-time seconds] [--out file.json]
+//Recalculates the house influence of a side x side grid with every kernel and compares them to the
+//array-of-structs loop the plugin used before the grid became structure-of-arrays
+
+struct KernelResult
+{
+	std::string Kernel{};
+	int Side{};
+	HeadlessBenchmark::Timing Timing{};
+	double NsPerCell{};
+	bool IsIdentical{};
+};
+
+namespace
+{
+	//Cell layout and formula of the former GridElement based CalculateInfluence
+	struct ReferenceCell
+	{
+		Elite::Vector2 Position{};
+		bool IsVisited{ false };
+		float Influence{};
+	};
+
+	void CalculateReferenceInfluence(std::vector<ReferenceCell>& cells, const std::vector<Elite::Vector2>& sources, float cellSize)
+	{
+		for (ReferenceCell& cell : cells)
+		{
+			cell.Influence = 0.f;
+
+			for (const Elite::Vector2& source : sources)
+			{
+				const float nrCellsAway{ (std::max)(cell.Position.Distance(source) / cellSize, InfluenceKernels::MinNrCellsAway) };
+				cell.Influence += 1.f / (nrCellsAway * nrCellsAway * nrCellsAway);
+			}
+		}
+	}
+
+	void CalculateGridInfluence(ExplorationGrid& grid, const std::vector<Elite::Vector2>& sources)
+	{
+		grid.ClearInfluence();
+
+		for (const Elite::Vector2& source : sources)
+		{
+			grid.AddInfluence(source, 1.f);
+		}
+	}
+
+	template<typename Kernel>
+	KernelResult Measure(const std::string& name, int side, double minTime, Kernel kernel)
+	{
+		KernelResult result{};
+		result.Kernel = name;
+		result.Side = side;
+		result.Timing = HeadlessBenchmark::Measure(minTime, 3, kernel);
+		result.NsPerCell = result.Timing.MedianNs / (static_cast<double>(side) * side);
+
+		return result;
+	}
+
+	void RunSide(int side, int nrSources, double minTime, std::vector<KernelResult>& results)
+	{
+		constexpr float cellSize{ 20.f };
+
+		WorldInfo world{};
+		world.Center = Elite::ZeroVector2;
+		world.Dimensions = Elite::Vector2{ side * cellSize, side * cellSize };
+
+		ExplorationGrid grid{ world, side };
+
+		//Houses at random spots, never exactly on a cell center
+		std::mt19937 randomEngine{ static_cast<unsigned int>(side) };
+		std::uniform_real_distribution<float> distribution{ -world.Dimensions.x / 2.f, world.Dimensions.x / 2.f };
+
+		std::vector<Elite::Vector2> sources{};
+		for (int index{}; index < nrSources; ++index)
+		{
+			sources.push_back(Elite::Vector2{ distribution(randomEngine), distribution(randomEngine) } + Elite::Vector2{ 0.25f, 0.25f });
+		}
+
+		std::vector<ReferenceCell> referenceCells(static_cast<size_t>(grid.GetNrCells()));
+		for (int index{}; index < grid.GetNrCells(); ++index)
+		{
+			referenceCells[index].Position = grid.GetPosition(index);
+		}
+
+		results.push_back(Measure("aos_reference", side, minTime, [&]() { CalculateReferenceInfluence(referenceCells, sources, grid.GetCellSize()); }));
+		results.back().IsIdentical = true;
+
+		const InfluenceKernels::eInstructionSet instructionSets[]{ InfluenceKernels::eInstructionSet::Scalar, InfluenceKernels::eInstructionSet::SSE2, InfluenceKernels::eInstructionSet::AVX2 };
+		for (InfluenceKernels::eInstructionSet instructionSet : instructionSets)
+		{
+			if (instructionSet > InfluenceKernels::GetSupportedInstructionSet()) continue;
+
+			grid.SetInstructionSet(instructionSet);
+			results.push_back(Measure(InfluenceKernels::ToString(instructionSet), side, minTime, [&]() { CalculateGridInfluence(grid, sources); }));
+
+			bool isIdentical{ true };
+			for (int index{}; index < grid.GetNrCells(); ++index)
+			{
+				isIdentical &= grid.GetInfluence(index) == referenceCells[index].Influence;
+			}
+			results.back().IsIdentical = isIdentical;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<int> sides{ 15, 256, 1024 };
+	int nrSources{ 16 };
+	double minTime{ 0.2 };
+	std::string outputFile{};
+
+	const bool areArgumentsValid{ HeadlessBenchmark::ReadArguments(argc, argv, outputFile, [&](const std::string& argument, const std::string& value)
+	{
+		if (argument == "--sides") sides = HeadlessBenchmark::ReadList(value);
+		else if (argument == "--sources") nrSources = atoi(value.c_str());
+		else if (argument == "--min-time") minTime = atof(value.c_str());
+		else return false;
+
+		return true;
+	}) };
+	if (!areArgumentsValid) return 1;
+
+	std::vector<KernelResult> results{};
+	for (int side : sides)
+	{
+		if (side <= 0) continue;
+
+		RunSide(side, nrSources, minTime, results);
+	}
+
+	std::stringstream json{};
+	json << "{\n\t\"benchmark\": \"influence kernels\",\n\t\"sources\": " << nrSources
+		<< ",\n\t\"supported\": \"" << InfluenceKernels::ToString(InfluenceKernels::GetSupportedInstructionSet()) << "\",\n";
+
+	return HeadlessBenchmark::WriteReport(json, results, [](std::ostream& json, const KernelResult& result)
+	{
+		json << "\"kernel\": \"" << result.Kernel << "\", \"side\": " << result.Side << ", ";
+		HeadlessBenchmark::WriteTiming(json, result.Timing);
+		json << ", \"p50_ns_per_cell\": " << result.NsPerCell << ", \"identical\": " << (result.IsIdentical ? "true" : "false");
+	}, outputFile);
+}
@@ -0,0 +1,202 @@
+#include "stdafx.h"
+#include "EliteAI/EliteGraphs/EGridGraph.h"
+#include "EliteAI/EliteGraphs/EInfluenceMap.h"
+#include "HeadlessBenchmark.h"
+
+//Usage: InfluenceMapBenchmark [--sides 32,128,512] [--steps 20] [--min-time seconds] [--out file.json]
+//Propagates the influence of a side x side grid with the node by node loop over the connection lists the map used
+//before its double buffers, and with the buffered InfluenceMap: through the 8 neighbour stencil on a plain grid and
+//through the adjacency arrays on a grid with one extra long connection, which does not fit the stencil
+//Both run the same number of steps from the same influence and are compared node by node, the map through its own GetInfluence
+
+using InfluenceGrid = Elite::GridGraph<Elite::InfluenceNode, Elite::GraphConnection>;
+using InfluenceGridMap = Elite::InfluenceMap<InfluenceGrid>;
+
+struct PropagationResult
+{
+	std::string Propagation{};
+	int Side{};
+	HeadlessBenchmark::Timing Timing{};
+	double NsPerNode{};
+	float MaxDifference{};
+	int NrDifferentNodes{};
+};
+
+namespace
+{
+	constexpr int CellSize{ 1 };
+	constexpr float Momentum{ 0.8f };
+	constexpr float Decay{ 0.1f };
+
+	//Loop of the former PropagateInfluence, a node without incoming influence keeps its own like in the map
+	class ReferencePropagation final
+	{
+	public:
+		explicit ReferencePropagation(InfluenceGrid& grid)
+			: m_Grid{ grid }
+			, m_NextInfluence(static_cast<size_t>(grid.GetNrOfNodes()))
+		{
+		}
+
+		void Propagate()
+		{
+			for (int idx{}; idx < m_Grid.GetNrOfNodes(); ++idx)
+			{
+				const Elite::InfluenceNode* pNode{ m_Grid.GetNode(idx) };
+
+				float highestInfluence{};
+				float strongestInfluence{};
+				for (const Elite::GraphConnection* pConnection : m_Grid.GetNodeConnections(idx))
+				{
+					const float calculatedInfluence{ m_Grid.GetNode(pConnection->GetTo())->GetInfluence() * expf(-pConnection->GetCost() * Decay) };
+
+					if (highestInfluence < fabsf(calculatedInfluence))
+					{
+						highestInfluence = fabsf(calculatedInfluence);
+						strongestInfluence = calculatedInfluence;
+					}
+				}
+
+				m_NextInfluence[idx] = highestInfluence > 0.f ? Elite::Lerp(strongestInfluence, pNode->GetInfluence(), Momentum) : pNode->GetInfluence();
+			}
+
+			for (int idx{}; idx < m_Grid.GetNrOfNodes(); ++idx)
+			{
+				m_Grid.GetNode(idx)->SetInfluence(m_NextInfluence[idx]);
+			}
+		}
+
+	private:
+		InfluenceGrid& m_Grid;
+		std::vector<float> m_NextInfluence;
+	};
+
+	template<typename Propagation>
+	PropagationResult Measure(const std::string& name, int side, double minTime, Propagation propagation)
+	{
+		PropagationResult result{};
+		result.Propagation = name;
+		result.Side = side;
+		result.Timing = HeadlessBenchmark::Measure(minTime, 3, propagation);
+		result.NsPerNode = result.Timing.MedianNs / (static_cast<double>(side) * side);
+
+		return result;
+	}
+
+	//One source in about every 64 cells, with positive and negative influence like friends and threats
+	std::vector<std::pair<int, float>> CreateSources(int side)
+	{
+		std::mt19937 randomEngine{ static_cast<unsigned int>(side) };
+		std::uniform_int_distribution<int> cellDistribution{ 0, side * side - 1 };
+		std::uniform_real_distribution<float> influenceDistribution{ -100.f, 100.f };
+
+		std::vector<std::pair<int, float>> sources{};
+		for (int index{}; index < (std::max)(side * side / 64, 1); ++index)
+		{
+			sources.emplace_back(cellDistribution(randomEngine), influenceDistribution(randomEngine));
+		}
+
+		return sources;
+	}
+
+	template<typename Graph>
+	void InitializeGraph(Graph& graph, int side, bool hasLongConnection)
+	{
+		graph.InitializeGrid(side, side, CellSize, false, true);
+
+		if (hasLongConnection && side > 2)
+		{
+			graph.AddConnection(new Elite::GraphConnection{ 0, side * side - 1, 1.f });
+		}
+	}
+
+	void Compare(const InfluenceGrid& reference, const InfluenceGridMap& map, PropagationResult& result)
+	{
+		for (int idx{}; idx < reference.GetNrOfNodes(); ++idx)
+		{
+			const float difference{ fabsf(reference.GetNode(idx)->GetInfluence() - map.GetInfluence(idx)) };
+
+			result.MaxDifference = (std::max)(result.MaxDifference, difference);
+			if (difference > 0.f) ++result.NrDifferentNodes;
+		}
+	}
+
+	void RunSide(int side, int nrSteps, double minTime, std::vector<PropagationResult>& results)
+	{
+		const std::vector<std::pair<int, float>> sources{ CreateSources(side) };
+
+		for (bool hasLongConnection : { false, true })
+		{
+			InfluenceGrid reference{ false };
+			InitializeGraph(reference, side, hasLongConnection);
+
+			InfluenceGridMap map{ false };
+			InitializeGraph(map, side, hasLongConnection);
+			map.SetMomentum(Momentum);
+			map.SetDecay(Decay);
+
+			for (const std::pair<int, float>& source : sources)
+			{
+				reference.GetNode(source.first)->SetInfluence(source.second);
+				map.SetInfluence(source.first, source.second);
+			}
+
+			ReferencePropagation referencePropagation{ reference };
+			const float interval{ map.GetPropagationInterval() };
+
+			//Same number of steps from the same influence before any timing
+			for (int step{}; step < nrSteps; ++step)
+			{
+				referencePropagation.Propagate();
+				map.PropagateInfluence(interval);
+			}
+
+			PropagationResult check{};
+			Compare(reference, map, check);
+
+			results.push_back(Measure(hasLongConnection ? "nodes_long_link" : "nodes", side, minTime, [&]() { referencePropagation.Propagate(); }));
+			results.push_back(Measure(hasLongConnection ? "adjacency" : "stencil", side, minTime, [&]() { map.PropagateInfluence(interval); }));
+			results.back().MaxDifference = check.MaxDifference;
+			results.back().NrDifferentNodes = check.NrDifferentNodes;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<int> sides{ 32, 128, 512 };
+	int nrSteps{ 20 };
+	double minTime{ 0.2 };
+	std::string outputFile{};
+
+	const bool areArgumentsValid{ HeadlessBenchmark::ReadArguments(argc, argv, outputFile, [&](const std::string& argument, const std::string& value)
+	{
+		if (argument == "--sides") sides = HeadlessBenchmark::ReadList(value);
+		else if (argument == "--steps") nrSteps = atoi(value.c_str());
+		else if (argument == "--min-time") minTime = atof(value.c_str());
+		else return false;
+
+		return true;
+	}) };
+	if (!areArgumentsValid) return 1;
+
+	std::vector<PropagationResult> results{};
+	for (int side : sides)
+	{
+		if (side <= 0) continue;
+
+		RunSide(side, nrSteps, minTime, results);
+	}
+
+	std::stringstream json{};
+	json << "{\n\t\"benchmark\": \"influence map propagation\",\n\t\"steps\": " << nrSteps << ",\n";
+
+	return HeadlessBenchmark::WriteReport(json, results, [](std::ostream& json, const PropagationResult& result)
+	{
+		json << "\"propagation\": \"" << result.Propagation << "\", \"side\": " << result.Side << ", ";
+		HeadlessBenchmark::WriteTiming(json, result.Timing);
+		json << ", \"p50_ns_per_node\": " << result.NsPerNode
+			<< ", \"max_difference\": " << result.MaxDifference
+			<< ", \"different_nodes\": " << result.NrDifferentNodes;
+	}, outputFile);
+}
@@ -0,0 +1,195 @@
+#include "stdafx.h"
+#include "Plugin.h"
+#include "HeadlessExamInterface.h"
+#include "EliteAI/EliteDecisionMaking/EliteBehaviorTree/EBehaviorTree.h"
+#include "HeadlessBenchmark.h"
+
+//Usage: PluginBenchmark [--sizes 10,100,1000,10000] [--min-time seconds] [--out file.json]
+//Times every UpdateSteering stage in isolation on synthetic worlds with n houses, n items and n enemies
+//Everything is inside the field of view, so every stage sees the whole world each call
+
+struct StageResult
+{
+	std::string Stage{};
+	int Size{};
+	HeadlessBenchmark::Timing Timing{};
+};
+
+class PluginBenchmark final
+{
+public:
+	PluginBenchmark(int size, double minTime);
+	~PluginBenchmark();
+
+	PluginBenchmark(const PluginBenchmark& other) = delete;
+	PluginBenchmark& operator=(const PluginBenchmark& other) = delete;
+	PluginBenchmark(PluginBenchmark&& other) = delete;
+	PluginBenchmark& operator=(PluginBenchmark&& other) = delete;
+
+	void Run(std::vector<StageResult>& results);
+
+private:
+	const int m_Size;
+	const double m_MinTime;
+	const float m_DeltaTime{ 1.f / 60.f };
+
+	HeadlessLevel m_Level{};
+	std::unique_ptr<HeadlessExamInterface> m_pInterface{};
+	Plugin* m_pPlugin{};
+
+	template<typename Stage>
+	StageResult Measure(const char* name, Stage stage) const;
+};
+
+namespace
+{
+	//Swallows the "New house" style messages of the plugin while measuring
+	class NullBuffer final : public std::streambuf
+	{
+	protected:
+		int overflow(int character) override { return character; }
+	};
+
+	//Houses on a square lattice, world just big enough to hold them
+	HeadlessLevel CreateSyntheticLevel(int nrHouses)
+	{
+		constexpr float houseSize{ 20.f };
+		constexpr float spacing{ 40.f };
+
+		const int nrColumns{ static_cast<int>(ceil(sqrt(static_cast<double>(nrHouses)))) };
+		const float side{ nrColumns * spacing };
+
+		HeadlessLevel level{};
+		level.World.Center = Elite::ZeroVector2;
+		level.World.Dimensions = Elite::Vector2{ side, side };
+
+		for (int index{}; index < nrHouses; ++index)
+		{
+			HeadlessHouse house{};
+			house.Center.x = -side / 2.f + (index % nrColumns + 0.5f) * spacing;
+			house.Center.y = -side / 2.f + (index / nrColumns + 0.5f) * spacing;
+			house.Size = Elite::Vector2{ houseSize, houseSize };
+
+			level.Houses.push_back(house);
+		}
+
+		return level;
+	}
+}
+
+PluginBenchmark::PluginBenchmark(int size, double minTime)
+	: m_Size{ size }
+	, m_MinTime{ minTime }
+	, m_Level{ CreateSyntheticLevel(size) }
+{
+	HeadlessSettings settings{};
+	settings.Seed = size;
+	settings.EnemyCount = size;
+	settings.ItemCount = size;
+	settings.PurgeZoneInterval = 0.f;
+	settings.FOVRange = m_Level.World.Dimensions.Magnitude();
+	settings.FOVAngle = static_cast<float>(E_PI) * 2.f;
+
+	m_pInterface.reset(new HeadlessExamInterface{ m_Level, settings });
+
+	m_pPlugin = new Plugin();
+	m_pPlugin->DllInit();
+
+	PluginInfo info{};
+	m_pPlugin->Initialize(m_pInterface.get(), info);
+
+	//Steady state: every house and item is already known
+	m_pPlugin->m_AgentInfo = m_pInterface->Agent_GetInfo();
+	m_pPlugin->UpdateFov();
+	m_pPlugin->UpdateHouses();
+	m_pPlugin->UpdateEntities();
+	m_pPlugin->CalculateInfluence();
+
+	//Every house visited, so the wheel holds one pending revisit timer per house like after a long run
+	for (House* pHouse : m_pPlugin->m_Houses)
+	{
+		pHouse->IsVisited = true;
+		pHouse->RevisitTimer = m_pPlugin->m_Timers.Schedule(House::RevisitTime, [pHouse]() { pHouse->IsVisited = false; });
+	}
+}
+
+PluginBenchmark::~PluginBenchmark()
+{
+	m_pPlugin->DllShutdown();
+	delete m_pPlugin;
+}
+
+template<typename Stage>
+StageResult PluginBenchmark::Measure(const char* name, Stage stage) const
+{
+	StageResult result{};
+	result.Stage = name;
+	result.Size = m_Size;
+	result.Timing = HeadlessBenchmark::Measure(m_MinTime, 5, stage);
+
+	return result;
+}
+
+void PluginBenchmark::Run(std::vector<StageResult>& results)
+{
+	Plugin* pPlugin{ m_pPlugin };
+	const float dt{ m_DeltaTime };
+
+	results.push_back(Measure("fov", [&]() { pPlugin->UpdateFov(); }));
+	results.push_back(Measure("house_dedup", [&]() { pPlugin->UpdateHouses(); }));
+	results.push_back(Measure("entity_dedup", [&]() { pPlugin->UpdateEntities(); }));
+	results.push_back(Measure("timers", [&]() { pPlugin->m_Timers.Advance(dt); }));
+	results.push_back(Measure("grid_scan", [&]() { pPlugin->UpdateCurrentGridElement(); }));
+	results.push_back(Measure("influence", [&]() { pPlugin->CalculateInfluence(); }));
+	results.push_back(Measure("influence_add_remove", [&]()
+		{
+			//Off the cell centers, like a real source, so the stage measures the kernel and not the distance clamp
+			const float quarterCell{ pPlugin->m_pGrid->GetCellSize() * 0.25f };
+			const Elite::Vector2 source{ m_Level.World.Center + Elite::Vector2{ quarterCell, quarterCell } };
+			pPlugin->m_pGrid->AddInfluence(source, 1.f);
+			pPlugin->m_pGrid->AddInfluence(source, -1.f);
+		}));
+	results.push_back(Measure("behavior_tree", [&]() { pPlugin->m_pBehaviourTree->Update(dt); }));
+	results.push_back(Measure("steering", [&]() { pPlugin->CalculateSteering(dt); }));
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<int> sizes{ 10, 100, 1000, 10000 };
+	double minTime{ 0.2 };
+	std::string outputFile{};
+
+	const bool areArgumentsValid{ HeadlessBenchmark::ReadArguments(argc, argv, outputFile, [&](const std::string& argument, const std::string& value)
+	{
+		if (argument == "--sizes") sizes = HeadlessBenchmark::ReadList(value);
+		else if (argument == "--min-time") minTime = atof(value.c_str());
+		else return false;
+
+		return true;
+	}) };
+	if (!areArgumentsValid) return 1;
+
+	std::vector<StageResult> results{};
+
+	NullBuffer nullBuffer{};
+	std::streambuf* pCoutBuffer{ std::cout.rdbuf(&nullBuffer) };
+
+	for (int size : sizes)
+	{
+		if (size <= 0) continue;
+
+		PluginBenchmark benchmark{ size, minTime };
+		benchmark.Run(results);
+	}
+
+	std::cout.rdbuf(pCoutBuffer);
+
+	std::stringstream json{};
+	json << "{\n\t\"benchmark\": \"UpdateSteering stages\",\n";
+
+	return HeadlessBenchmark::WriteReport(json, results, [](std::ostream& json, const StageResult& result)
+	{
+		json << "\"stage\": \"" << result.Stage << "\", \"size\": " << result.Size << ", ";
+		HeadlessBenchmark::WriteTiming(json, result.Timing);
+	}, outputFile);
+}
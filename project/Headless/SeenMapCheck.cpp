@@ -0,0 +1,180 @@
+#include "stdafx.h"
+#include "SeenMap.h"
+#include "HeadlessCheck.h"
+
+//Usage: SeenMapCheck [--cones 3000] [--seed 1]
+//Stamps random view cones, narrow to wider than a full circle, into seen maps of a few shapes and compares every cell
+//with a point in cone test on its center through the angle to the apex, the newly seen indices with the bits that flipped
+//and the popcount coverage with a count over the cells
+//Cells whose center lies within a thousandth of a cell of the cone outline can go either way and are not compared
+//Returns 1 at the first difference
+
+namespace
+{
+	constexpr float BoundaryMargin{ 1e-3f };
+
+	enum class eConeTest
+	{
+		Outside,
+		Inside,
+		Boundary
+	};
+
+	eConeTest TestCone(const Elite::Vector2& point, const Elite::Vector2& apex, float orientation, float fovAngle, float range, float cellSize)
+	{
+		const float pi{ static_cast<float>(E_PI) };
+		const float margin{ BoundaryMargin * cellSize };
+
+		const Elite::Vector2 toPoint{ point - apex };
+		const float distance{ toPoint.Magnitude() };
+		if (distance < margin || fabsf(distance - range) < margin) return eConeTest::Boundary;
+		if (distance > range) return eConeTest::Outside;
+
+		const float halfAngle{ (std::min)(fovAngle, 2.f * pi) / 2.f };
+		float angle{ atan2f(toPoint.y, toPoint.x) - orientation };
+		angle = fmodf(angle + pi, 2.f * pi);
+		if (angle < 0.f) angle += 2.f * pi;
+		angle = fabsf(angle - pi);
+
+		//A full circle has no edges
+		if (halfAngle < pi && fabsf(angle - halfAngle) * distance < margin) return eConeTest::Boundary;
+		return angle <= halfAngle ? eConeTest::Inside : eConeTest::Outside;
+	}
+
+	bool RunMap(const Elite::Vector2& origin, float cellSize, int nrColumns, int nrRows, int nrCones, unsigned int seed)
+	{
+		const int nrCells{ nrColumns * nrRows };
+
+		SeenMap seenMap{};
+		seenMap.Initialize(origin, cellSize, nrColumns, nrRows);
+		std::vector<uint8_t> isSeen(static_cast<size_t>(nrCells));
+
+		std::mt19937 randomEngine{ seed };
+		std::uniform_real_distribution<float> xDistribution{ origin.x - 5.f * cellSize, origin.x + (nrColumns + 5) * cellSize };
+		std::uniform_real_distribution<float> yDistribution{ origin.y - 5.f * cellSize, origin.y + (nrRows + 5) * cellSize };
+		std::uniform_real_distribution<float> unitDistribution{ 0.f, 1.f };
+		std::uniform_int_distribution<int> cellDistribution{ 0, nrCells - 1 };
+
+		const float pi{ static_cast<float>(E_PI) };
+		std::vector<int> newlySeen{};
+
+		for (int cone{}; cone < nrCones; ++cone)
+		{
+			const Elite::Vector2 apex{ xDistribution(randomEngine), yDistribution(randomEngine) };
+			const float orientation{ (unitDistribution(randomEngine) * 2.f - 1.f) * 2.f * pi };
+			const float fovAngle{ unitDistribution(randomEngine) * 2.2f * pi };
+			const float range{ unitDistribution(randomEngine) * 12.f * cellSize };
+
+			//Now and then a cell is forgotten again, so cones also land on unseen cells later on
+			if (cone % 4 == 0)
+			{
+				const int index{ cellDistribution(randomEngine) };
+				seenMap.SetSeen(index, false);
+				isSeen[index] = 0;
+			}
+
+			newlySeen.clear();
+			seenMap.StampViewCone(apex, orientation, fovAngle, range, newlySeen);
+
+			std::vector<uint8_t> isNewlySeen(static_cast<size_t>(nrCells));
+			for (int index : newlySeen)
+			{
+				if (isNewlySeen[index])
+				{
+					std::cout << "Cone " << cone << ": cell " << index << " is reported as newly seen twice\n";
+					return false;
+				}
+
+				isNewlySeen[index] = 1;
+			}
+
+			for (int index{}; index < nrCells; ++index)
+			{
+				//Outline cells included, exactly the bits that flipped are reported
+				if ((seenMap.IsSeen(index) && !isSeen[index]) != (isNewlySeen[index] != 0))
+				{
+					std::cout << "Cone " << cone << ": cell " << index << (isNewlySeen[index] ? " is" : " is not") << " reported as newly seen\n";
+					return false;
+				}
+
+				const int column{ index / nrRows };
+				const int row{ index % nrRows };
+				const Elite::Vector2 center{ origin.x + column * cellSize, origin.y + row * cellSize };
+
+				const eConeTest test{ TestCone(center, apex, orientation, fovAngle, range, cellSize) };
+				if (test == eConeTest::Boundary) continue;
+
+				//Outside the cone a cell keeps its bit, inside it is set
+				const bool isExpected{ test == eConeTest::Inside || isSeen[index] != 0 };
+				if (seenMap.IsSeen(index) != isExpected)
+				{
+					std::cout << "Cone " << cone << " at (" << apex.x << ", " << apex.y << "), orientation " << orientation << ", fov " << fovAngle
+						<< ", range " << range << ": cell " << index << " is " << (seenMap.IsSeen(index) ? "seen" : "not seen")
+						<< ", the point test puts it " << (test == eConeTest::Inside ? "inside" : "outside") << "\n";
+					return false;
+				}
+			}
+
+			//Cells on the outline follow the map, so the coverage is compared with the map's own bits
+			for (int index{}; index < nrCells; ++index)
+			{
+				isSeen[index] = seenMap.IsSeen(index) ? 1 : 0;
+			}
+
+			const int nrSeen{ static_cast<int>(std::count(isSeen.begin(), isSeen.end(), 1)) };
+			if (seenMap.GetNrSeen() != nrSeen)
+			{
+				std::cout << "Cone " << cone << ": " << seenMap.GetNrSeen() << " cells seen, the cells give " << nrSeen << "\n";
+				return false;
+			}
+
+			std::uniform_int_distribution<int> columnDistribution{ -2, nrColumns + 1 };
+			std::uniform_int_distribution<int> rowDistribution{ -2, nrRows + 1 };
+			const int firstColumn{ columnDistribution(randomEngine) };
+			const int lastColumn{ columnDistribution(randomEngine) };
+			const int firstRow{ rowDistribution(randomEngine) };
+			const int lastRow{ rowDistribution(randomEngine) };
+
+			int nrSeenInRectangle{};
+			for (int column{ (std::max)(firstColumn, 0) }; column <= (std::min)(lastColumn, nrColumns - 1); ++column)
+			{
+				for (int row{ (std::max)(firstRow, 0) }; row <= (std::min)(lastRow, nrRows - 1); ++row)
+				{
+					nrSeenInRectangle += isSeen[column * nrRows + row];
+				}
+			}
+
+			if (seenMap.CountSeen(firstColumn, lastColumn, firstRow, lastRow) != nrSeenInRectangle)
+			{
+				std::cout << "Cone " << cone << ": columns " << firstColumn << " to " << lastColumn << ", rows " << firstRow << " to " << lastRow
+					<< " count " << seenMap.CountSeen(firstColumn, lastColumn, firstRow, lastRow) << " seen, the cells give " << nrSeenInRectangle << "\n";
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	HeadlessCheck::Arguments arguments{ 3000 };
+	if (!HeadlessCheck::ReadArguments(argc, argv, "cones", arguments)) return 1;
+
+	struct MapShape
+	{
+		Elite::Vector2 Origin;
+		float CellSize;
+		int NrColumns;
+		int NrRows;
+	};
+
+	//Rows that fill a word exactly, rows that straddle words and a single column
+	const MapShape shapes[]{ { { -150.f, -150.f }, 10.f, 32, 64 }, { { 12.5f, -40.f }, 2.5f, 71, 37 }, { { 0.f, 0.f }, 1.f, 1, 200 } };
+	auto getName = [](const MapShape& shape) { return "Seen map of " + std::to_string(shape.NrColumns) + " x " + std::to_string(shape.NrRows) + " cells"; };
+
+	return HeadlessCheck::CheckShapes(shapes, arguments, "cones", getName, [&](const MapShape& shape)
+	{
+		return RunMap(shape.Origin, shape.CellSize, shape.NrColumns, shape.NrRows, arguments.Count, arguments.Seed);
+	});
+}
@@ -0,0 +1,232 @@
+#include "stdafx.h"
+#include "TimerWheel.h"
+#include "HeadlessCheck.h"
+
+//Usage: TimerWheelCheck [--steps 20000] [--seed 1]
+//Schedules and cancels random timers, from outside and from inside callbacks, and advances the wheel by random steps
+//from a fraction of a tick to hours, with delays beyond the span of its coarsest level
+//Every timer is also kept in a sorted list with the expiry tick the wheel rounds its time up to, and the wheel has to fire
+//it in the Advance that reaches that tick, never before, with the ticks of one Advance in order
+//Cancels and stale handles have to agree with the list
+//Returns 1 at the first difference
+
+namespace
+{
+	constexpr float Resolution{ 1.f / 60.f };
+
+	class TimerCheck final
+	{
+	public:
+		explicit TimerCheck(unsigned int seed)
+			: m_Wheel{ Resolution }
+			, m_RandomEngine{ seed }
+		{
+		}
+
+		bool Run(int nrSteps)
+		{
+			for (m_Step = 0; m_Step < nrSteps && m_IsValid; ++m_Step)
+			{
+				const int operation{ std::uniform_int_distribution<int>{ 0, 99 }(m_RandomEngine) };
+
+				if (operation < 40) Schedule();
+				else if (operation < 50) CancelRandom();
+				else if (operation < 55) CancelStale();
+				else Advance();
+
+				CheckPending();
+			}
+
+			return m_IsValid;
+		}
+
+		int GetNrFired() const { return m_NrFired; }
+
+	private:
+		struct ListedTimer
+		{
+			int Id;
+			int64_t ExpiryTick;
+			TimerWheel::Handle Handle;
+		};
+
+		TimerWheel m_Wheel;
+		std::mt19937 m_RandomEngine;
+
+		//Pending timers sorted on expiry tick, ties in the order they were scheduled
+		std::vector<ListedTimer> m_Timers{};
+		std::vector<TimerWheel::Handle> m_StaleHandles{};
+
+		int m_Step{};
+		int m_NextId{};
+		int m_NrFired{};
+		bool m_IsValid{ true };
+
+		//Tick the wheel is at, the one being processed while a callback runs
+		int64_t m_CurrentTick{};
+		int64_t m_TargetTick{};
+		bool m_IsAdvancing{};
+
+		float GetRandomDelay()
+		{
+			const int kind{ std::uniform_int_distribution<int>{ 0, 9 }(m_RandomEngine) };
+			std::uniform_real_distribution<float> unitDistribution{ 0.f, 1.f };
+
+			//Within the tick, within the first levels, house revisits and beyond a full round of the wheel
+			if (kind == 0) return 0.f;
+			if (kind < 3) return unitDistribution(m_RandomEngine) * Resolution;
+			if (kind < 7) return unitDistribution(m_RandomEngine) * 60.f;
+			if (kind < 9) return unitDistribution(m_RandomEngine) * 3600.f;
+			return unitDistribution(m_RandomEngine) * 600000.f;
+		}
+
+		void Schedule()
+		{
+			const float delay{ GetRandomDelay() };
+			const int id{ m_NextId++ };
+
+			//Same rounding as the wheel
+			const double resolution{ Resolution };
+			const int64_t expiryTick{ (std::max)(static_cast<int64_t>(std::ceil((m_Wheel.GetTime() + delay) / resolution)), m_CurrentTick + 1) };
+
+			const TimerWheel::Handle handle{ m_Wheel.Schedule(delay, [this, id]() { Fire(id); }) };
+
+			const auto position{ std::upper_bound(m_Timers.begin(), m_Timers.end(), expiryTick, [](int64_t tick, const ListedTimer& timer) { return tick < timer.ExpiryTick; }) };
+			m_Timers.insert(position, ListedTimer{ id, expiryTick, handle });
+		}
+
+		void CancelRandom()
+		{
+			if (m_Timers.empty()) return;
+
+			const size_t index{ std::uniform_int_distribution<size_t>{ 0, m_Timers.size() - 1 }(m_RandomEngine) };
+			TimerWheel::Handle handle{ m_Timers[index].Handle };
+			const TimerWheel::Handle staleHandle{ handle };
+			m_Timers.erase(m_Timers.begin() + index);
+
+			if (!m_Wheel.Cancel(handle))
+			{
+				Fail("cancelling a pending timer returned false");
+				return;
+			}
+
+			if (handle.Index != -1) Fail("a cancelled handle was not reset");
+			m_StaleHandles.push_back(staleHandle);
+		}
+
+		//The node of a fired or cancelled timer can already hold a new one, which the old handle must not touch
+		void CancelStale()
+		{
+			if (m_StaleHandles.empty()) return;
+
+			const size_t index{ std::uniform_int_distribution<size_t>{ 0, m_StaleHandles.size() - 1 }(m_RandomEngine) };
+			TimerWheel::Handle handle{ m_StaleHandles[index] };
+
+			if (m_Wheel.IsPending(handle) || m_Wheel.Cancel(handle)) Fail("a stale handle still refers to a timer");
+		}
+
+		void Advance()
+		{
+			const int kind{ std::uniform_int_distribution<int>{ 0, 19 }(m_RandomEngine) };
+			std::uniform_real_distribution<float> unitDistribution{ 0.f, 1.f };
+
+			//Mostly frames, now and then a long stall and rarely hours, so the clock passes a full round of the coarsest level
+			//The wheel visits every tick that passes, which keeps the jumps to hours rather than days
+			float dt{ unitDistribution(m_RandomEngine) * 2.f * Resolution };
+			if (kind >= 16) dt = unitDistribution(m_RandomEngine) * 120.f;
+			if (kind == 19) dt = unitDistribution(m_RandomEngine) * 7200.f;
+
+			const double resolution{ Resolution };
+			m_TargetTick = static_cast<int64_t>(std::floor((m_Wheel.GetTime() + dt) / resolution));
+			m_IsAdvancing = true;
+
+			m_Wheel.Advance(dt);
+
+			m_IsAdvancing = false;
+			m_CurrentTick = m_TargetTick;
+
+			if (!m_Timers.empty() && m_Timers.front().ExpiryTick <= m_CurrentTick)
+			{
+				Fail("timer " + std::to_string(m_Timers.front().Id) + " due at tick " + std::to_string(m_Timers.front().ExpiryTick) + " did not fire");
+			}
+		}
+
+		void Fire(int id)
+		{
+			++m_NrFired;
+
+			const auto timer{ std::find_if(m_Timers.begin(), m_Timers.end(), [id](const ListedTimer& listedTimer) { return listedTimer.Id == id; }) };
+			if (!m_IsAdvancing || timer == m_Timers.end())
+			{
+				Fail("timer " + std::to_string(id) + " fired outside of Advance or after it was cancelled");
+				return;
+			}
+
+			if (timer->ExpiryTick > m_TargetTick || timer->ExpiryTick < m_CurrentTick)
+			{
+				Fail("timer " + std::to_string(id) + " due at tick " + std::to_string(timer->ExpiryTick) + " fired at tick "
+					+ std::to_string(m_CurrentTick) + " of an Advance to tick " + std::to_string(m_TargetTick));
+				return;
+			}
+
+			if (m_Wheel.IsPending(timer->Handle)) Fail("timer " + std::to_string(id) + " is still pending in its callback");
+
+			m_CurrentTick = timer->ExpiryTick;
+			m_StaleHandles.push_back(timer->Handle);
+			m_Timers.erase(timer);
+
+			//Callbacks schedule and cancel timers themselves, like the house revisits and the behavior tree timers
+			const int operation{ std::uniform_int_distribution<int>{ 0, 9 }(m_RandomEngine) };
+			if (operation < 4) Schedule();
+			if (operation == 4) CancelRandom();
+			if (operation == 5)
+			{
+				Schedule();
+				Schedule();
+			}
+		}
+
+		void CheckPending()
+		{
+			if (m_Wheel.GetNrPending() != static_cast<int>(m_Timers.size()))
+			{
+				Fail(std::to_string(m_Wheel.GetNrPending()) + " timers pending, the list holds " + std::to_string(m_Timers.size()));
+				return;
+			}
+
+			for (const ListedTimer& timer : m_Timers)
+			{
+				if (!m_Wheel.IsPending(timer.Handle))
+				{
+					Fail("timer " + std::to_string(timer.Id) + " is not pending");
+					return;
+				}
+			}
+		}
+
+		void Fail(const std::string& message)
+		{
+			if (!m_IsValid) return;
+
+			std::cout << "Step " << m_Step << ": " << message << "\n";
+			m_IsValid = false;
+		}
+	};
+}
+
+int main(int argc, char* argv[])
+{
+	HeadlessCheck::Arguments arguments{ 20000 };
+	if (!HeadlessCheck::ReadArguments(argc, argv, "steps", arguments)) return 1;
+
+	//A single wheel, there are no shapes to go through
+	TimerCheck check{ arguments.Seed };
+	if (!check.Run(arguments.Count))
+	{
+		std::cout << "The timer wheel differs from the sorted list\n";
+		return 1;
+	}
+
+	std::cout << arguments.Count << " steps match, " << check.GetNrFired() << " timers fired\n";
+	return 0;
+}
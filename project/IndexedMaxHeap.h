@@ -0,0 +1,146 @@
+#pragma once
+
+//Binary max-heap over the ids [0, capacity), every id is in the heap at most once
+//The heap keeps its own copy of the keys, so the position of every id is known and its key can be changed in O(log n)
+//Equal keys are ordered by id, the highest id comes first
+template<typename T_Key>
+class IndexedMaxHeap final
+{
+public:
+	explicit IndexedMaxHeap(int capacity = 0) { Reset(capacity); }
+	~IndexedMaxHeap() = default;
+
+	IndexedMaxHeap(const IndexedMaxHeap& other) = delete;
+	IndexedMaxHeap& operator=(const IndexedMaxHeap& other) = delete;
+	IndexedMaxHeap(IndexedMaxHeap&& other) = delete;
+	IndexedMaxHeap& operator=(IndexedMaxHeap&& other) = delete;
+
+	//Empties the heap and allows ids up to capacity
+	void Reset(int capacity)
+	{
+		m_Heap.clear();
+		m_Heap.reserve(capacity);
+		m_Positions.assign(capacity, -1);
+		m_Keys.assign(capacity, T_Key{});
+	}
+
+	bool Contains(int id) const { return m_Positions[id] >= 0; }
+	const T_Key& GetKey(int id) const { return m_Keys[id]; }
+
+	//O(1), -1 when empty
+	int GetTop() const { return m_Heap.empty() ? -1 : m_Heap.front(); }
+
+	bool empty() const { return m_Heap.empty(); }
+	size_t size() const { return m_Heap.size(); }
+
+	//O(log n), adds the id or changes its key when it is already in the heap
+	void Set(int id, const T_Key& key)
+	{
+		if (!Contains(id))
+		{
+			m_Keys[id] = key;
+			m_Positions[id] = static_cast<int>(m_Heap.size());
+			m_Heap.push_back(id);
+			SiftUp(m_Positions[id]);
+			return;
+		}
+
+		const bool isIncrease{ m_Keys[id] < key };
+		m_Keys[id] = key;
+
+		if (isIncrease) SiftUp(m_Positions[id]);
+		else SiftDown(m_Positions[id]);
+	}
+
+	//O(log n), ids that are not in the heap are ignored
+	void Remove(int id)
+	{
+		if (!Contains(id)) return;
+
+		const int position{ m_Positions[id] };
+		const int lastId{ m_Heap.back() };
+
+		m_Heap.pop_back();
+		m_Positions[id] = -1;
+		if (lastId == id) return;
+
+		m_Heap[position] = lastId;
+		m_Positions[lastId] = position;
+
+		SiftUp(position);
+		SiftDown(m_Positions[lastId]);
+	}
+
+	//O(n), replaces the content with the given ids, whose keys have to be set with SetKeyUnordered first
+	template<typename Iterator>
+	void Assign(Iterator first, Iterator last)
+	{
+		for (int id : m_Heap)
+		{
+			m_Positions[id] = -1;
+		}
+		m_Heap.assign(first, last);
+
+		for (int position{}; position < static_cast<int>(m_Heap.size()); ++position)
+		{
+			m_Positions[m_Heap[position]] = position;
+		}
+
+		for (int position{ static_cast<int>(m_Heap.size()) / 2 - 1 }; position >= 0; --position)
+		{
+			SiftDown(position);
+		}
+	}
+
+	//Changes the key without restoring the heap order, only valid right before Assign
+	void SetKeyUnordered(int id, const T_Key& key) { m_Keys[id] = key; }
+
+private:
+	std::vector<int> m_Heap{};
+	std::vector<int> m_Positions{};
+	std::vector<T_Key> m_Keys{};
+
+	bool IsBefore(int id, int otherId) const
+	{
+		if (m_Keys[otherId] < m_Keys[id]) return true;
+		if (m_Keys[id] < m_Keys[otherId]) return false;
+		return otherId < id;
+	}
+
+	void Swap(int position, int otherPosition)
+	{
+		std::swap(m_Heap[position], m_Heap[otherPosition]);
+		m_Positions[m_Heap[position]] = position;
+		m_Positions[m_Heap[otherPosition]] = otherPosition;
+	}
+
+	void SiftUp(int position)
+	{
+		while (position > 0)
+		{
+			const int parent{ (position - 1) / 2 };
+			if (!IsBefore(m_Heap[position], m_Heap[parent])) return;
+
+			Swap(position, parent);
+			position = parent;
+		}
+	}
+
+	void SiftDown(int position)
+	{
+		const int count{ static_cast<int>(m_Heap.size()) };
+
+		for (;;)
+		{
+			const int left{ 2 * position + 1 };
+			if (left >= count) return;
+
+			const int right{ left + 1 };
+			const int child{ right < count && IsBefore(m_Heap[right], m_Heap[left]) ? right : left };
+			if (!IsBefore(m_Heap[child], m_Heap[position])) return;
+
+			Swap(position, child);
+			position = child;
+		}
+	}
+};
@@ -0,0 +1,249 @@
+#include "stdafx.h"
+#include "InfluenceKernels.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define INFLUENCE_KERNELS_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define INFLUENCE_TARGET_AVX2
+#else
+#define INFLUENCE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace InfluenceKernels
+{
+	namespace
+	{
+		void AddInverseCubeScalar(const InverseCubeArguments& arguments, int first)
+		{
+			const bool isTruncated{ arguments.MaxNrCells > 0.f };
+
+			for (int idx{ first }; idx < arguments.Count; ++idx)
+			{
+				const float dx{ arguments.SourceX - arguments.pPositionsX[idx] };
+				const float dy{ arguments.SourceY - arguments.pPositionsY[idx] };
+				const float nrCellsAway{ (std::max)(sqrtf(dx * dx + dy * dy) / arguments.CellSize, MinNrCellsAway) };
+				if (isTruncated && nrCellsAway > arguments.MaxNrCells) continue;
+
+				arguments.pInfluence[idx] += arguments.Weight / (nrCellsAway * nrCellsAway * nrCellsAway);
+			}
+		}
+
+		void AddInverseCubeScalar(const InverseCubeArguments& arguments)
+		{
+			AddInverseCubeScalar(arguments, 0);
+		}
+
+		void WeightedSumScalar(const WeightedSumArguments& arguments, int first)
+		{
+			for (int idx{ first }; idx < arguments.Count; ++idx)
+			{
+				float sum{ arguments.Weights[0] * arguments.pPlanes[0][idx] };
+				for (int plane{ 1 }; plane < arguments.NrPlanes; ++plane)
+				{
+					sum += arguments.Weights[plane] * arguments.pPlanes[plane][idx];
+				}
+
+				arguments.pOutput[idx] = sum;
+			}
+		}
+
+		void WeightedSumScalar(const WeightedSumArguments& arguments)
+		{
+			WeightedSumScalar(arguments, 0);
+		}
+
+#ifdef INFLUENCE_KERNELS_X86
+		//4 cells per instruction, SSE2 is part of every x64 CPU
+		void AddInverseCubeSSE2(const InverseCubeArguments& arguments)
+		{
+			const bool isTruncated{ arguments.MaxNrCells > 0.f };
+
+			const __m128 sourceX{ _mm_set1_ps(arguments.SourceX) };
+			const __m128 sourceY{ _mm_set1_ps(arguments.SourceY) };
+			const __m128 cellSize{ _mm_set1_ps(arguments.CellSize) };
+			const __m128 weight{ _mm_set1_ps(arguments.Weight) };
+			const __m128 maxNrCells{ _mm_set1_ps(arguments.MaxNrCells) };
+			const __m128 minNrCells{ _mm_set1_ps(MinNrCellsAway) };
+
+			int idx{};
+			for (; idx + 4 <= arguments.Count; idx += 4)
+			{
+				const __m128 dx{ _mm_sub_ps(sourceX, _mm_loadu_ps(arguments.pPositionsX + idx)) };
+				const __m128 dy{ _mm_sub_ps(sourceY, _mm_loadu_ps(arguments.pPositionsY + idx)) };
+				const __m128 nrCellsAway{ _mm_max_ps(_mm_div_ps(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy))), cellSize), minNrCells) };
+
+				__m128 contribution{ _mm_div_ps(weight, _mm_mul_ps(_mm_mul_ps(nrCellsAway, nrCellsAway), nrCellsAway)) };
+				if (isTruncated)
+				{
+					contribution = _mm_and_ps(contribution, _mm_cmple_ps(nrCellsAway, maxNrCells));
+				}
+
+				float* pInfluence{ arguments.pInfluence + idx };
+				_mm_storeu_ps(pInfluence, _mm_add_ps(_mm_loadu_ps(pInfluence), contribution));
+			}
+
+			AddInverseCubeScalar(arguments, idx);
+		}
+
+		void WeightedSumSSE2(const WeightedSumArguments& arguments)
+		{
+			__m128 weights[WeightedSumArguments::MaxNrPlanes]{};
+			for (int plane{}; plane < arguments.NrPlanes; ++plane)
+			{
+				weights[plane] = _mm_set1_ps(arguments.Weights[plane]);
+			}
+
+			int idx{};
+			for (; idx + 4 <= arguments.Count; idx += 4)
+			{
+				__m128 sum{ _mm_mul_ps(weights[0], _mm_loadu_ps(arguments.pPlanes[0] + idx)) };
+				for (int plane{ 1 }; plane < arguments.NrPlanes; ++plane)
+				{
+					sum = _mm_add_ps(sum, _mm_mul_ps(weights[plane], _mm_loadu_ps(arguments.pPlanes[plane] + idx)));
+				}
+
+				_mm_storeu_ps(arguments.pOutput + idx, sum);
+			}
+
+			WeightedSumScalar(arguments, idx);
+		}
+
+		//8 cells per instruction
+		INFLUENCE_TARGET_AVX2 void AddInverseCubeAVX2(const InverseCubeArguments& arguments)
+		{
+			const bool isTruncated{ arguments.MaxNrCells > 0.f };
+
+			const __m256 sourceX{ _mm256_set1_ps(arguments.SourceX) };
+			const __m256 sourceY{ _mm256_set1_ps(arguments.SourceY) };
+			const __m256 cellSize{ _mm256_set1_ps(arguments.CellSize) };
+			const __m256 weight{ _mm256_set1_ps(arguments.Weight) };
+			const __m256 maxNrCells{ _mm256_set1_ps(arguments.MaxNrCells) };
+			const __m256 minNrCells{ _mm256_set1_ps(MinNrCellsAway) };
+
+			int idx{};
+			for (; idx + 8 <= arguments.Count; idx += 8)
+			{
+				const __m256 dx{ _mm256_sub_ps(sourceX, _mm256_loadu_ps(arguments.pPositionsX + idx)) };
+				const __m256 dy{ _mm256_sub_ps(sourceY, _mm256_loadu_ps(arguments.pPositionsY + idx)) };
+				const __m256 nrCellsAway{ _mm256_max_ps(_mm256_div_ps(_mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy))), cellSize), minNrCells) };
+
+				__m256 contribution{ _mm256_div_ps(weight, _mm256_mul_ps(_mm256_mul_ps(nrCellsAway, nrCellsAway), nrCellsAway)) };
+				if (isTruncated)
+				{
+					contribution = _mm256_and_ps(contribution, _mm256_cmp_ps(nrCellsAway, maxNrCells, _CMP_LE_OQ));
+				}
+
+				float* pInfluence{ arguments.pInfluence + idx };
+				_mm256_storeu_ps(pInfluence, _mm256_add_ps(_mm256_loadu_ps(pInfluence), contribution));
+			}
+
+			//Leaves the upper halves of the registers clean before the SSE tail
+			_mm256_zeroupper();
+			AddInverseCubeScalar(arguments, idx);
+		}
+
+		INFLUENCE_TARGET_AVX2 void WeightedSumAVX2(const WeightedSumArguments& arguments)
+		{
+			__m256 weights[WeightedSumArguments::MaxNrPlanes]{};
+			for (int plane{}; plane < arguments.NrPlanes; ++plane)
+			{
+				weights[plane] = _mm256_set1_ps(arguments.Weights[plane]);
+			}
+
+			int idx{};
+			for (; idx + 8 <= arguments.Count; idx += 8)
+			{
+				__m256 sum{ _mm256_mul_ps(weights[0], _mm256_loadu_ps(arguments.pPlanes[0] + idx)) };
+				for (int plane{ 1 }; plane < arguments.NrPlanes; ++plane)
+				{
+					sum = _mm256_add_ps(sum, _mm256_mul_ps(weights[plane], _mm256_loadu_ps(arguments.pPlanes[plane] + idx)));
+				}
+
+				_mm256_storeu_ps(arguments.pOutput + idx, sum);
+			}
+
+			_mm256_zeroupper();
+			WeightedSumScalar(arguments, idx);
+		}
+
+		bool IsAVX2Supported()
+		{
+#ifdef _MSC_VER
+			int info[4]{};
+			__cpuid(info, 0);
+			if (info[0] < 7) return false;
+
+			//The OS has to save the YMM registers as well
+			__cpuid(info, 1);
+			const bool isOSXSaveSupported{ (info[2] & (1 << 27)) != 0 };
+			const bool isAVXSupported{ (info[2] & (1 << 28)) != 0 };
+			if (!isOSXSaveSupported || !isAVXSupported) return false;
+			if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#else
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2") != 0;
+#endif
+		}
+#endif
+	}
+
+	const char* ToString(eInstructionSet instructionSet)
+	{
+		switch (instructionSet)
+		{
+		case eInstructionSet::SSE2: return "sse2";
+		case eInstructionSet::AVX2: return "avx2";
+		default: return "scalar";
+		}
+	}
+
+	eInstructionSet GetSupportedInstructionSet()
+	{
+#ifdef INFLUENCE_KERNELS_X86
+		static const eInstructionSet supported{ IsAVX2Supported() ? eInstructionSet::AVX2 : eInstructionSet::SSE2 };
+		return supported;
+#else
+		return eInstructionSet::Scalar;
+#endif
+	}
+
+	InverseCubeKernel GetInverseCubeKernel(eInstructionSet instructionSet)
+	{
+		if (static_cast<int>(instructionSet) > static_cast<int>(GetSupportedInstructionSet()))
+		{
+			instructionSet = GetSupportedInstructionSet();
+		}
+
+		switch (instructionSet)
+		{
+#ifdef INFLUENCE_KERNELS_X86
+		case eInstructionSet::SSE2: return AddInverseCubeSSE2;
+		case eInstructionSet::AVX2: return AddInverseCubeAVX2;
+#endif
+		default: return AddInverseCubeScalar;
+		}
+	}
+
+	WeightedSumKernel GetWeightedSumKernel(eInstructionSet instructionSet)
+	{
+		if (static_cast<int>(instructionSet) > static_cast<int>(GetSupportedInstructionSet()))
+		{
+			instructionSet = GetSupportedInstructionSet();
+		}
+
+		switch (instructionSet)
+		{
+#ifdef INFLUENCE_KERNELS_X86
+		case eInstructionSet::SSE2: return WeightedSumSSE2;
+		case eInstructionSet::AVX2: return WeightedSumAVX2;
+#endif
+		default: return WeightedSumScalar;
+		}
+	}
+}
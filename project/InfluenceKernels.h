@@ -0,0 +1,56 @@
+#pragma once
+
+//Vectorized influence accumulation over structure-of-arrays cell positions
+//Every kernel produces the same floats as the scalar one: the same operations in the same order, no fused multiply-add
+namespace InfluenceKernels
+{
+	enum class eInstructionSet
+	{
+		Scalar,
+		SSE2,
+		AVX2
+	};
+
+	const char* ToString(eInstructionSet instructionSet);
+
+	//Best instruction set the CPU and OS support, detected once
+	eInstructionSet GetSupportedInstructionSet();
+
+	//Distances are clamped to this many cells, a source on a cell's center would otherwise add inf and later NaN to it
+	constexpr float MinNrCellsAway{ 0.1f };
+
+	//For i in [0, count): influence[i] += weight / max(distance(position[i], source) / cellSize, MinNrCellsAway)^3
+	//Cells further than maxNrCells away are skipped, 0 disables the cutoff
+	struct InverseCubeArguments
+	{
+		const float* pPositionsX;
+		const float* pPositionsY;
+		float* pInfluence;
+		int Count;
+
+		float SourceX;
+		float SourceY;
+		float CellSize;
+		float Weight;
+		float MaxNrCells;
+	};
+	using InverseCubeKernel = void(*)(const InverseCubeArguments& arguments);
+
+	//For i in [0, count): output[i] = weight[0] * plane[0][i] + weight[1] * plane[1][i] + ..., summed in plane order
+	struct WeightedSumArguments
+	{
+		static constexpr int MaxNrPlanes{ 4 };
+
+		const float* pPlanes[MaxNrPlanes];
+		float Weights[MaxNrPlanes];
+		int NrPlanes;
+
+		float* pOutput;
+		int Count;
+	};
+	using WeightedSumKernel = void(*)(const WeightedSumArguments& arguments);
+
+	//Falls back to the best supported kernel when the requested one is not available
+	InverseCubeKernel GetInverseCubeKernel(eInstructionSet instructionSet);
+	WeightedSumKernel GetWeightedSumKernel(eInstructionSet instructionSet);
+}
@@ -4,11 +4,20 @@
 #include "SteeringBehaviors.h"
 #include "CombinedSteeringBehaviors.h"
 #include "Behaviors.h"
+#include "BlackboardKeys.h"
+#include "PluginConfig.h"
+#include "Tracing.h"
 
 
 
 using namespace std;
 
+//ENTRY
+IPluginBase* Register()
+{
+	return new Plugin();
+}
+
 //Called only once (first)
 void Plugin::DllInit()
 {
@@ -21,6 +30,8 @@ void Plugin::Initialize(IBaseInterface* pInterface, PluginInfo& info)
 	//This interface gives you access to certain actions the AI_Framework can perform for you
 	m_pInterface = static_cast<IExamInterface*>(pInterface);
 
+	Tracing::Initialize();
+
 	//Bit information about the plugin
 	//Please fill this in!!
 	info.BotName = "MinionExam";
@@ -34,43 +45,30 @@ void Plugin::Initialize(IBaseInterface* pInterface, PluginInfo& info)
 		m_Inventory.push_back(std::make_pair(index, InventoryItemType::Empty));
 	}
 
-	//World Grid
-	WorldInfo world{ m_pInterface->World_GetInfo() };
+	//World Grid, the resolution can be raised for large maps
+	m_NrGridColumns = (std::max)(PluginConfig::ReadInt("PLUGIN_GRID_COLUMNS", m_NrGridColumns), 1);
 
-	const Elite::Vector2 startPos{ world.Center - world.Dimensions / 2.f };
+	m_pGrid = new ExplorationGrid{ m_pInterface->World_GetInfo(), m_NrGridColumns };
 
-	constexpr int nrCells{ 15 };
-	m_CellSize = world.Dimensions.x / nrCells;
+	//Optional truncation of the house influence, in cells
+	m_pGrid->SetInfluenceRadius(PluginConfig::ReadFloat("PLUGIN_INFLUENCE_RADIUS", m_pGrid->GetInfluenceRadius()));
 
-	for (int x{}; x < nrCells; ++x)
+	//Optional layer weights as "house,threat,purge,fog", missing ones keep their default
+	const std::vector<float> layerWeights{ PluginConfig::ReadFloatList("PLUGIN_INFLUENCE_WEIGHTS") };
+	for (int layer{}; layer < ExplorationGrid::NrLayers && layer < static_cast<int>(layerWeights.size()); ++layer)
 	{
-		for (int y{}; y < nrCells; ++y)
-		{
-			GridElement* pGridElement{ new GridElement };
-
-			pGridElement->Position = startPos;
-
-			pGridElement->Position.x += x * m_CellSize;
-			pGridElement->Position.y += y * m_CellSize;
-
-			m_pGrid.push_back(pGridElement);
-			m_pCurrentGridElement = pGridElement;
-		}
+		m_pGrid->SetLayerWeight(static_cast<eInfluenceLayer>(layer), layerWeights[layer]);
 	}
 
-	const float offset{ 10.f };
-	for (size_t index{}; index < m_pGrid.size(); ++index)
-	{
-		for (size_t idx{}; idx < m_pGrid.size(); ++idx)
-		{
-			if (index == idx) continue;
+	//"0" only marks the cells the agent walks through as visited
+	m_IsViewConeExplorationEnabled = PluginConfig::ReadString("PLUGIN_VIEW_CONE_EXPLORATION") != "0";
 
-			if (m_pGrid[index]->Position.Distance(m_pGrid[idx]->Position) < m_CellSize + offset)
-			{
-				m_pGrid[index]->pNeighbors.push_back(m_pGrid[idx]);
-			}
-		}
-	}
+	m_CellSize = m_pGrid->GetCellSize();
+	m_CurrentCellIndex = m_pGrid->GetNrCells() - 1;
+
+	//Layers without weight are never refreshed
+	if (m_pGrid->GetLayerWeight(eInfluenceLayer::Threat) != 0.f) ScheduleThreatDecay();
+	if (m_pGrid->GetLayerWeight(eInfluenceLayer::PurgeDanger) != 0.f) SchedulePurgeDangerRebuild();
 
 	//Called when the plugin is loaded
 	m_pSeekBehaviour = new Seek();
@@ -90,149 +88,164 @@ void Plugin::Initialize(IBaseInterface* pInterface, PluginInfo& info)
 		new Elite::BehaviorSelector(
 		{
 			//Item usage
-			new Elite::BehaviorAction(BT_Actions::HandleFoodAndMedkitUsage),
+			new Elite::BehaviorAction(BT_Actions::HandleFoodAndMedkitUsage, "HandleFoodAndMedkitUsage"),
 			//Enemies
 			new Elite::BehaviorSelector(
 			{
 				//Enemy in view
 				new Elite::BehaviorSequence(
 				{
-					new Elite::BehaviorConditional(BT_Conditions::IsEnemyInVector),
-					new Elite::BehaviorAction(BT_Actions::SetClosestEnemyAsTarget),
+					new Elite::BehaviorConditional(BT_Conditions::IsEnemyInVector, "IsEnemyInVector"),
+					new Elite::BehaviorAction(BT_Actions::SetClosestEnemyAsTarget, "SetClosestEnemyAsTarget"),
 					new Elite::BehaviorSelector(
 					{
 						//Agent has no weapon
 						new Elite::BehaviorSequence(
 						{
-							new Elite::BehaviorConditional(BT_Conditions::HasNoWeapon),
-							new Elite::BehaviorAction(BT_Actions::SetRunning),
-							new Elite::BehaviorAction(BT_Actions::ChangeToFleeAndFaceTarget)
+							new Elite::BehaviorConditional(BT_Conditions::HasNoWeapon, "HasNoWeapon"),
+							new Elite::BehaviorAction(BT_Actions::SetRunning, "SetRunning"),
+							new Elite::BehaviorAction(BT_Actions::ChangeToFleeAndFaceTarget, "ChangeToFleeAndFaceTarget")
 						}),
 						//Aiming finished
 						new Elite::BehaviorSequence(
 						{
-							new Elite::BehaviorConditional(BT_Conditions::IsAimingFinished),
-							new Elite::BehaviorAction(BT_Actions::HandleShooting)
+							new Elite::BehaviorConditional(BT_Conditions::IsAimingFinished, "IsAimingFinished"),
+							new Elite::BehaviorAction(BT_Actions::HandleShooting, "HandleShooting")
 						}),
 						//Aim at the target
-						new Elite::BehaviorAction(BT_Actions::ChangeToFaceTarget)
+						new Elite::BehaviorAction(BT_Actions::ChangeToFaceTarget, "ChangeToFaceTarget")
 					}),
 				}),
 				//Purge Zones
 				new Elite::BehaviorSequence(
 				{
-					new Elite::BehaviorConditional(BT_Conditions::IsInPurgeZone),
-					new Elite::BehaviorAction(BT_Actions::SetRunning),
-					new Elite::BehaviorAction(BT_Actions::SetClosestPointOutsidePurgeZoneAsTarget),
-					new Elite::BehaviorAction(BT_Actions::ChangeToSeekTarget)
+					new Elite::BehaviorConditional(BT_Conditions::IsInPurgeZone, "IsInPurgeZone"),
+					new Elite::BehaviorAction(BT_Actions::SetRunning, "SetRunning"),
+					new Elite::BehaviorAction(BT_Actions::SetClosestPointOutsidePurgeZoneAsTarget, "SetClosestPointOutsidePurgeZoneAsTarget"),
+					new Elite::BehaviorAction(BT_Actions::ChangeToSeekTarget, "ChangeToSeekTarget")
 				}),
 				//Attack from behind
 				new Elite::BehaviorSequence(
 				{
-					new Elite::BehaviorAction(BT_Actions::HandleAttackFromBehind),
-					new Elite::BehaviorAction(BT_Actions::SetRunning),
-					new Elite::BehaviorAction(BT_Actions::ChangeToFleeAndFaceTarget)
+					new Elite::BehaviorAction(BT_Actions::HandleAttackFromBehind, "HandleAttackFromBehind"),
+					new Elite::BehaviorAction(BT_Actions::SetRunning, "SetRunning"),
+					new Elite::BehaviorAction(BT_Actions::ChangeToFleeAndFaceTarget, "ChangeToFleeAndFaceTarget")
 				})
 			}),
 			//Houses
 			new Elite::BehaviorSequence(
 			{
-				new Elite::BehaviorConditional(BT_Conditions::IsNotVisitedHouseInVector),
-				new Elite::BehaviorAction(BT_Actions::SetClosestNotVisitedHouseAsTarget),
+				new Elite::BehaviorConditional(BT_Conditions::IsNotVisitedHouseInVector, "IsNotVisitedHouseInVector"),
+				new Elite::BehaviorAction(BT_Actions::SetClosestNotVisitedHouseAsTarget, "SetClosestNotVisitedHouseAsTarget"),
 				new Elite::BehaviorSelector(
 				{
 					//Run to nearest house
 					new Elite::BehaviorSequence(
 					{
-						new Elite::BehaviorConditional(BT_Conditions::IsAgentNotInsideTargetHouse),
-						new Elite::BehaviorAction(BT_Actions::ChangeToSeekTarget)
+						new Elite::BehaviorConditional(BT_Conditions::IsAgentNotInsideTargetHouse, "IsAgentNotInsideTargetHouse"),
+						new Elite::BehaviorAction(BT_Actions::ChangeToSeekTarget, "ChangeToSeekTarget")
 					}),
 					//Check the search points
 					new Elite::BehaviorSequence(
 					{
-						new Elite::BehaviorConditional(BT_Conditions::IsNotVisitedSearchPointInHouse),
-						new Elite::BehaviorAction(BT_Actions::SetClosestNotVisitedSearchPointAsTarget),
+						new Elite::BehaviorConditional(BT_Conditions::IsNotVisitedSearchPointInHouse, "IsNotVisitedSearchPointInHouse"),
+						new Elite::BehaviorAction(BT_Actions::SetClosestNotVisitedSearchPointAsTarget, "SetClosestNotVisitedSearchPointAsTarget"),
 						new Elite::BehaviorSelector(
 						{
 							//Rotate
 							new Elite::BehaviorSequence(
 							{
-								new Elite::BehaviorConditional(BT_Conditions::IsRotationNotCompleted),
+								new Elite::BehaviorConditional(BT_Conditions::IsRotationNotCompleted, "IsRotationNotCompleted"),
 								new Elite::BehaviorSelector(
 								{
 									new Elite::BehaviorSequence(
 									{
-										new Elite::BehaviorConditional(BT_Conditions::HasNotArrivedAtLocation),
-										new Elite::BehaviorAction(BT_Actions::ChangeToArriveAtTarget)
+										new Elite::BehaviorConditional(BT_Conditions::HasNotArrivedAtLocation, "HasNotArrivedAtLocation"),
+										new Elite::BehaviorAction(BT_Actions::ChangeToArriveAtTarget, "ChangeToArriveAtTarget")
 									}),
 									new Elite::BehaviorSequence(
 									{
-										new Elite::BehaviorConditional(BT_Conditions::IsAgentNotRotating),
-										new Elite::BehaviorAction(BT_Actions::InitializeRotating),
-										new Elite::BehaviorAction(BT_Actions::ChangeToRotateClockWise)
+										new Elite::BehaviorConditional(BT_Conditions::IsAgentNotRotating, "IsAgentNotRotating"),
+										new Elite::BehaviorAction(BT_Actions::InitializeRotating, "InitializeRotating"),
+										new Elite::BehaviorAction(BT_Actions::ChangeToRotateClockWise, "ChangeToRotateClockWise")
 									}),
 									new Elite::BehaviorSequence(
 									{
-									new Elite::BehaviorAction(BT_Actions::UpdateRotation),
-									new Elite::BehaviorAction(BT_Actions::ChangeToRotateClockWise)
+									new Elite::BehaviorAction(BT_Actions::UpdateRotation, "UpdateRotation"),
+									new Elite::BehaviorAction(BT_Actions::ChangeToRotateClockWise, "ChangeToRotateClockWise")
 									})
 								})
 							}),
 							//Check found items
 							new Elite::BehaviorSequence(
 							{
-								new Elite::BehaviorConditional(BT_Conditions::IsNotVisitedItemInVector),
-								new Elite::BehaviorAction(BT_Actions::SetClosestItemAsTarget),
+								new Elite::BehaviorConditional(BT_Conditions::IsNotVisitedItemInVector, "IsNotVisitedItemInVector"),
+								new Elite::BehaviorAction(BT_Actions::SetClosestItemAsTarget, "SetClosestItemAsTarget"),
 								new Elite::BehaviorSelector(
 								{
 									//Run to nearest item
 									new Elite::BehaviorSequence(
 									{
-										new Elite::BehaviorConditional(BT_Conditions::IsItemNotInGrabRange),
-										new Elite::BehaviorAction(BT_Actions::ChangeToFaceAndSeekTarget)
+										new Elite::BehaviorConditional(BT_Conditions::IsItemNotInGrabRange, "IsItemNotInGrabRange"),
+										new Elite::BehaviorAction(BT_Actions::ChangeToFaceAndSeekTarget, "ChangeToFaceAndSeekTarget")
 									}),
 									//Grab usefull item
 									new Elite::BehaviorSequence(
 									{
-										new Elite::BehaviorConditional(BT_Conditions::IsItemNotGarbage),
-										new Elite::BehaviorAction(BT_Actions::HandleItemGrabbing)
+										new Elite::BehaviorConditional(BT_Conditions::IsItemNotGarbage, "IsItemNotGarbage"),
+										new Elite::BehaviorAction(BT_Actions::HandleItemGrabbing, "HandleItemGrabbing")
 									}),
 									//Destroy not usefull item
-									new Elite::BehaviorAction(BT_Actions::DestroyItem)
+									new Elite::BehaviorAction(BT_Actions::DestroyItem, "DestroyItem")
 								}),
 							}),
 							new Elite::BehaviorSequence(
 							{
-							new Elite::BehaviorAction(BT_Actions::ResetRotation),
-							new Elite::BehaviorAction(BT_Actions::MarkSearchPointAsVisited)
+							new Elite::BehaviorAction(BT_Actions::ResetRotation, "ResetRotation"),
+							new Elite::BehaviorAction(BT_Actions::MarkSearchPointAsVisited, "MarkSearchPointAsVisited")
 							})
 						}),
 					}),
 					//Mark house as visited 
-					new Elite::BehaviorAction(BT_Actions::MarkHouseAsVisited)
+					new Elite::BehaviorAction(BT_Actions::MarkHouseAsVisited, "MarkHouseAsVisited")
 				})
 			}),
 			//Fallback to exploration
 			new Elite::BehaviorSequence(
 			{
-				new Elite::BehaviorAction(BT_Actions::SetBestCellAsTarget),
+				new Elite::BehaviorAction(BT_Actions::SetBestCellAsTarget, "SetBestCellAsTarget"),
 				new Elite::BehaviorSelector(
 				{
 					new Elite::BehaviorSequence(
 					{
-						new Elite::BehaviorConditional(BT_Conditions::ShouldLookBack),
-						new Elite::BehaviorAction(BT_Actions::ChangeToSeekTargetAndFaceBack)
+						new Elite::BehaviorConditional(BT_Conditions::ShouldLookBack, "ShouldLookBack"),
+						new Elite::BehaviorAction(BT_Actions::ChangeToSeekTargetAndFaceBack, "ChangeToSeekTargetAndFaceBack")
 					}),
-					new Elite::BehaviorAction(BT_Actions::ChangeToWanderAndSeekTarget)
+					new Elite::BehaviorAction(BT_Actions::ChangeToWanderAndSeekTarget, "ChangeToWanderAndSeekTarget")
 				}),
 			}) 
 		}));
+
+	//Opt-in node profiling, the annotated tree is written at shutdown
+	m_BehaviorTreeProfileFile = PluginConfig::ReadString("PLUGIN_BT_PROFILE_FILE");
+	if (!m_BehaviorTreeProfileFile.empty())
+	{
+		m_pBehaviourTree->SetProfiling(true);
+	}
 }
 
 //Called only once
 void Plugin::DllShutdown()
 {
 	//Called wheb the plugin gets unloaded
+	Tracing::Shutdown();
+
+	if (!m_BehaviorTreeProfileFile.empty())
+	{
+		std::ofstream profileFile{ m_BehaviorTreeProfileFile };
+		m_pBehaviourTree->WriteProfile(profileFile);
+	}
+
 	delete m_pBehaviourTree;
 	delete m_pArriveBehaviour;
 	delete m_pFleeBehaviour;
@@ -244,7 +257,7 @@ void Plugin::DllShutdown()
 	delete m_pFaceAndSeekBehaviour;
 	delete m_pSeekAndFaceBehaviour;
 
-	for (House* pHouse : m_pHouses)
+	for (House* pHouse : m_Houses)
 	{
 		for (SearchPoint* pSearchPoint :pHouse->pSearchPoints)
 		{
@@ -256,19 +269,16 @@ void Plugin::DllShutdown()
 		pHouse = nullptr;
 	}
 
-	for (GridElement* pGridElement : m_pGrid)
-	{
-		delete pGridElement;
-		pGridElement = nullptr;
-	}
+	delete m_pGrid;
+	m_pGrid = nullptr;
 
-	for (Item* pItem : m_pItems)
+	for (Item* pItem : m_Items)
 	{
 		delete pItem;
 		pItem = nullptr;
 	}
 
-	for (PurgeZone* pPurgeZone : m_pPurgeZones)
+	for (PurgeZone* pPurgeZone : m_PurgeZones)
 	{
 		delete pPurgeZone;
 		pPurgeZone = nullptr;
@@ -305,25 +315,83 @@ void Plugin::Update(float dt)
 //This function calculates the new SteeringPlugin_Output, called once per frame
 SteeringPlugin_Output Plugin::UpdateSteering(float dt)
 {
+	TRACE_ZONE("Plugin::UpdateSteering");
+
 	m_ShouldRun = false;
 	m_DeltaTime = dt;
 
 	m_AgentInfo = m_pInterface->Agent_GetInfo();
 
-	bool shouldRecalculateInfluence{ false };
-
 	//Update field of view
-	auto vHousesInFOV = GetHousesInFOV();//uses m_pInterface->Fov_GetHouseByIndex(...)
-	auto vEntitiesInFOV = GetEntitiesInFOV(); //uses m_pInterface->Fov_GetEntityByIndex(...)
+	UpdateFov();
+
+	UpdateHouses();
+	UpdateEntities();
 
-	for (auto& e : vHousesInFOV)
+	m_Timers.Advance(dt);
+	UpdateCurrentGridElement();
+	UpdateInfluence();
+	
+	//Behaviours
 	{
-		auto compareHouse = [&](House* house) -> bool { return house->Center == e.Center; };
+		TRACE_ZONE("BehaviorTree::Update");
+		m_pBehaviourTree->Update(dt);
+	}
+
+	return CalculateSteering(dt);
+}
 
-		if (std::find_if(m_pHouses.begin(), m_pHouses.end(), compareHouse) == m_pHouses.end()) 
+//Fills the field of view buffers and sorts the entities per type
+void Plugin::UpdateFov()
+{
+	TRACE_ZONE("Plugin::UpdateFov");
+
+	GetHousesInFOV(m_Fov.Houses); //uses m_pInterface->Fov_GetHouseByIndex(...)
+	GetEntitiesInFOV(m_Fov.Entities); //uses m_pInterface->Fov_GetEntityByIndex(...)
+
+	m_Fov.Enemies.Clear();
+	m_Fov.Items.Clear();
+	m_Fov.PurgeZones.Clear();
+
+	for (const EntityInfo& e : m_Fov.Entities)
+	{
+		if (e.Type == eEntityType::PURGEZONE)
 		{
-			shouldRecalculateInfluence = true;
+			PurgeZoneInfo purgeZoneInfo{};
+			if (m_pInterface->PurgeZone_GetInfo(e, purgeZoneInfo))
+			{
+				m_Fov.PurgeZones.Add(purgeZoneInfo);
+			}
+		}
+		else if (e.Type == eEntityType::ITEM)
+		{
+			ItemInfo itemInfo{};
+			if (m_pInterface->Item_GetInfo(e, itemInfo))
+			{
+				m_Fov.Items.Add(e, itemInfo);
+			}
+		}
+		else if (e.Type == eEntityType::ENEMY)
+		{
+			EnemyInfo enemyInfo{};
+			if (m_pInterface->Enemy_GetInfo(e, enemyInfo))
+			{
+				m_Fov.Enemies.Add(enemyInfo);
+			}
+		}
+	}
+}
+
+//Adds the houses that are seen for the first time, their influence is added in UpdateInfluence
+void Plugin::UpdateHouses()
+{
+	TRACE_ZONE("Plugin::UpdateHouses");
 
+	for (size_t idx{}; idx < m_Fov.Houses.size(); ++idx)
+	{
+		const HouseInfo e{ m_Fov.Houses.Get(idx) };
+		if (m_Houses.Find(GetRegistryKey(e)) == nullptr)
+		{
 			std::cout << "New house\n";
 			House* pHouse{ new House };
 			pHouse->Center = e.Center;
@@ -357,166 +425,182 @@ SteeringPlugin_Output Plugin::UpdateSteering(float dt)
 				}
 			}
 
-			m_pHouses.push_back(pHouse);
+			m_Houses.Add(pHouse);
+			m_pNewHouses.push_back(pHouse);
 		}
 	}
+}
 
-	m_Enemies.clear();
+//Registers the purge zones and items that are seen for the first time, enemies are only kept for this tick
+void Plugin::UpdateEntities()
+{
+	TRACE_ZONE("Plugin::UpdateEntities");
 
-	for (auto& e : vEntitiesInFOV)
+	const PurgeZoneFovBuffer& purgeZones{ m_Fov.PurgeZones };
+	for (size_t idx{}; idx < purgeZones.size(); ++idx)
 	{
-		if (e.Type == eEntityType::PURGEZONE)
-		{
-			PurgeZoneInfo purgeZoneInfo;
-			m_pInterface->PurgeZone_GetInfo(e, purgeZoneInfo);
+		const PurgeZoneInfo purgeZoneInfo{ purgeZones.Get(idx) };
 
-			auto comparePurgeZone = [&](PurgeZone* pPurgeZoneInVec) -> bool { return pPurgeZoneInVec->Center == purgeZoneInfo.Center; };
+		if (m_PurgeZones.Find(GetRegistryKey(purgeZoneInfo)) == nullptr)
+		{
+			std::cout << "New Purge Zone\n";
 
-			if (std::find_if(m_pPurgeZones.begin(), m_pPurgeZones.end(), comparePurgeZone) == m_pPurgeZones.end())
-			{
-				std::cout << "New Purge Zone\n";
+			PurgeZone* pPurgeZone{ new PurgeZone };
+			pPurgeZone->Center = purgeZoneInfo.Center;
+			pPurgeZone->Radius = purgeZoneInfo.Radius + 10.f;
+			pPurgeZone->ZoneHash = purgeZoneInfo.ZoneHash;
 
-				PurgeZone* pPurgeZone{ new PurgeZone };
-				pPurgeZone->Center = purgeZoneInfo.Center;
-				pPurgeZone->Radius = purgeZoneInfo.Radius + 10.f;
-				pPurgeZone->ZoneHash = purgeZoneInfo.ZoneHash;
-				pPurgeZone->EstimatedLifeTime = 4.5f;
+			m_PurgeZones.Add(pPurgeZone);
 
-				m_pPurgeZones.push_back(pPurgeZone);
-			}
+			//Forgotten once it is expected to be gone
+			m_Timers.Schedule(PurgeZone::EstimatedLifeTime, [this, pPurgeZone]()
+			{
+				m_PurgeZones.Remove(pPurgeZone);
+				delete pPurgeZone;
+			});
 		}
-		else if (e.Type == eEntityType::ITEM)
-		{
-			ItemInfo itemInfo;
-			m_pInterface->Item_GetInfo(e, itemInfo);
+	}
 
-			auto compareItem = [&](Item* pItemInVec) -> bool { return pItemInVec->entityInfo.Location == e.Location; };
+	const ItemFovBuffer& items{ m_Fov.Items };
+	for (size_t idx{}; idx < items.size(); ++idx)
+	{
+		const EntityInfo e{ items.GetEntity(idx) };
+		const ItemInfo itemInfo{ items.GetItem(idx) };
 
-			auto iterator = std::find_if(m_pItems.begin(), m_pItems.end(), compareItem);
+		Item* pKnownItem{ m_Items.Find(GetRegistryKey(e)) };
 
-			if (iterator == m_pItems.end())
-			{
-				std::cout << "New item\n";
+		if (pKnownItem == nullptr)
+		{
+			std::cout << "New item\n";
 
-				Item* pItem{ new Item };
-				pItem->entityInfo = e;
-				pItem->itemInfo = itemInfo;
+			Item* pItem{ new Item };
+			pItem->entityInfo = e;
+			pItem->itemInfo = itemInfo;
 
-				Elite::Vector2 distance{};
-				for (House* pHouse : m_pHouses)
+			Elite::Vector2 distance{};
+			for (House* pHouse : m_Houses)
+			{
+				distance = pHouse->Center - e.Location;
+				if (abs(distance.x) < pHouse->Size.x / 2.f && abs(distance.y) < pHouse->Size.y / 2.f)
 				{
-					distance = pHouse->Center - e.Location;
-					if (abs(distance.x) < pHouse->Size.x / 2.f && abs(distance.y) < pHouse->Size.y / 2.f)
-					{
-						pItem->IsVisited = pHouse->IsVisited;
-						pItem->pHouse = pHouse;
-						break;
-					}
+					pItem->IsVisited = pHouse->IsVisited;
+					pItem->pHouse = pHouse;
+					pHouse->pItems.push_back(pItem);
+					break;
 				}
-
-				m_pItems.push_back(pItem);
-			}
-			else
-			{
-				(*iterator)->entityInfo = e;
-				(*iterator)->itemInfo = itemInfo;
 			}
+
+			m_Items.Add(pItem);
 		}
-		else if (e.Type == eEntityType::ENEMY)
+		else
 		{
-			EnemyInfo enemyInfo;
-			m_pInterface->Enemy_GetInfo(e, enemyInfo);
-
-			m_Enemies.push_back(enemyInfo);
+			pKnownItem->entityInfo = e;
+			pKnownItem->itemInfo = itemInfo;
 		}
 	}
+}
+
+void Plugin::UpdateCurrentGridElement()
+{
+	TRACE_ZONE("Plugin::UpdateCurrentGridElement");
 
-	//Revisit houses after some time
-	for (auto* pHouse : m_pHouses)
+	if (m_IsViewConeExplorationEnabled)
 	{
-		if (!pHouse->IsVisited) continue;
-	
-		pHouse->TimeSinceVisit += dt;
+		m_pGrid->StampViewCone(m_AgentInfo.Position, m_AgentInfo.Orientation, m_AgentInfo.FOV_Angle, m_AgentInfo.FOV_Range);
+	}
 
-		if (pHouse->TimeSinceVisit > 350.f)
-		{
-			pHouse->IsVisited = false;
+	//Update grid pos, outside the grid the last cell is kept
+	const int cellIndex{ m_pGrid->GetCellIndex(m_AgentInfo.Position) };
+	if (cellIndex < 0) return;
 
-			for (auto* pItem : m_pItems)
-			{
-				if (pItem->pHouse == pHouse)
-				{
-					pItem->IsVisited = false;
-				}
-			}
+	m_CurrentCellIndex = cellIndex;
 
-			for (auto* pSearchPoint : pHouse->pSearchPoints)
-			{
-				pSearchPoint->IsVisited = false;
-			}
+	const Elite::Vector2 cellPosition{ m_pGrid->GetPosition(cellIndex) };
+	const float checkDistance{ m_CellSize / 6.f };
+	const float distanceX{ std::abs(m_AgentInfo.Position.x - cellPosition.x) };
+	const float distanceY{ std::abs(m_AgentInfo.Position.y - cellPosition.y) };
 
-			pHouse->TimeSinceVisit = 0.f;
-		}
+	if (distanceX <= checkDistance && distanceY <= checkDistance)
+	{
+		m_pGrid->SetVisited(cellIndex, true);
 	}
+}
+
+//Recalculates the influence of every known house from scratch
+void Plugin::CalculateInfluence()
+{
+	TRACE_ZONE("Plugin::CalculateInfluence");
 
-	//Update purge zone time
-	for (auto* pPurgeZone : m_pPurgeZones)
+	m_pGrid->ClearInfluence();
+
+	for (House* pHouse : m_Houses)
 	{
-		pPurgeZone->EstimatedLifeTime -= dt;
+		m_pGrid->AddInfluence(pHouse->Center, 1.f);
 	}
-	
-	auto purgeZoneRemover = [&](PurgeZone* pPurgeZone)->bool {return pPurgeZone->EstimatedLifeTime <= 0.f; };
-	auto iterator = std::remove_if(m_pPurgeZones.begin(), m_pPurgeZones.end(), purgeZoneRemover);
 
-	if (iterator != m_pPurgeZones.end())
+	m_pNewHouses.clear();
+	m_pGrid->UpdateScore();
+}
+
+//Adds the influence of the houses discovered this tick, in discovery order
+//Houses are only ever added, so the grid ends up with the same sums as a full recalculation
+//The other layers are only kept up to date while they have a weight
+void Plugin::UpdateInfluence()
+{
+	TRACE_ZONE("Plugin::UpdateInfluence");
+
+	for (House* pHouse : m_pNewHouses)
 	{
-		m_pPurgeZones.erase(iterator);
+		m_pGrid->AddInfluence(pHouse->Center, 1.f);
 	}
 
-	//Update grid pos
-	const float halfSide{ m_CellSize / 2.f };
-	const float checkDistance{ m_CellSize / 6.f };
+	m_pNewHouses.clear();
 
-	for (GridElement* pGridElement : m_pGrid)
+	//Every tick an enemy is seen adds to the threat around it, the threat fades in steps on the timer wheel
+	//Only the cells under a disc, or holding threat when it fades, are re-scored and moved in the grid heaps
+	if (m_pGrid->GetLayerWeight(eInfluenceLayer::Threat) != 0.f)
 	{
-		const float distanceX{ std::abs(m_AgentInfo.Position.x - pGridElement->Position.x) };
-		const float distanceY{ std::abs(m_AgentInfo.Position.y - pGridElement->Position.y) };
-
-		if (distanceX <= halfSide && distanceY <= halfSide)
+		for (const Elite::Vector2& enemyLocation : m_Fov.Enemies.Locations)
 		{
-			m_pCurrentGridElement = pGridElement;
-			
-			if (distanceX <= checkDistance && distanceY <= checkDistance)
-			{
-				pGridElement->IsVisited = true;
-			}
-
-			break;
+			m_pGrid->AddDisc(eInfluenceLayer::Threat, enemyLocation, 2.f * m_CellSize, m_DeltaTime);
 		}
 	}
 
-	if (shouldRecalculateInfluence)
+	m_pGrid->UpdateScore();
+}
+
+void Plugin::ScheduleThreatDecay()
+{
+	m_Timers.Schedule(m_ThreatDecayInterval, [this]()
 	{
-		//Recalculate influence
-		for (GridElement* pGridElement : m_pGrid)
-		{
-			pGridElement->Influence = 0.f;
+		m_pGrid->ScaleLayer(eInfluenceLayer::Threat, std::pow(0.5f, m_ThreatDecayInterval / m_ThreatHalfLife));
+		ScheduleThreatDecay();
+	});
+}
 
-			for (House* pHouse : m_pHouses)
-			{
-				const float nrCellsAway{ (pGridElement->Position.Distance(pHouse->Center)) / m_CellSize };
-				pGridElement->Influence += 1.f / (nrCellsAway * nrCellsAway * nrCellsAway);
-			}
+//Purge zones are rebuilt from the known ones, they come and go too rarely to track each change
+void Plugin::SchedulePurgeDangerRebuild()
+{
+	m_Timers.Schedule(m_PurgeDangerInterval, [this]()
+	{
+		m_pGrid->ClearLayer(eInfluenceLayer::PurgeDanger);
+		for (PurgeZone* pPurgeZone : m_PurgeZones)
+		{
+			m_pGrid->AddDisc(eInfluenceLayer::PurgeDanger, pPurgeZone->Center, pPurgeZone->Radius, 1.f);
 		}
-	}
-	
-	//Behaviours
-	m_pBehaviourTree->Update(dt);
+
+		SchedulePurgeDangerRebuild();
+	});
+}
+
+SteeringPlugin_Output Plugin::CalculateSteering(float dt)
+{
+	TRACE_ZONE("Plugin::CalculateSteering");
 
 	//Calculate steering
 	SteeringPlugin_Output steering{};
 	ISteeringBehavior* pCurrentSteering{};
-	if (m_pBlackboard->GetData("CurrentSteering", pCurrentSteering) && pCurrentSteering)
+	if (m_pBlackboard->GetData(BB::CurrentSteering, pCurrentSteering) && pCurrentSteering)
 	{
 		steering = pCurrentSteering->CalculateSteering(dt, m_AgentInfo);
 		m_pInterface->Draw_Direction(m_AgentInfo.Position, steering.LinearVelocity, 10.f, Elite::Vector3{ 1.f,1.f,1.f });
@@ -531,7 +615,7 @@ SteeringPlugin_Output Plugin::UpdateSteering(float dt)
 void Plugin::Render(float dt) const
 {
 	//This Render function should only contain calls to Interface->Draw_... functions
-	for (House* pHouse : m_pHouses)
+	for (House* pHouse : m_Houses)
 	{
 		for (SearchPoint* pSearchPoint : pHouse->pSearchPoints)
 		{
@@ -551,55 +635,56 @@ void Plugin::Render(float dt) const
 	const float halfCell{ m_CellSize / 2.f };
 	Elite::Vector3 color{};
 
-	for (GridElement* pGridElement : m_pGrid)
+	for (int cellIndex{}; cellIndex < m_pGrid->GetNrCells(); ++cellIndex)
 	{
-		if (pGridElement->IsVisited) continue;
+		if (m_pGrid->IsVisited(cellIndex)) continue;
 
-		color.x = pGridElement->Influence;
+		color.x = m_pGrid->GetScore(cellIndex);
 
-		m_pInterface->Draw_Segment(pGridElement->Position + Elite::Vector2{ -halfCell, -halfCell }, pGridElement->Position + Elite::Vector2{ -halfCell,halfCell }, color);
-		m_pInterface->Draw_Segment(pGridElement->Position + Elite::Vector2{ -halfCell, halfCell }, pGridElement->Position + Elite::Vector2{ halfCell,halfCell }, color);
-		m_pInterface->Draw_Segment(pGridElement->Position + Elite::Vector2{ halfCell, halfCell }, pGridElement->Position + Elite::Vector2{ halfCell,-halfCell }, color);
-		m_pInterface->Draw_Segment(pGridElement->Position + Elite::Vector2{ -halfCell, -halfCell }, pGridElement->Position + Elite::Vector2{ halfCell,-halfCell }, color);
+		const Elite::Vector2 position{ m_pGrid->GetPosition(cellIndex) };
+		m_pInterface->Draw_Segment(position + Elite::Vector2{ -halfCell, -halfCell }, position + Elite::Vector2{ -halfCell,halfCell }, color);
+		m_pInterface->Draw_Segment(position + Elite::Vector2{ -halfCell, halfCell }, position + Elite::Vector2{ halfCell,halfCell }, color);
+		m_pInterface->Draw_Segment(position + Elite::Vector2{ halfCell, halfCell }, position + Elite::Vector2{ halfCell,-halfCell }, color);
+		m_pInterface->Draw_Segment(position + Elite::Vector2{ -halfCell, -halfCell }, position + Elite::Vector2{ halfCell,-halfCell }, color);
 	}
 }
 
-vector<HouseInfo> Plugin::GetHousesInFOV() const
+void Plugin::GetHousesInFOV(HouseFovBuffer& houses) const
 {
-	vector<HouseInfo> vHousesInFOV = {};
+	TRACE_ZONE("Plugin::GetHousesInFOV");
+
+	houses.Clear();
 
 	HouseInfo hi = {};
 	for (int i = 0;; ++i)
 	{
 		if (m_pInterface->Fov_GetHouseByIndex(i, hi))
 		{
-			vHousesInFOV.push_back(hi);
+			houses.Add(hi);
 			continue;
 		}
 
 		break;
 	}
-
-	return vHousesInFOV;
 }
 
-vector<EntityInfo> Plugin::GetEntitiesInFOV() const
+void Plugin::GetEntitiesInFOV(std::vector<EntityInfo>& entities) const
 {
-	vector<EntityInfo> vEntitiesInFOV = {};
+	TRACE_ZONE("Plugin::GetEntitiesInFOV");
+
+	entities.clear();
 
 	EntityInfo ei = {};
 	for (int i = 0;; ++i)
 	{
 		if (m_pInterface->Fov_GetEntityByIndex(i, ei))
 		{
-			vEntitiesInFOV.push_back(ei);
+			entities.push_back(ei);
 			continue;
 		}
 
 		break;
 	}
-
-	return vEntitiesInFOV;
 }
 
 //////////////////////////////////////
@@ -608,53 +693,55 @@ vector<EntityInfo> Plugin::GetEntitiesInFOV() const
 Elite::Blackboard* Plugin::CreateBlackboard()
 {
 	Elite::Blackboard* pBlackboard = new Elite::Blackboard();
-	pBlackboard->AddData("Interface", m_pInterface);
+	pBlackboard->AddData(BB::Interface, m_pInterface);
 
 	//Vectors
-	pBlackboard->AddData("PurgeVector", &m_pPurgeZones);
-	pBlackboard->AddData("ItemVector", &m_pItems);
-	pBlackboard->AddData("EnemyVector", &m_Enemies);
-	pBlackboard->AddData("HouseVector", &m_pHouses);
-	pBlackboard->AddData("GridVector", &m_pGrid);
-	pBlackboard->AddData("Inventory", &m_Inventory);
+	pBlackboard->AddData(BB::PurgeVector, &m_PurgeZones);
+	pBlackboard->AddData(BB::ItemVector, &m_Items);
+	pBlackboard->AddData(BB::EnemyFov, &m_Fov.Enemies);
+	pBlackboard->AddData(BB::HouseVector, &m_Houses);
+	pBlackboard->AddData(BB::Grid, m_pGrid);
+	pBlackboard->AddData(BB::Inventory, &m_Inventory);
 
 	//Steerings
-	pBlackboard->AddData("CurrentSteering", static_cast<ISteeringBehavior*>(nullptr));
-	pBlackboard->AddData("Wander", m_pWanderBehaviour);
-	pBlackboard->AddData("RotateClockWise", m_pRotateClockWiseBehaviour);
-	pBlackboard->AddData("Seek", m_pSeekBehaviour);
-	pBlackboard->AddData("Face", m_pFaceBehaviour);
-	pBlackboard->AddData("Flee", m_pFleeBehaviour);
-	pBlackboard->AddData("Arrive", m_pArriveBehaviour);
-	pBlackboard->AddData("SeekAndFace", m_pSeekAndFaceBehaviour);
-	pBlackboard->AddData("WanderAndSeek", m_pWanderAndSeekBehaviour);
-	pBlackboard->AddData("FaceAndSeek", m_pFaceAndSeekBehaviour);
-	pBlackboard->AddData("FleeAndFace", m_pFleeAndFaceBehaviour);
+	pBlackboard->AddData(BB::CurrentSteering, static_cast<ISteeringBehavior*>(nullptr));
+	pBlackboard->AddData(BB::Wander, m_pWanderBehaviour);
+	pBlackboard->AddData(BB::RotateClockWise, m_pRotateClockWiseBehaviour);
+	pBlackboard->AddData(BB::Seek, m_pSeekBehaviour);
+	pBlackboard->AddData(BB::Face, m_pFaceBehaviour);
+	pBlackboard->AddData(BB::Flee, m_pFleeBehaviour);
+	pBlackboard->AddData(BB::Arrive, m_pArriveBehaviour);
+	pBlackboard->AddData(BB::SeekAndFace, m_pSeekAndFaceBehaviour);
+	pBlackboard->AddData(BB::WanderAndSeek, m_pWanderAndSeekBehaviour);
+	pBlackboard->AddData(BB::FaceAndSeek, m_pFaceAndSeekBehaviour);
+	pBlackboard->AddData(BB::FleeAndFace, m_pFleeAndFaceBehaviour);
 
 	//Agent
-	pBlackboard->AddData("AgentInfo", &m_AgentInfo);
-	pBlackboard->AddData("StartOrientation", &m_StartOrientation);
+	pBlackboard->AddData(BB::AgentInfo, &m_AgentInfo);
+	pBlackboard->AddData(BB::StartOrientation, &m_StartOrientation);
 
 	//Booleans
-	pBlackboard->AddData("ShouldRun", &m_ShouldRun);
-	pBlackboard->AddData("IsRotating", &m_IsRotating);
-	pBlackboard->AddData("IsRotationCompleted", &m_IsRotationCompleted);
+	pBlackboard->AddData(BB::ShouldRun, &m_ShouldRun);
+	pBlackboard->AddData(BB::IsRotating, &m_IsRotating);
+	pBlackboard->AddData(BB::IsRotationCompleted, &m_IsRotationCompleted);
 
 	//Cells
-	pBlackboard->AddData("CurrentCell", &m_pCurrentGridElement);
-	pBlackboard->AddData("CellSize", m_CellSize);
+	pBlackboard->AddData(BB::CurrentCell, &m_CurrentCellIndex);
+	pBlackboard->AddData(BB::CellSize, m_CellSize);
 
 	//Targets
 	Elite::Vector2 target{};
-	pBlackboard->AddData("Target", target);
-	pBlackboard->AddData("TargetItem", static_cast<Item*>(nullptr));
-	pBlackboard->AddData("TargetHouse", static_cast<House*>(nullptr));
+	pBlackboard->AddData(BB::Target, target);
+	pBlackboard->AddData(BB::TargetItem, static_cast<Item*>(nullptr));
+	pBlackboard->AddData(BB::TargetHouse, static_cast<House*>(nullptr));
 
 	//Timers
-	pBlackboard->AddData("DeltaTime", &m_DeltaTime);
-	pBlackboard->AddData("WalkingTime", &m_WalkingTime);
-	pBlackboard->AddData("AlertedTime", &m_AlertedTime);
+	pBlackboard->AddData(BB::Timers, &m_Timers);
+	pBlackboard->AddData(BB::WalkingTimer, &m_WalkingTimer);
+	pBlackboard->AddData(BB::AlertedTimer, &m_AlertedTimer);
 
+	//All fields are known, move them into one arena so ticks never allocate
+	pBlackboard->Freeze();
 
 	return pBlackboard;
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 #include "IExamPlugin.h"
 #include "Extensions.h"
 #include "EliteAI/EliteDecisionMaking/EDecisionMaking.h"
+#include "EntityRegistry.h"
+#include "FovBuffers.h"
+#include "ExplorationGrid.h"
 
 class IBaseInterface;
 class IExamInterface;
@@ -34,17 +37,34 @@ public:
 
 	
 private:
+	//Times the UpdateSteering stages in isolation
+	friend class PluginBenchmark;
+
 	//Interface, used to request data from/perform actions with the AI Framework
 	IExamInterface* m_pInterface = nullptr;
-	std::vector<HouseInfo> GetHousesInFOV() const;
-	std::vector<EntityInfo> GetEntitiesInFOV() const;
+	void GetHousesInFOV(HouseFovBuffer& houses) const;
+	void GetEntitiesInFOV(std::vector<EntityInfo>& entities) const;
 
 	//Added private functions
 	Elite::Blackboard* CreateBlackboard();
 
+	//UpdateSteering stages
+	void UpdateFov();
+	void UpdateHouses();
+	void UpdateEntities();
+	void UpdateCurrentGridElement();
+	void CalculateInfluence();
+	void UpdateInfluence();
+	SteeringPlugin_Output CalculateSteering(float dt);
+
+	//Influence layers refreshed on the timer wheel, each callback schedules the next one
+	void ScheduleThreatDecay();
+	void SchedulePurgeDangerRebuild();
+
 	//Added variables
 	Elite::BehaviorTree* m_pBehaviourTree{};
 	Elite::Blackboard* m_pBlackboard{};
+	std::string m_BehaviorTreeProfileFile{};
 
 	Arrive* m_pArriveBehaviour{};
 	Seek* m_pSeekBehaviour{};
@@ -61,12 +81,16 @@ private:
 	AgentInfo m_AgentInfo{};
 	bool m_ShouldRun{ false };
 
+	//Registries, keyed by EntityHash, ZoneHash and quantized house center
+	EntityRegistry<Item> m_Items{};
+	EntityRegistry<PurgeZone> m_PurgeZones{};
+	EntityRegistry<House> m_Houses{};
+	std::vector<House*> m_pNewHouses{}; //Discovered this tick, their influence is not on the grid yet
+
+	//Field of view of the current tick
+	FovBuffers m_Fov{};
+
 	//Vectors
-	std::vector <Item*> m_pItems{};
-	std::vector <PurgeZone*> m_pPurgeZones{};
-	std::vector<House*> m_pHouses{};
-	std::vector<GridElement*> m_pGrid{};
-	std::vector<EnemyInfo> m_Enemies{};
 	std::vector<std::pair<int, InventoryItemType>> m_Inventory{};
 
 	//Rotation
@@ -75,22 +99,34 @@ private:
 	float m_StartOrientation{};
 
 	//Grid
-	GridElement* m_pCurrentGridElement{};
+	ExplorationGrid* m_pGrid{};
+	int m_NrGridColumns{ 15 };
+	bool m_IsViewConeExplorationEnabled{ true }; //Cells count as visited once they were in the field of view
+	int m_CurrentCellIndex{};
 	float m_CellSize{};
 
-	//Timers
+	//Influence layers, each one refreshed at its own rate
+	float m_ThreatHalfLife{ 10.f };
+	float m_ThreatDecayInterval{ 0.25f };
+	float m_PurgeDangerInterval{ 0.5f };
+
+	//Timers, every expiry of the plugin and its behaviors is scheduled on the wheel
 	float m_DeltaTime{};
-	float m_WalkingTime{};
-	float m_AlertedTime{};
+	TimerWheel m_Timers{};
+	TimerWheel::Handle m_WalkingTimer{};
+	TimerWheel::Handle m_AlertedTimer{};
 };
 
 //ENTRY
 //This is the first function that is called by the host program
 //The plugin returned by this function is also the plugin used by the host program
+#ifdef _WIN32
+#define PLUGIN_EXPORT __declspec (dllexport)
+#else
+#define PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
 extern "C"
 {
-	__declspec (dllexport) IPluginBase* Register()
-	{
-		return new Plugin();
-	}
+	PLUGIN_EXPORT IPluginBase* Register();
 }
\ No newline at end of file
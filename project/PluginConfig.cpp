@@ -0,0 +1,44 @@
+#include "stdafx.h"
+#include "PluginConfig.h"
+
+std::string PluginConfig::ReadString(const char* pName)
+{
+#ifdef _WIN32
+	char* pValue{};
+	size_t length{};
+	if (_dupenv_s(&pValue, &length, pName) != 0 || !pValue) return {};
+
+	const std::string value{ pValue };
+	free(pValue);
+	return value;
+#else
+	const char* pValue{ getenv(pName) };
+	return pValue ? std::string{ pValue } : std::string{};
+#endif
+}
+
+int PluginConfig::ReadInt(const char* pName, int fallback)
+{
+	const std::string value{ ReadString(pName) };
+	return value.empty() ? fallback : atoi(value.c_str());
+}
+
+float PluginConfig::ReadFloat(const char* pName, float fallback)
+{
+	const std::string value{ ReadString(pName) };
+	return value.empty() ? fallback : static_cast<float>(atof(value.c_str()));
+}
+
+std::vector<float> PluginConfig::ReadFloatList(const char* pName)
+{
+	std::vector<float> values{};
+
+	std::stringstream stream{ ReadString(pName) };
+	std::string value{};
+	while (std::getline(stream, value, ','))
+	{
+		values.push_back(static_cast<float>(atof(value.c_str())));
+	}
+
+	return values;
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <string>
+#include <vector>
+
+//Plugin settings read from environment variables, so a run can be tuned without rebuilding the dll
+//A variable that is not set or empty leaves the fallback
+namespace PluginConfig
+{
+	//Empty when the variable is not set
+	std::string ReadString(const char* pName);
+	int ReadInt(const char* pName, int fallback);
+	float ReadFloat(const char* pName, float fallback);
+	//Comma separated values, empty when the variable is not set
+	std::vector<float> ReadFloatList(const char* pName);
+}
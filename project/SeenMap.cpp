@@ -0,0 +1,199 @@
+#include "stdafx.h"
+#include "SeenMap.h"
+
+#include <limits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+	int CountBits(uint64_t word)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		return static_cast<int>(__popcnt64(word));
+#elif defined(_MSC_VER)
+		return static_cast<int>(__popcnt(static_cast<uint32_t>(word)) + __popcnt(static_cast<uint32_t>(word >> 32)));
+#else
+		return __builtin_popcountll(word);
+#endif
+	}
+
+	//The word must not be 0
+	int FindFirstBit(uint64_t word)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index{};
+		_BitScanForward64(&index, word);
+		return static_cast<int>(index);
+#elif defined(_MSC_VER)
+		unsigned long index{};
+		if (_BitScanForward(&index, static_cast<uint32_t>(word))) return static_cast<int>(index);
+		_BitScanForward(&index, static_cast<uint32_t>(word >> 32));
+		return static_cast<int>(index) + 32;
+#else
+		return __builtin_ctzll(word);
+#endif
+	}
+
+	uint64_t GetWordMask(int word, int first, int last)
+	{
+		uint64_t mask{ ~uint64_t{} };
+		if (word == first >> 6) mask &= ~uint64_t{} << (first & 63);
+		if (word == last >> 6) mask &= ~uint64_t{} >> (63 - (last & 63));
+		return mask;
+	}
+
+	//Narrows [minY, maxY] to the y offsets of the points (dx, y) where direction * y >= offset holds
+	void ClipToHalfPlane(float direction, float offset, float& minY, float& maxY)
+	{
+		if (direction > 0.f) minY = (std::max)(minY, offset / direction);
+		else if (direction < 0.f) maxY = (std::min)(maxY, offset / direction);
+		else if (offset > 0.f)
+		{
+			minY = std::numeric_limits<float>::infinity();
+			maxY = -minY;
+		}
+	}
+}
+
+void SeenMap::Initialize(const Elite::Vector2& origin, float cellSize, int nrColumns, int nrRows)
+{
+	m_Origin = origin;
+	m_CellSize = cellSize;
+	m_NrColumns = nrColumns;
+	m_NrRows = nrRows;
+	m_NrSeen = 0;
+
+	m_Words.assign((static_cast<size_t>(nrColumns) * nrRows + 63) / 64, 0);
+}
+
+void SeenMap::SetSeen(int index, bool isSeen)
+{
+	if (IsSeen(index) == isSeen) return;
+
+	m_Words[index >> 6] ^= uint64_t{ 1 } << (index & 63);
+	m_NrSeen += isSeen ? 1 : -1;
+}
+
+void SeenMap::StampViewCone(const Elite::Vector2& apex, float orientation, float fovAngle, float range, std::vector<int>& newlySeen)
+{
+	if (range <= 0.f || fovAngle <= 0.f || m_Words.empty()) return;
+
+	//A cone wider than half a circle is the disc without the convex wedge that points the other way
+	const float pi{ static_cast<float>(E_PI) };
+	const float halfAngle{ (std::min)(fovAngle, 2.f * pi) / 2.f };
+	const bool isReflex{ halfAngle > pi / 2.f };
+	const float wedgeOrientation{ isReflex ? orientation + pi : orientation };
+	const float wedgeHalfAngle{ isReflex ? pi - halfAngle : halfAngle };
+
+	const Elite::Vector2 rightEdge{ Elite::OrientationToVector(wedgeOrientation - wedgeHalfAngle) };
+	const Elite::Vector2 leftEdge{ Elite::OrientationToVector(wedgeOrientation + wedgeHalfAngle) };
+
+	const int firstColumn{ (std::max)(0, static_cast<int>(std::ceil((apex.x - range - m_Origin.x) / m_CellSize))) };
+	const int lastColumn{ (std::min)(m_NrColumns - 1, static_cast<int>(std::floor((apex.x + range - m_Origin.x) / m_CellSize))) };
+
+	for (int column{ firstColumn }; column <= lastColumn; ++column)
+	{
+		const float dx{ m_Origin.x + column * m_CellSize - apex.x };
+		const float halfChordSquared{ range * range - dx * dx };
+		if (halfChordSquared < 0.f) continue;
+
+		//Part of the column inside the disc, relative to the apex
+		const float halfChord{ sqrtf(halfChordSquared) };
+		const float discMinY{ -halfChord };
+		const float discMaxY{ halfChord };
+
+		//Part inside the wedge: cross(rightEdge, d) >= 0 and cross(d, leftEdge) >= 0
+		float wedgeMinY{ -std::numeric_limits<float>::infinity() };
+		float wedgeMaxY{ std::numeric_limits<float>::infinity() };
+		ClipToHalfPlane(rightEdge.x, rightEdge.y * dx, wedgeMinY, wedgeMaxY);
+		ClipToHalfPlane(-leftEdge.x, -leftEdge.y * dx, wedgeMinY, wedgeMaxY);
+
+		int firstRow{};
+		int lastRow{};
+		const int firstIndex{ column * m_NrRows };
+
+		if (!isReflex)
+		{
+			if (GetRowSpan(apex.y + (std::max)(discMinY, wedgeMinY), apex.y + (std::min)(discMaxY, wedgeMaxY), firstRow, lastRow))
+			{
+				SetRange(firstIndex + firstRow, firstIndex + lastRow, newlySeen);
+			}
+			continue;
+		}
+
+		if (wedgeMinY > wedgeMaxY)
+		{
+			if (GetRowSpan(apex.y + discMinY, apex.y + discMaxY, firstRow, lastRow))
+			{
+				SetRange(firstIndex + firstRow, firstIndex + lastRow, newlySeen);
+			}
+			continue;
+		}
+
+		if (GetRowSpan(apex.y + discMinY, apex.y + (std::min)(discMaxY, wedgeMinY), firstRow, lastRow))
+		{
+			SetRange(firstIndex + firstRow, firstIndex + lastRow, newlySeen);
+		}
+		if (GetRowSpan(apex.y + (std::max)(discMinY, wedgeMaxY), apex.y + discMaxY, firstRow, lastRow))
+		{
+			SetRange(firstIndex + firstRow, firstIndex + lastRow, newlySeen);
+		}
+	}
+}
+
+int SeenMap::CountSeen(int firstColumn, int lastColumn, int firstRow, int lastRow) const
+{
+	firstColumn = (std::max)(firstColumn, 0);
+	lastColumn = (std::min)(lastColumn, m_NrColumns - 1);
+	firstRow = (std::max)(firstRow, 0);
+	lastRow = (std::min)(lastRow, m_NrRows - 1);
+	if (firstRow > lastRow) return 0;
+
+	int nrSeen{};
+	for (int column{ firstColumn }; column <= lastColumn; ++column)
+	{
+		nrSeen += CountRange(column * m_NrRows + firstRow, column * m_NrRows + lastRow);
+	}
+
+	return nrSeen;
+}
+
+void SeenMap::SetRange(int first, int last, std::vector<int>& newlySeen)
+{
+	for (int word{ first >> 6 }; word <= last >> 6; ++word)
+	{
+		uint64_t newBits{ GetWordMask(word, first, last) & ~m_Words[word] };
+		if (newBits == 0) continue;
+
+		m_Words[word] |= newBits;
+		m_NrSeen += CountBits(newBits);
+
+		for (; newBits != 0; newBits &= newBits - 1)
+		{
+			newlySeen.push_back(word * 64 + FindFirstBit(newBits));
+		}
+	}
+}
+
+int SeenMap::CountRange(int first, int last) const
+{
+	int nrSeen{};
+	for (int word{ first >> 6 }; word <= last >> 6; ++word)
+	{
+		nrSeen += CountBits(GetWordMask(word, first, last) & m_Words[word]);
+	}
+
+	return nrSeen;
+}
+
+bool SeenMap::GetRowSpan(float minY, float maxY, int& firstRow, int& lastRow) const
+{
+	if (minY > maxY) return false;
+
+	firstRow = (std::max)(0, static_cast<int>(std::ceil((minY - m_Origin.y) / m_CellSize)));
+	lastRow = (std::min)(m_NrRows - 1, static_cast<int>(std::floor((maxY - m_Origin.y) / m_CellSize)));
+	return firstRow <= lastRow;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+//One bit per exploration cell, set once the cell center has been inside the field of view
+//Bits follow the cell index of the grid (index = column * nrRows + row), so the rows of a column are one contiguous run of bits
+class SeenMap final
+{
+public:
+	SeenMap() = default;
+	~SeenMap() = default;
+
+	SeenMap(const SeenMap& other) = delete;
+	SeenMap& operator=(const SeenMap& other) = delete;
+	SeenMap(SeenMap&& other) = delete;
+	SeenMap& operator=(SeenMap&& other) = delete;
+
+	//Cell centers are origin + (column, row) * cellSize
+	void Initialize(const Elite::Vector2& origin, float cellSize, int nrColumns, int nrRows);
+
+	bool IsSeen(int index) const { return (m_Words[index >> 6] >> (index & 63) & 1) != 0; }
+	void SetSeen(int index, bool isSeen);
+
+	//Sets the bits of every cell whose center lies inside the view cone, one column at a time
+	//fovAngle is the full opening angle around orientation, the indices of the cells that were not seen before are appended to newlySeen
+	void StampViewCone(const Elite::Vector2& apex, float orientation, float fovAngle, float range, std::vector<int>& newlySeen);
+
+	//Popcount based coverage
+	int GetNrSeen() const { return m_NrSeen; }
+	int CountSeen(int firstColumn, int lastColumn, int firstRow, int lastRow) const;
+
+private:
+	Elite::Vector2 m_Origin{};
+	float m_CellSize{};
+	int m_NrColumns{};
+	int m_NrRows{};
+	int m_NrSeen{};
+
+	std::vector<uint64_t> m_Words{};
+
+	//Inclusive bit range, only the bits that flip are reported
+	void SetRange(int first, int last, std::vector<int>& newlySeen);
+	int CountRange(int first, int last) const;
+
+	//Rows whose centers lie in [minY, maxY], false when there are none
+	bool GetRowSpan(float minY, float maxY, int& firstRow, int& lastRow) const;
+};
@@ -3,8 +3,9 @@
 
 //Includes
 #include "SteeringBehaviors.h"
+#include "Tracing.h"
 #include "IExamPlugin.h"
-#include "EliteMath\EMatrix2x3.h"
+#include "EliteMath/EMatrix2x3.h"
 
 using namespace Elite;
 
@@ -13,6 +14,8 @@ using namespace Elite;
 
 SteeringPlugin_Output_Extension Seek::CalculateSteering(float deltaT, AgentInfo& agentInfo)
 {
+	TRACE_ZONE("Seek::CalculateSteering");
+
 	SteeringPlugin_Output_Extension steering = {};
 
 	steering.LinearVelocity = m_Target.Position - agentInfo.Position;
@@ -26,6 +29,8 @@ SteeringPlugin_Output_Extension Seek::CalculateSteering(float deltaT, AgentInfo&
 //****
 SteeringPlugin_Output_Extension Flee::CalculateSteering(float deltaT, AgentInfo& agentInfo)
 {
+	TRACE_ZONE("Flee::CalculateSteering");
+
 	SteeringPlugin_Output_Extension steering = {};
 
 	steering.LinearVelocity = agentInfo.Position - m_Target.Position;
@@ -39,6 +44,8 @@ SteeringPlugin_Output_Extension Flee::CalculateSteering(float deltaT, AgentInfo&
 //****
 SteeringPlugin_Output_Extension Arrive::CalculateSteering(float deltaT, AgentInfo& agentInfo)
 {
+	TRACE_ZONE("Arrive::CalculateSteering");
+
 	const float stopDistance{ 2.f };
 	const float slowRadius{ 15.f };
 	SteeringPlugin_Output_Extension steering = {};
@@ -69,6 +76,8 @@ SteeringPlugin_Output_Extension Arrive::CalculateSteering(float deltaT, AgentInf
 //****
 SteeringPlugin_Output_Extension Face::CalculateSteering(float deltaT, AgentInfo& agentInfo)
 {
+	TRACE_ZONE("Face::CalculateSteering");
+
 	SteeringPlugin_Output_Extension steering = {};
 
 	const Vector2 desiredDirection{ m_Target.Position - agentInfo.Position };
@@ -104,6 +113,8 @@ SteeringPlugin_Output_Extension Face::CalculateSteering(float deltaT, AgentInfo&
 //****
 SteeringPlugin_Output_Extension Wander::CalculateSteering(float deltaT, AgentInfo& agentInfo)
 {
+	TRACE_ZONE("Wander::CalculateSteering");
+
 	const Elite::Vector2 moveDirection{ agentInfo.LinearVelocity.GetNormalized()};
 	const Elite::Vector2 lookDirection{ OrientationToVector(agentInfo.Orientation) };
 	
@@ -131,6 +142,8 @@ SteeringPlugin_Output_Extension Wander::CalculateSteering(float deltaT, AgentInf
 //****
 SteeringPlugin_Output_Extension Pursuit::CalculateSteering(float deltaT, AgentInfo& agentInfo)
 {
+	TRACE_ZONE("Pursuit::CalculateSteering");
+
 	SteeringPlugin_Output_Extension steering = {};
 
 	Vector2 direction{ m_Target.Position - agentInfo.Position };
@@ -155,6 +168,8 @@ SteeringPlugin_Output_Extension Pursuit::CalculateSteering(float deltaT, AgentIn
 //****
 SteeringPlugin_Output_Extension Evade::CalculateSteering(float deltaT, AgentInfo& agentInfo)
 {
+	TRACE_ZONE("Evade::CalculateSteering");
+
 	SteeringPlugin_Output_Extension steering = {};
 
 	Vector2 direction{ m_Target.Position - agentInfo.Position };
@@ -184,6 +199,8 @@ SteeringPlugin_Output_Extension Evade::CalculateSteering(float deltaT, AgentInfo
 //Rotate clock wise
 SteeringPlugin_Output_Extension RotateClockWise::CalculateSteering(float deltaT, AgentInfo& agentInfo)
 {
+	TRACE_ZONE("RotateClockWise::CalculateSteering");
+
 	SteeringPlugin_Output_Extension steering{};
 
 	steering.AutoOrient = false;
@@ -0,0 +1,176 @@
+#include "stdafx.h"
+#include "TimerWheel.h"
+
+TimerWheel::TimerWheel(float resolution)
+	: m_Resolution{ resolution > 0.f ? resolution : 1.f / 60.f }
+{
+}
+
+TimerWheel::Handle TimerWheel::Schedule(float delay, std::function<void()> callback)
+{
+	int index{};
+	if (m_FreeTimers.empty())
+	{
+		index = static_cast<int>(m_Timers.size());
+		m_Timers.push_back(Timer{});
+	}
+	else
+	{
+		index = m_FreeTimers.back();
+		m_FreeTimers.pop_back();
+	}
+
+	//Never in the tick that is being processed, so a callback cannot make the wheel fire forever
+	const int64_t expiryTick{ static_cast<int64_t>(std::ceil((m_Time + delay) / m_Resolution)) };
+
+	Timer& timer{ m_Timers[index] };
+	timer.Callback = std::move(callback);
+	timer.ExpiryTick = (std::max)(expiryTick, m_CurrentTick + 1);
+
+	Link(index);
+	++m_NrPending;
+
+	return Handle{ index, timer.Generation };
+}
+
+bool TimerWheel::Cancel(Handle& handle)
+{
+	const bool isPending{ IsPending(handle) };
+	if (isPending)
+	{
+		Unlink(handle.Index);
+		Release(handle.Index);
+	}
+
+	handle = Handle{};
+	return isPending;
+}
+
+bool TimerWheel::IsPending(const Handle& handle) const
+{
+	if (handle.Index < 0 || handle.Index >= static_cast<int>(m_Timers.size())) return false;
+
+	const Timer& timer{ m_Timers[handle.Index] };
+	return timer.Generation == handle.Generation && timer.Slot >= 0;
+}
+
+float TimerWheel::GetRemainingTime(const Handle& handle) const
+{
+	if (!IsPending(handle)) return 0.f;
+
+	return static_cast<float>((std::max)(m_Timers[handle.Index].ExpiryTick * m_Resolution - m_Time, 0.0));
+}
+
+void TimerWheel::Advance(float dt)
+{
+	m_Time += dt;
+	const int64_t targetTick{ static_cast<int64_t>(std::floor(m_Time / m_Resolution)) };
+
+	while (m_CurrentTick < targetTick)
+	{
+		//Without timers there is nothing to fire or cascade on the way
+		if (m_NrPending == 0)
+		{
+			m_CurrentTick = targetTick;
+			return;
+		}
+
+		++m_CurrentTick;
+		ProcessTick();
+	}
+}
+
+void TimerWheel::Link(int index)
+{
+	Timer& timer{ m_Timers[index] };
+
+	//The coarsest level whose slot width still fits in the remaining ticks, beyond the last level the timer waits there for another round
+	const int64_t remainingTicks{ timer.ExpiryTick - m_CurrentTick };
+	int level{};
+	while (level + 1 < NrLevels && remainingTicks >= int64_t{ 1 } << (SlotBits * (level + 1)))
+	{
+		++level;
+	}
+
+	const int64_t maxTick{ m_CurrentTick + (int64_t{ 1 } << (SlotBits * NrLevels)) - 1 };
+	const int64_t tick{ (std::min)(timer.ExpiryTick, maxTick) };
+	const int slot{ level * NrSlots + static_cast<int>((tick >> (SlotBits * level)) & (NrSlots - 1)) };
+
+	SlotList& list{ m_Slots[slot] };
+	timer.Slot = slot;
+	timer.Previous = list.Tail;
+	timer.Next = -1;
+
+	if (list.Tail >= 0) m_Timers[list.Tail].Next = index;
+	else list.Head = index;
+	list.Tail = index;
+}
+
+void TimerWheel::Unlink(int index)
+{
+	Timer& timer{ m_Timers[index] };
+	SlotList& list{ m_Slots[timer.Slot] };
+
+	if (timer.Previous >= 0) m_Timers[timer.Previous].Next = timer.Next;
+	else list.Head = timer.Next;
+
+	if (timer.Next >= 0) m_Timers[timer.Next].Previous = timer.Previous;
+	else list.Tail = timer.Previous;
+
+	timer.Slot = -1;
+	timer.Previous = -1;
+	timer.Next = -1;
+}
+
+void TimerWheel::Release(int index)
+{
+	Timer& timer{ m_Timers[index] };
+	timer.Callback = nullptr;
+	++timer.Generation;
+
+	m_FreeTimers.push_back(index);
+	--m_NrPending;
+}
+
+void TimerWheel::Cascade(int level)
+{
+	//Detached first, the last level can hand timers back to the same slot
+	SlotList& list{ m_Slots[level * NrSlots + static_cast<int>((m_CurrentTick >> (SlotBits * level)) & (NrSlots - 1))] };
+	int index{ list.Head };
+	list = SlotList{};
+
+	while (index >= 0)
+	{
+		const int next{ m_Timers[index].Next };
+		Link(index);
+		index = next;
+	}
+}
+
+void TimerWheel::ProcessTick()
+{
+	//A coarse slot is due when every finer wheel wrapped around, the coarsest one goes first
+	int nrCascadedLevels{};
+	while (nrCascadedLevels + 1 < NrLevels && (m_CurrentTick & ((int64_t{ 1 } << (SlotBits * (nrCascadedLevels + 1))) - 1)) == 0)
+	{
+		++nrCascadedLevels;
+	}
+
+	for (int level{ nrCascadedLevels }; level > 0; --level)
+	{
+		Cascade(level);
+	}
+
+	SlotList& list{ m_Slots[static_cast<int>(m_CurrentTick & (NrSlots - 1))] };
+	while (list.Head >= 0)
+	{
+		const int index{ list.Head };
+		Unlink(index);
+
+		//The timer is free before its callback runs, which may reuse it
+		std::function<void()> callback{ std::move(m_Timers[index].Callback) };
+		Release(index);
+
+		if (callback) callback();
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+//Hierarchical timer wheel: NrLevels wheels of NrSlots slots, every level NrSlots times coarser than the one below
+//Scheduling and cancelling are O(1), advancing only visits the ticks that pass and moves the timers of a coarse slot
+//down once per revolution of the finer wheel, so timers that do not expire are never looked at
+//A timer fires on the first Advance that reaches the tick its expiry time was rounded up to
+class TimerWheel final
+{
+public:
+	//Refers to nothing anymore once the timer fired or was cancelled, a default one never refers to a timer
+	struct Handle
+	{
+		int Index{ -1 };
+		uint32_t Generation{};
+	};
+
+	//Length of a tick in seconds
+	explicit TimerWheel(float resolution = 1.f / 60.f);
+	~TimerWheel() = default;
+
+	TimerWheel(const TimerWheel& other) = delete;
+	TimerWheel& operator=(const TimerWheel& other) = delete;
+	TimerWheel(TimerWheel&& other) = delete;
+	TimerWheel& operator=(TimerWheel&& other) = delete;
+
+	//The callback can be empty for timers that are only checked with IsPending
+	//Callbacks can schedule and cancel timers themselves
+	Handle Schedule(float delay, std::function<void()> callback);
+	//Returns false when the timer already fired or was cancelled, the handle is reset either way
+	bool Cancel(Handle& handle);
+
+	bool IsPending(const Handle& handle) const;
+	//Seconds until the timer fires, 0 when it is not pending
+	float GetRemainingTime(const Handle& handle) const;
+
+	//Moves the clock forward and fires every timer that expires on the way, earliest tick first
+	void Advance(float dt);
+
+	double GetTime() const { return m_Time; }
+	int GetNrPending() const { return m_NrPending; }
+
+private:
+	static constexpr int SlotBits{ 6 };
+	static constexpr int NrSlots{ 1 << SlotBits };
+	static constexpr int NrLevels{ 4 };
+
+	struct Timer
+	{
+		std::function<void()> Callback{};
+		int64_t ExpiryTick{};
+		int Slot{ -1 }; //-1 when the timer is not pending
+		int Previous{ -1 };
+		int Next{ -1 };
+		uint32_t Generation{};
+	};
+
+	//Doubly linked list of the timers in a slot, linked through the indices of the timers
+	struct SlotList
+	{
+		int Head{ -1 };
+		int Tail{ -1 };
+	};
+
+	double m_Resolution{};
+	double m_Time{};
+	int64_t m_CurrentTick{};
+	int m_NrPending{};
+
+	std::vector<Timer> m_Timers{};
+	std::vector<int> m_FreeTimers{};
+	SlotList m_Slots[NrLevels * NrSlots]{};
+
+	//Puts the timer in the slot of its expiry tick, as seen from the current tick
+	void Link(int index);
+	void Unlink(int index);
+	void Release(int index);
+
+	//Moves every timer in the current slot of the level to the finer levels
+	void Cascade(int level);
+	void ProcessTick();
+};
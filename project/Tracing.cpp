@@ -0,0 +1,273 @@
+#include "stdafx.h"
+#include "Tracing.h"
+#include "PluginConfig.h"
+
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace Tracing
+{
+	std::atomic<bool> g_IsEnabled{ false };
+}
+
+namespace
+{
+	struct ZoneRecord
+	{
+		const char* pName;
+		uint64_t Start;
+		uint64_t End;
+	};
+
+	//Single producer ring, only the owning thread writes, the oldest zones are overwritten when full
+	class ThreadBuffer final
+	{
+	public:
+		//Capacity has to be a power of two
+		ThreadBuffer(uint32_t threadId, uint32_t capacity) : m_ThreadId{ threadId }, m_Records(capacity) {}
+
+		void Push(const ZoneRecord& record)
+		{
+			const uint64_t writeIndex{ m_WriteIndex.load(std::memory_order_relaxed) };
+			m_Records[writeIndex & (m_Records.size() - 1)] = record;
+			m_WriteIndex.store(writeIndex + 1, std::memory_order_release);
+		}
+
+		template<typename Function>
+		void ForEach(Function function) const
+		{
+			const uint64_t writeIndex{ m_WriteIndex.load(std::memory_order_acquire) };
+
+			for (uint64_t index{ GetNrDropped(writeIndex) }; index < writeIndex; ++index)
+			{
+				function(m_Records[index & (m_Records.size() - 1)]);
+			}
+		}
+
+		//Only while the owning thread records no zones
+		void Reset(uint32_t capacity)
+		{
+			m_Records.assign(capacity, ZoneRecord{});
+			m_WriteIndex.store(0, std::memory_order_release);
+		}
+
+		uint64_t GetNrDropped() const { return GetNrDropped(m_WriteIndex.load(std::memory_order_acquire)); }
+		uint32_t GetThreadId() const { return m_ThreadId; }
+
+	private:
+		const uint32_t m_ThreadId;
+		std::vector<ZoneRecord> m_Records;
+		std::atomic<uint64_t> m_WriteIndex{};
+
+		uint64_t GetNrDropped(uint64_t writeIndex) const { return writeIndex > m_Records.size() ? writeIndex - m_Records.size() : 0; }
+	};
+
+	//Buffers outlive their threads so they can still be flushed at shutdown
+	std::mutex g_BuffersMutex{};
+	std::vector<std::unique_ptr<ThreadBuffer>> g_pBuffers{};
+	std::string g_OutputFile{};
+	uint32_t g_Capacity{ Tracing::default_capacity };
+
+	thread_local ThreadBuffer* t_pBuffer{};
+
+	ThreadBuffer* RegisterThread()
+	{
+		std::lock_guard<std::mutex> lock{ g_BuffersMutex };
+
+		g_pBuffers.emplace_back(new ThreadBuffer{ static_cast<uint32_t>(g_pBuffers.size()), g_Capacity });
+		return g_pBuffers.back().get();
+	}
+
+	void ResetBuffersLocked()
+	{
+		for (const std::unique_ptr<ThreadBuffer>& pBuffer : g_pBuffers)
+		{
+			pBuffer->Reset(g_Capacity);
+		}
+	}
+
+	uint64_t GetNrDroppedLocked()
+	{
+		uint64_t nrDropped{};
+		for (const std::unique_ptr<ThreadBuffer>& pBuffer : g_pBuffers)
+		{
+			nrDropped += pBuffer->GetNrDropped();
+		}
+		return nrDropped;
+	}
+
+	bool HasExtension(const std::string& path, const std::string& extension)
+	{
+		return path.size() >= extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+	}
+}
+
+void Tracing::Initialize()
+{
+	const std::string outputFile{ PluginConfig::ReadString("PLUGIN_TRACE_FILE") };
+	if (!outputFile.empty())
+	{
+		const int capacity{ PluginConfig::ReadInt("PLUGIN_TRACE_CAPACITY", 0) };
+		Enable(outputFile, capacity > 0 ? static_cast<uint32_t>(capacity) : default_capacity);
+	}
+}
+
+void Tracing::Enable(const std::string& outputFile, uint32_t capacity)
+{
+	uint32_t powerOfTwo{ 1 };
+	while (powerOfTwo < capacity && powerOfTwo < (1u << 31))
+	{
+		powerOfTwo <<= 1;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{ g_BuffersMutex };
+		g_OutputFile = outputFile;
+		g_Capacity = powerOfTwo;
+
+		//Threads that recorded before keep their buffer, it gets the new capacity too
+		ResetBuffersLocked();
+	}
+
+	g_IsEnabled.store(true, std::memory_order_release);
+}
+
+void Tracing::Shutdown()
+{
+	if (!g_IsEnabled.exchange(false)) return;
+
+	const uint64_t nrDropped{ GetNrDroppedZones() };
+	if (nrDropped > 0)
+	{
+		std::cout << "Trace dropped the " << nrDropped << " oldest zones, raise PLUGIN_TRACE_CAPACITY (" << g_Capacity << " per thread) to keep them\n";
+	}
+
+	if (HasExtension(g_OutputFile, ".json"))
+	{
+		WriteChromeTrace(g_OutputFile);
+	}
+	else
+	{
+		WriteBinaryTrace(g_OutputFile);
+	}
+
+	//The next Initialize starts from empty buffers instead of exporting these zones again
+	std::lock_guard<std::mutex> lock{ g_BuffersMutex };
+	ResetBuffersLocked();
+}
+
+uint64_t Tracing::GetTimestamp()
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Tracing::RecordZone(const char* pName, uint64_t start, uint64_t end)
+{
+	if (!t_pBuffer)
+	{
+		t_pBuffer = RegisterThread();
+	}
+
+	t_pBuffer->Push(ZoneRecord{ pName, start, end });
+}
+
+uint64_t Tracing::GetNrDroppedZones()
+{
+	std::lock_guard<std::mutex> lock{ g_BuffersMutex };
+	return GetNrDroppedLocked();
+}
+
+//Complete ('X') events, timestamps in microseconds, the capacity and dropped zones are in otherData
+bool Tracing::WriteChromeTrace(const std::string& path)
+{
+	std::ofstream file{ path };
+	if (!file)
+	{
+		std::cout << "Trace '" << path << "' could not be written\n";
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock{ g_BuffersMutex };
+
+	file << "{\"traceEvents\":[\n";
+	file.precision(3);
+	file << std::fixed;
+
+	bool isFirst{ true };
+	for (const std::unique_ptr<ThreadBuffer>& pBuffer : g_pBuffers)
+	{
+		pBuffer->ForEach([&](const ZoneRecord& record)
+		{
+			file << (isFirst ? "" : ",\n")
+				<< "{\"name\":\"" << record.pName << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << pBuffer->GetThreadId()
+				<< ",\"ts\":" << record.Start / 1000.0 << ",\"dur\":" << (record.End - record.Start) / 1000.0 << '}';
+
+			isFirst = false;
+		});
+	}
+
+	file << "\n],\"otherData\":{\"capacity\":" << g_Capacity << ",\"dropped_zones\":" << GetNrDroppedLocked() << "}}\n";
+	return true;
+}
+
+//Layout: "GPZT", version, capacity per thread, nrDropped (64 bit), nrNames, names (length + characters), nrRecords,
+//records (thread id, name index, start ns, end ns), little endian
+bool Tracing::WriteBinaryTrace(const std::string& path)
+{
+	std::ofstream file{ path, std::ios::binary };
+	if (!file)
+	{
+		std::cout << "Trace '" << path << "' could not be written\n";
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock{ g_BuffersMutex };
+
+	std::unordered_map<const char*, uint32_t> nameIndices{};
+	std::vector<const char*> names{};
+	uint32_t nrRecords{};
+
+	for (const std::unique_ptr<ThreadBuffer>& pBuffer : g_pBuffers)
+	{
+		pBuffer->ForEach([&](const ZoneRecord& record)
+		{
+			if (nameIndices.emplace(record.pName, static_cast<uint32_t>(names.size())).second)
+			{
+				names.push_back(record.pName);
+			}
+
+			++nrRecords;
+		});
+	}
+
+	auto writeValue = [&](auto value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+
+	file.write("GPZT", 4);
+	writeValue(uint32_t{ 2 });
+	writeValue(g_Capacity);
+	writeValue(GetNrDroppedLocked());
+
+	writeValue(static_cast<uint32_t>(names.size()));
+	for (const char* pName : names)
+	{
+		const uint32_t length{ static_cast<uint32_t>(strlen(pName)) };
+		writeValue(length);
+		file.write(pName, length);
+	}
+
+	writeValue(nrRecords);
+	for (const std::unique_ptr<ThreadBuffer>& pBuffer : g_pBuffers)
+	{
+		pBuffer->ForEach([&](const ZoneRecord& record)
+		{
+			writeValue(pBuffer->GetThreadId());
+			writeValue(nameIndices[record.pName]);
+			writeValue(record.Start);
+			writeValue(record.End);
+		});
+	}
+
+	return true;
+}
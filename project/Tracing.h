@@ -0,0 +1,63 @@
+#pragma once
+#include <atomic>
+#include <string>
+#include <cstdint>
+
+//Scoped timing zones for the plugin hot paths
+//Define PLUGIN_TRACING to compile the zones in, without it every TRACE_ macro expands to nothing
+//When compiled in, recording only starts after Tracing::Initialize found PLUGIN_TRACE_FILE in the environment
+//(.json gives a Chrome trace-event file for chrome://tracing or Perfetto, anything else the binary format)
+//Every thread keeps its last PLUGIN_TRACE_CAPACITY zones (default 65536), older ones are dropped and counted in the trace
+namespace Tracing
+{
+	constexpr uint32_t default_capacity{ 1 << 16 };
+
+	void Initialize();
+	//Capacity is the number of zones kept per thread, rounded up to a power of two, buffers that already exist are emptied and resized
+	void Enable(const std::string& outputFile, uint32_t capacity = default_capacity);
+	//Writes the recorded zones to the output file, stops recording and empties the buffers for the next Initialize
+	void Shutdown();
+
+	bool WriteChromeTrace(const std::string& path);
+	bool WriteBinaryTrace(const std::string& path);
+
+	uint64_t GetTimestamp();
+	void RecordZone(const char* pName, uint64_t start, uint64_t end);
+	//Zones that were overwritten before they could be written out, over all threads
+	uint64_t GetNrDroppedZones();
+
+	extern std::atomic<bool> g_IsEnabled;
+
+	class ScopedZone final
+	{
+	public:
+		explicit ScopedZone(const char* pName)
+			: m_pName{ g_IsEnabled.load(std::memory_order_relaxed) ? pName : nullptr }
+			, m_Start{ m_pName ? GetTimestamp() : 0 }
+		{
+		}
+
+		~ScopedZone()
+		{
+			if (m_pName) RecordZone(m_pName, m_Start, GetTimestamp());
+		}
+
+		ScopedZone(const ScopedZone& other) = delete;
+		ScopedZone& operator=(const ScopedZone& other) = delete;
+		ScopedZone(ScopedZone&& other) = delete;
+		ScopedZone& operator=(ScopedZone&& other) = delete;
+
+	private:
+		const char* m_pName;
+		uint64_t m_Start;
+	};
+}
+
+#ifdef PLUGIN_TRACING
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+//Name has to be a string literal, only the pointer is stored
+#define TRACE_ZONE(name) Tracing::ScopedZone TRACE_CONCAT(traceZone, __LINE__){ name }
+#else
+#define TRACE_ZONE(name)
+#endif
@@ -28,10 +28,15 @@
 #pragma endregion
 
 #pragma region //Third-Pary Includes
+//The headless host has no window, renderer or ImGui (SDL_syswm.h needs windows.h)
+#ifndef GPP_HEADLESS
 #include <GL/gl3w.h>
 #include <ImGui/imgui.h>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_syswm.h>
+#else
+#include "Headless/HeadlessPlatform.h"
+#endif
 
 #include "EliteMath/EMath.h"
 #include "EliteInput/EInputCodes.h"